@@ -0,0 +1,427 @@
+/*
+ * AutoBaud.cpp
+ *
+ *  Baud rate negotiation over a FrameLink.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "uart.h"
+#include "BaudRate.h"
+#include "Crc.h"
+#include "CycleCount.h"
+#include "SysClock.h"
+#include "AutoBaud.h"
+
+#define AUTOBAUD_TAG        0xAB        // first byte of every control frame
+
+// Control frame ops: tag, op, argument, CRC-16
+enum {
+  OP_PROPOSE = 'P',                     // master: ladder index to try
+  OP_ACCEPT = 'A',                      // slave: switching to it
+  OP_TEST = 'T',                        // master: sequence, pattern
+  OP_ECHO = 'E',                        // slave: the test frame's body
+  OP_COMMIT = 'C',                      // master: keep the index
+  OP_COMMITTED = 'K',
+  OP_PING = 'I',
+  OP_PONG = 'O',                        // slave: errors since the last one
+  OP_ECHO_BAD = 'X'                     // never sent; a mismatched echo
+};
+
+const uint32_t AutoBaud_Ladder[AUTOBAUD_RATES] = {
+  AUTOBAUD_SAFE_BAUD, 230400, 460800, 921600, 1843200, 3000000, 5000000
+};
+
+AutoBaud::AutoBaud(FrameLink &link, BufferedUART &uart, AutoBaudRole role)
+  : m_link(link), m_uart(uart), m_role(role), m_state(AB_RUN), m_rate(0),
+    m_target(0), m_ceiling(AUTOBAUD_RATES), m_since(0), m_holdMs(0),
+    m_tries(0), m_seq(0), m_errorBase(0), m_peerErrors(0), m_reply(0),
+    m_drainRate(0), m_resume(AB_RUN) {
+  m_stats.upshifts = 0;
+  m_stats.downshifts = 0;
+  m_stats.failedProbes = 0;
+  m_stats.linkLost = 0;
+  m_stats.badFrames = 0;
+}
+
+void AutoBaud::setCeiling(uint32_t baud){
+  while((m_ceiling > 1) && (AutoBaud_Ladder[m_ceiling - 1] > baud)){
+    m_ceiling--;
+  }
+}
+
+void AutoBaud::start(void){
+  uint32_t clock = baudClock();
+  uint32_t top = 1;
+  // the ladder climbs, so the first rate out of reach ends it
+  while((top < AUTOBAUD_RATES) &&
+        (AutoBaud_Ladder[top] <= BaudCalc::maxBaud(clock)) &&
+        (BaudCalc::errorPpm(clock, AutoBaud_Ladder[top]) <=
+         BAUD_MAX_ERROR_PPM)){
+    top++;
+  }
+  if(top < m_ceiling){
+    m_ceiling = top;
+  }
+  m_rate = 0;
+  if(m_role == AUTOBAUD_MASTER){
+    next();
+  }else{
+    m_state = AB_RUN;
+  }
+  drainTo(0);
+}
+
+// The port's own baud clock rather than UART_CLOCK_HZ: the port may have
+// been set up by code built either way
+uint32_t AutoBaud::baudClock(void) const {
+  if(UARTClockSourceGet(m_uart.base()) == UART_CLOCK_PIOSC){
+    return SYSCLOCK_PIOSC_HZ;
+  }
+  return SysClock_Get();
+}
+
+void AutoBaud::setRate(uint32_t rate){
+  UARTConfigSetExpClk(m_uart.base(), baudClock(), AutoBaud_Ladder[rate],
+                      UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                      UART_CONFIG_PAR_NONE);
+}
+
+// Set a ladder rate once the line is idle, from poll(), then carry on in
+// the state the caller left; the timer and the error window restart
+// then. A line held off by the peer (CTS, XOFF) is given
+// AUTOBAUD_DEAD_MS; after that the rate changes anyway and whatever is
+// still queued goes out at the new rate.
+void AutoBaud::drainTo(uint32_t rate){
+  m_drainRate = rate;
+  m_resume = m_state;
+  m_state = AB_DRAIN;
+  mark();
+}
+
+// UARTConfigSetExpClk() flushes the FIFOs, so the last frame has to be
+// completely out first. BUSY is read every time; it is what a spin on
+// this waits for.
+bool AutoBaud::lineIdle(void) const {
+  return !UARTBusy(m_uart.base()) && m_uart.txIdle();
+}
+
+uint32_t AutoBaud::lineErrors(void) const {
+  const UARTStats &uart = m_uart.stats();
+  const FrameStats &link = m_link.stats();
+  return uart.rxOverrun + uart.rxFraming + uart.rxParity + uart.rxBreak +
+         link.corrupt + link.oversize + m_stats.badFrames;
+}
+
+void AutoBaud::mark(void){
+  m_since = CycleCounterGet();
+}
+
+bool AutoBaud::expired(uint32_t ms) const {
+  return (CycleCounterGet() - m_since) >= ms * 1000 * SysClock_CyclesPerUs();
+}
+
+void AutoBaud::send(uint8_t op, const uint8_t *arg, uint32_t len){
+  uint8_t frame[AUTOBAUD_TEST_BYTES + 5];
+  frame[0] = AUTOBAUD_TAG;
+  frame[1] = op;
+  memcpy(&frame[2], arg, len);
+  uint16_t crc = Crc16(frame, len + 2);
+  frame[len + 2] = (uint8_t)(crc >> 8);
+  frame[len + 3] = (uint8_t)crc;
+  m_link.write(frame, len + 4);         // a frame that does not fit times out
+}
+
+// Test frame body after the sequence byte, different for every rate and
+// frame, with every byte value likely to show up
+void AutoBaud::testPattern(uint8_t *data) const {
+  uint32_t x = 0x9E3779B9u ^ (m_target << 8) ^ m_seq;
+  for(uint32_t i = 0; i < AUTOBAUD_TEST_BYTES; i++){
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    data[i] = (uint8_t)x;
+  }
+}
+
+bool AutoBaud::handle(const uint8_t *frame, uint32_t len){
+  if((len < 4) || (frame[0] != AUTOBAUD_TAG)){
+    return false;
+  }
+  if(Crc16(frame, len - 2) != (uint16_t)((frame[len - 2] << 8) |
+                                         frame[len - 1])){
+    m_stats.badFrames++;
+    return true;
+  }
+  uint8_t op = frame[1];
+  const uint8_t *arg = &frame[2];
+  uint32_t n = len - 4;
+
+  if(m_role == AUTOBAUD_MASTER){
+    if(op == OP_ECHO){
+      uint8_t expect[AUTOBAUD_TEST_BYTES + 1];
+      expect[0] = (uint8_t)m_seq;
+      testPattern(&expect[1]);
+      m_reply = ((n == sizeof(expect)) && (memcmp(arg, expect, n) == 0))
+                ? OP_ECHO : OP_ECHO_BAD;
+    }else if((op == OP_PONG) && (n == 4)){
+      m_peerErrors = ((uint32_t)arg[0] << 24) | ((uint32_t)arg[1] << 16) |
+                     ((uint32_t)arg[2] << 8) | arg[3];
+      m_reply = op;
+    }else if(((op == OP_ACCEPT) || (op == OP_COMMITTED)) && (n == 1) &&
+             (arg[0] == m_target)){
+      m_reply = op;
+    }
+    return true;
+  }
+
+  switch(op){
+    case OP_PROPOSE:
+      if((n == 1) && (arg[0] < m_ceiling) && (m_state == AB_RUN)){
+        m_target = arg[0];
+        send(OP_ACCEPT, arg, 1);
+        m_state = AB_SWITCH;            // after the ACCEPT is out
+      }
+      break;
+    case OP_TEST:
+      send(OP_ECHO, arg, n);
+      break;
+    case OP_COMMIT:
+      if((n == 1) && (m_state == AB_TRIAL) && (arg[0] == m_target)){
+        if(m_target > m_rate){
+          m_stats.upshifts++;
+        }else{
+          m_stats.downshifts++;
+        }
+        m_rate = m_target;
+        m_errorBase = lineErrors();     // the trial's errors do not count
+        m_state = AB_RUN;
+      }
+      if((n == 1) && (arg[0] == m_rate) && (m_state == AB_RUN)){
+        send(OP_COMMITTED, arg, 1);     // again, if the first was lost
+      }
+      break;
+    case OP_PING: {
+      uint32_t errors = lineErrors() - m_errorBase;
+      uint8_t report[4] = {(uint8_t)(errors >> 24), (uint8_t)(errors >> 16),
+                           (uint8_t)(errors >> 8), (uint8_t)errors};
+      m_errorBase += errors;
+      send(OP_PONG, report, sizeof(report));
+      break;
+    }
+  }
+  if(m_state == AB_RUN){
+    mark();                             // restart the dead link timer
+  }
+  return true;
+}
+
+// Climb to the next rate below the ceiling, or settle
+void AutoBaud::next(void){
+  m_tries = 0;
+  if(m_rate + 1 < m_ceiling){
+    m_target = m_rate + 1;
+    m_state = AB_PROPOSE;
+  }else{
+    m_errorBase = lineErrors();
+    mark();
+    m_state = AB_RUN;
+  }
+}
+
+// The trial rate did not work: back to the last good one and wait for
+// the slave's trial to run out
+void AutoBaud::probeFailed(void){
+  if(m_target < m_rate){
+    linkLost(m_rate);                   // cannot even shift down
+    return;
+  }
+  m_stats.failedProbes++;
+  m_ceiling = m_target;
+  m_holdMs = AUTOBAUD_TRIAL_MS;
+  m_state = AB_HOLDOFF;
+  drainTo(m_rate);
+}
+
+// No answers at all: both ends fall back to the safe rate, the slave
+// after AUTOBAUD_DEAD_MS of silence. bad is a rate not to try again.
+void AutoBaud::linkLost(uint32_t bad){
+  m_stats.linkLost++;
+  if((bad != 0) && (bad < m_ceiling)){
+    m_ceiling = bad;
+  }
+  m_rate = 0;
+  m_holdMs = AUTOBAUD_DEAD_MS + AUTOBAUD_KEEPALIVE_MS;
+  m_state = AB_HOLDOFF;
+  drainTo(0);
+}
+
+void AutoBaud::poll(void){
+  if(m_state == AB_DRAIN){
+    if(lineIdle() || expired(AUTOBAUD_DEAD_MS)){
+      setRate(m_drainRate);
+      m_errorBase = lineErrors();
+      mark();
+      m_state = m_resume;
+    }
+    return;
+  }
+  if(m_role == AUTOBAUD_MASTER){
+    pollMaster();
+  }else{
+    pollSlave();
+  }
+}
+
+void AutoBaud::pollMaster(void){
+  uint8_t arg = (uint8_t)m_target;
+
+  switch(m_state){
+    case AB_PROPOSE:
+      m_reply = 0;
+      send(OP_PROPOSE, &arg, 1);
+      m_tries++;
+      mark();
+      m_state = AB_ACCEPT;
+      break;
+    case AB_ACCEPT:
+      if(m_reply == OP_ACCEPT){
+        m_state = AB_SWITCH;
+      }else if(expired(AUTOBAUD_REPLY_MS)){
+        if(m_tries < AUTOBAUD_RETRIES){
+          m_state = AB_PROPOSE;
+        }else{
+          probeFailed();
+        }
+      }
+      break;
+    case AB_SWITCH:
+      if(lineIdle()){
+        setRate(m_target);
+        mark();
+        m_state = AB_SETTLE;            // let the slave switch too
+      }
+      break;
+    case AB_SETTLE:
+      if(expired(AUTOBAUD_SETTLE_MS)){
+        m_seq = 0;
+        m_errorBase = lineErrors();
+        m_state = AB_TEST;
+      }
+      break;
+    case AB_TEST: {
+      uint8_t test[AUTOBAUD_TEST_BYTES + 1];
+      test[0] = (uint8_t)m_seq;
+      testPattern(&test[1]);
+      m_reply = 0;
+      send(OP_TEST, test, sizeof(test));
+      mark();
+      m_state = AB_ECHO;
+      break;
+    }
+    case AB_ECHO:
+      if(m_reply == OP_ECHO){
+        if(++m_seq < AUTOBAUD_TEST_FRAMES){
+          m_state = AB_TEST;
+        }else if(lineErrors() == m_errorBase){
+          m_tries = 0;
+          m_state = AB_COMMIT;
+        }else{
+          probeFailed();
+        }
+      }else if((m_reply == OP_ECHO_BAD) || expired(AUTOBAUD_REPLY_MS)){
+        probeFailed();
+      }
+      break;
+    case AB_COMMIT:
+      m_reply = 0;
+      send(OP_COMMIT, &arg, 1);
+      m_tries++;
+      mark();
+      m_state = AB_COMMITTED;
+      break;
+    case AB_COMMITTED:
+      if(m_reply == OP_COMMITTED){
+        if(m_target > m_rate){
+          m_stats.upshifts++;
+        }else{
+          m_stats.downshifts++;
+        }
+        m_rate = m_target;
+        next();
+      }else if(expired(AUTOBAUD_REPLY_MS)){
+        if(m_tries < AUTOBAUD_RETRIES){
+          m_state = AB_COMMIT;
+        }else{
+          linkLost((m_target > m_rate) ? m_target : m_rate);
+        }
+      }
+      break;
+    case AB_RUN:
+      if(expired(AUTOBAUD_KEEPALIVE_MS)){
+        m_reply = 0;
+        send(OP_PING, 0, 0);
+        m_tries = 1;
+        mark();
+        m_state = AB_PING;
+      }
+      break;
+    case AB_PING:
+      if(m_reply == OP_PONG){
+        uint32_t errors = lineErrors() - m_errorBase + m_peerErrors;
+        m_errorBase = lineErrors();
+        if((errors > AUTOBAUD_ERROR_LIMIT) && (m_rate > 0)){
+          m_ceiling = m_rate;           // not this rate again
+          m_target = m_rate - 1;
+          m_tries = 0;
+          m_state = AB_PROPOSE;
+        }else{
+          m_state = AB_RUN;             // next ping a keepalive after this one
+        }
+      }else if(expired(AUTOBAUD_REPLY_MS)){
+        if(m_tries < AUTOBAUD_RETRIES){
+          send(OP_PING, 0, 0);
+          m_tries++;
+          mark();
+        }else{
+          linkLost(m_rate);
+        }
+      }
+      break;
+    case AB_HOLDOFF:
+      if(expired(m_holdMs)){
+        next();
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void AutoBaud::pollSlave(void){
+  switch(m_state){
+    case AB_SWITCH:
+      if(lineIdle()){
+        setRate(m_target);
+        mark();
+        m_state = AB_TRIAL;
+      }
+      break;
+    case AB_TRIAL:
+      if(expired(AUTOBAUD_TRIAL_MS)){
+        m_stats.failedProbes++;         // no COMMIT: back to the old rate
+        m_state = AB_RUN;
+        drainTo(m_rate);
+      }
+      break;
+    case AB_RUN:
+      if((m_rate != 0) && expired(AUTOBAUD_DEAD_MS)){
+        m_stats.linkLost++;
+        m_rate = 0;
+        drainTo(0);
+      }
+      break;
+    default:
+      break;
+  }
+}
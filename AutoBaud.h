@@ -0,0 +1,140 @@
+/*
+ * AutoBaud.h
+ *
+ *  Baud rate negotiation for a framed full-duplex link. Both ends start
+ *  at AUTOBAUD_SAFE_BAUD; the master then walks up AutoBaud_Ladder one
+ *  rate at a time:
+ *    PROPOSE n   at the current rate; the slave ACCEPTs and both switch
+ *                once their last stop bit is out (UARTConfigSetExpClk)
+ *    TEST        AUTOBAUD_TEST_FRAMES pseudo random frames at the new
+ *                rate, each echoed back by the slave and compared
+ *    COMMIT n    sent if every echo matched and neither end's line error
+ *                counters moved; the slave answers COMMITTED
+ *  A bad or missing echo makes the master go back to the last good rate
+ *  and stop climbing; the slave goes back by itself when no COMMIT
+ *  arrives within AUTOBAUD_TRIAL_MS. Once settled the master pings every
+ *  AUTOBAUD_KEEPALIVE_MS. The slave reports its line errors in each
+ *  reply, and more than AUTOBAUD_ERROR_LIMIT errors in a window from both
+ *  ends together shift the link down one rate, which then becomes the
+ *  ceiling. A link that stops answering drops both ends back to the safe
+ *  rate, from where the master climbs again.
+ *
+ *  Control frames are tagged and carry a CRC-16, so they share the
+ *  FrameLink with application frames: pass every received frame to
+ *  handle() first and keep application traffic for ready() times.
+ */
+
+#ifndef AUTOBAUD_H_
+#define AUTOBAUD_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "FrameLink.h"
+
+#define AUTOBAUD_SAFE_BAUD      115200
+#define AUTOBAUD_RATES          7
+#define AUTOBAUD_TEST_FRAMES    4
+#define AUTOBAUD_TEST_BYTES     32
+#define AUTOBAUD_RETRIES        3
+#define AUTOBAUD_REPLY_MS       20      // a control frame's answer
+#define AUTOBAUD_SETTLE_MS      1       // master, after switching rate
+#define AUTOBAUD_TRIAL_MS       200     // slave, from switch to COMMIT
+#define AUTOBAUD_KEEPALIVE_MS   100
+#define AUTOBAUD_DEAD_MS        500     // slave, nothing heard
+#define AUTOBAUD_ERROR_LIMIT    4       // errors per keepalive window
+
+// Candidate rates, lowest (the safe rate) first. start() stops the climb
+// below the first rate the port's baud clock cannot produce within
+// BAUD_MAX_ERROR_PPM.
+extern const uint32_t AutoBaud_Ladder[AUTOBAUD_RATES];
+
+enum AutoBaudRole {AUTOBAUD_MASTER, AUTOBAUD_SLAVE};
+
+struct AutoBaudStats {
+  uint32_t upshifts;
+  uint32_t downshifts;
+  uint32_t failedProbes;                // rates tried and given up
+  uint32_t linkLost;                    // fallbacks to the safe rate
+  uint32_t badFrames;                   // control frames failing the CRC
+};
+
+class AutoBaud {
+public:
+  AutoBaud(FrameLink &link, BufferedUART &uart, AutoBaudRole role);
+
+  //------------start------------
+  // Switch the port to the safe rate; the master starts probing upward
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------handle------------
+  // Offer a received frame to the negotiation
+  // Input: frame points to len bytes read from the FrameLink
+  // Output: true if the frame was a control frame and is consumed
+  bool handle(const uint8_t *frame, uint32_t len);
+
+  //------------poll------------
+  // Advance the negotiation; call from the main loop. Never blocks: a
+  // rate change waits in AB_DRAIN until the last stop bit is out.
+  // Input: none
+  // Output: none
+  void poll(void);
+
+  //------------setCeiling------------
+  // Never go above this rate (the master drives, so set it there); may
+  // be called before start()
+  // Input: baud rate, at least AUTOBAUD_SAFE_BAUD
+  // Output: none
+  void setCeiling(uint32_t baud);
+
+  //------------ready------------
+  // Output: true while no rate change is in progress, so application
+  //         frames will arrive at the rate they were sent at
+  bool ready(void) const { return (m_state == AB_RUN) || (m_state == AB_PING); }
+
+  uint32_t baud(void) const { return AutoBaud_Ladder[m_rate]; }
+  const AutoBaudStats &stats(void) const { return m_stats; }
+
+private:
+  enum State {
+    AB_PROPOSE, AB_ACCEPT, AB_SWITCH, AB_SETTLE, AB_TEST, AB_ECHO,
+    AB_COMMIT, AB_COMMITTED, AB_RUN, AB_PING, AB_HOLDOFF, AB_TRIAL,
+    AB_DRAIN
+  };
+
+  void pollMaster(void);
+  void pollSlave(void);
+  void send(uint8_t op, const uint8_t *arg, uint32_t len);
+  uint32_t baudClock(void) const;
+  void setRate(uint32_t rate);
+  void drainTo(uint32_t rate);
+  bool lineIdle(void) const;
+  uint32_t lineErrors(void) const;
+  bool expired(uint32_t ms) const;
+  void mark(void);
+  void next(void);
+  void probeFailed(void);
+  void linkLost(uint32_t bad);
+  void testPattern(uint8_t *data) const;
+
+  FrameLink &m_link;
+  BufferedUART &m_uart;
+  AutoBaudRole m_role;
+  AutoBaudStats m_stats;
+  State m_state;
+  uint32_t m_rate;                      // ladder index in use
+  uint32_t m_target;                    // ladder index being tried
+  uint32_t m_ceiling;                   // first index not to try
+  uint32_t m_since;                     // cycle count of the last mark()
+  uint32_t m_holdMs;
+  uint32_t m_tries;
+  uint32_t m_seq;                       // test frames echoed so far
+  uint32_t m_errorBase;                 // lineErrors() at window start
+  uint32_t m_peerErrors;                // slave's errors in its last window
+  uint8_t m_reply;                      // last control op received
+  uint32_t m_drainRate;                 // AB_DRAIN: ladder index to set
+  State m_resume;                       // AB_DRAIN: state after it
+};
+
+#endif /* AUTOBAUD_H_ */
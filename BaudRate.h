@@ -0,0 +1,88 @@
+/*
+ * BaudRate.h
+ *
+ *  Compile-time UART baud rate divisors. The IBRD/FBRD pair and the
+ *  high-speed (HSE) bit are worked out from the UART clock and the target
+ *  baud rate the same way UARTConfigSetExpClk() does at run time, and a
+ *  combination whose actual rate is too far off fails to compile.
+ *
+ *  Usage:
+ *    typedef BaudDivisor<16000000, 115200> Baud;
+ *    UART0_IBRD_R = Baud::IBRD;  UART0_FBRD_R = Baud::FBRD;
+ */
+
+#ifndef BAUDRATE_H_
+#define BAUDRATE_H_
+
+#include <stdint.h>
+
+#define BAUD_MAX_ERROR_PPM 10000        // default limit, 1.0%
+
+// The functions are also usable at run time for rates picked on the fly
+namespace BaudCalc {
+
+// High-speed mode divides the UART clock by 8 instead of 16
+constexpr bool hse(uint32_t clock, uint32_t baud){
+  return ((uint64_t)baud * 16) > clock;
+}
+
+// Divisor in 1/64ths, rounded to nearest
+constexpr uint32_t divisor(uint32_t clock, uint32_t baud){
+  return (uint32_t)(((((uint64_t)clock * 8) /
+                      (hse(clock, baud) ? baud / 2 : baud)) + 1) / 2);
+}
+
+constexpr uint32_t ibrd(uint32_t clock, uint32_t baud){
+  return divisor(clock, baud) / 64;
+}
+
+constexpr uint32_t fbrd(uint32_t clock, uint32_t baud){
+  return divisor(clock, baud) % 64;
+}
+
+// Baud rate the hardware really produces with the rounded divisor
+constexpr uint32_t actual(uint32_t clock, uint32_t baud){
+  return (uint32_t)(((uint64_t)clock * (hse(clock, baud) ? 8 : 4)) /
+                    divisor(clock, baud));
+}
+
+// |actual - target| in parts per million of the target
+constexpr uint32_t errorPpm(uint32_t clock, uint32_t baud){
+  return (uint32_t)((((actual(clock, baud) > baud)
+                        ? (uint64_t)(actual(clock, baud) - baud)
+                        : (uint64_t)(baud - actual(clock, baud))) * 1000000) /
+                    baud);
+}
+
+// Highest rate the UART can generate at all (HSE, divisor of 1)
+constexpr uint32_t maxBaud(uint32_t clock){
+  return clock / 8;
+}
+
+} // namespace BaudCalc
+
+template <uint32_t CLOCK, uint32_t BAUD,
+          uint32_t MAX_ERROR_PPM = BAUD_MAX_ERROR_PPM>
+struct BaudDivisor {
+  static_assert(BAUD != 0, "baud rate must be non-zero");
+  static_assert(BAUD <= BaudCalc::maxBaud(CLOCK),
+                "baud rate above UART clock / 8");
+  static_assert(BaudCalc::ibrd(CLOCK, BAUD) >= 1 &&
+                BaudCalc::ibrd(CLOCK, BAUD) <= 0xFFFF,
+                "integer divisor out of range");
+  static_assert(BaudCalc::errorPpm(CLOCK, BAUD) <= MAX_ERROR_PPM,
+                "baud rate error exceeds the allowed limit");
+
+  static const uint32_t IBRD = BaudCalc::ibrd(CLOCK, BAUD);
+  static const uint32_t FBRD = BaudCalc::fbrd(CLOCK, BAUD);
+  static const bool HSE = BaudCalc::hse(CLOCK, BAUD);
+  static const uint32_t ACTUAL = BaudCalc::actual(CLOCK, BAUD);
+  static const uint32_t ERROR_PPM = BaudCalc::errorPpm(CLOCK, BAUD);
+};
+
+// 16 MHz / (16 * 115,200) = 8.6806 -> IBRD 8, FBRD round(0.6806 * 64) = 44
+static_assert(BaudCalc::ibrd(16000000, 115200) == 8 &&
+              BaudCalc::fbrd(16000000, 115200) == 44,
+              "divisor calculation does not match the datasheet example");
+
+#endif /* BAUDRATE_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Bridge.cpp
+ *
+ *  Transparent UART0 (PC) <-> UART1 (device) bridge.
+ */
+
+#include <stdint.h>
+#include "CycleCount.h"
+#include "SysClock.h"
+#include "StreamPrint.h"
+#include "Bridge.h"
+
+#define BRIDGE_CHUNK    32              // bytes moved per ring-to-ring copy
+
+static void ResetDir(BridgeDirStats &dir){
+  dir.bytes = 0;
+  dir.drops = 0;
+  dir.latencyMin = 0xFFFFFFFF;
+  dir.latencyMax = 0;
+  dir.latencyLast = 0;
+}
+
+UARTBridge::UARTBridge(BufferedUART &pc, BufferedUART &device)
+  : m_pc(pc), m_device(device), m_deviceLink(0), m_pcDropBase(0),
+    m_deviceDropBase(0), m_cycles(0), m_lastCycle(0) {
+  ResetDir(m_toDevice);
+  ResetDir(m_toPC);
+}
+
+void UARTBridge::start(void){
+  ResetDir(m_toDevice);
+  ResetDir(m_toPC);
+  m_pcDropBase = m_pc.stats().rxOverflow;
+  m_deviceDropBase = m_device.stats().rxOverflow;
+  m_cycles = 0;
+  m_lastCycle = CycleCounterGet();
+}
+
+uint32_t UARTBridge::forward(BufferedUART &src, BufferedUART &dst,
+                             BridgeDirStats &dir, uint32_t dropBase,
+                             HalfDuplexLink *link){
+  uint8_t chunk[BRIDGE_CHUNK];
+  uint32_t moved = 0;
+
+  for(;;){
+    uint32_t room = dst.space();
+    if(room == 0){
+      break;                            // sink backed up; leave data queued
+    }
+    if(room > sizeof(chunk)){
+      room = sizeof(chunk);
+    }
+    uint32_t stamp = src.rxStamp();
+    uint32_t n = src.read(chunk, room);
+    if(n == 0){
+      break;
+    }
+    if(link){
+      link->write(chunk, n);
+    }else{
+      dst.write(chunk, n);
+    }
+    uint32_t latency = CycleCounterGet() - stamp;
+    if(latency < dir.latencyMin) dir.latencyMin = latency;
+    if(latency > dir.latencyMax) dir.latencyMax = latency;
+    dir.latencyLast = latency;
+    dir.bytes += n;
+    moved += n;
+  }
+  dir.drops = src.stats().rxOverflow - dropBase;
+  return moved;
+}
+
+uint32_t UARTBridge::pump(void){
+  uint32_t now = CycleCounterGet();
+  m_cycles += now - m_lastCycle;
+  m_lastCycle = now;
+  return forward(m_pc, m_device, m_toDevice, m_pcDropBase, m_deviceLink) +
+         forward(m_device, m_pc, m_toPC, m_deviceDropBase, 0);
+}
+
+uint32_t UARTBridge::bytesPerSecond(const BridgeDirStats &dir) const {
+  if(m_cycles == 0){
+    return 0;
+  }
+  return (uint32_t)(((uint64_t)dir.bytes * SysClock_Get()) / m_cycles);
+}
+
+static void ReportDir(ByteStream &out, const char *name,
+                      const BridgeDirStats &dir, uint32_t rate){
+  StreamPrint(out, "bridge dir=");
+  StreamPrint(out, name);
+  StreamPrintField(out, "bytes", dir.bytes);
+  StreamPrintField(out, "bytes_per_s", rate);
+  StreamPrintField(out, "drops", dir.drops);
+  StreamPrintField(out, "lat_min_cyc", dir.bytes ? dir.latencyMin : 0);
+  StreamPrintField(out, "lat_max_cyc", dir.latencyMax);
+  StreamPrint(out, "\r\n");
+}
+
+void UARTBridge::report(ByteStream &out) const {
+  ReportDir(out, "pc_to_dev", m_toDevice, bytesPerSecond(m_toDevice));
+  ReportDir(out, "dev_to_pc", m_toPC, bytesPerSecond(m_toPC));
+}
@@ -0,0 +1,81 @@
+/*
+ * Bridge.h
+ *
+ *  Transparent UART0 (PC) <-> UART1 (device) bridge. Each direction has
+ *  its own pair of rings (source RX, sink TX) filled and drained by the
+ *  port ISRs, so a slow or busy link only backs up its own direction.
+ *  A half-duplex device is sent to through its HalfDuplexLink, in
+ *  pass-through mode, which drives the transceiver for the bytes.
+ */
+
+#ifndef BRIDGE_H_
+#define BRIDGE_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "ByteStream.h"
+#include "HalfDuplex.h"
+
+struct BridgeDirStats {
+  uint32_t bytes;                       // bytes forwarded
+  uint32_t drops;                       // bytes lost in the source RX ring
+  uint32_t latencyMin;                  // cycles, oldest byte RX to hand-off
+  uint32_t latencyMax;
+  uint32_t latencyLast;
+};
+
+class UARTBridge {
+public:
+  UARTBridge(BufferedUART &pc, BufferedUART &device);
+
+  //------------start------------
+  // Zero the statistics and begin the throughput window
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------setDeviceLink------------
+  // Send toward the device through a half-duplex link, which must be in
+  // pass-through mode while the bridge runs; 0 for a full-duplex device
+  // Input: link on the device port, or 0
+  // Output: none
+  void setDeviceLink(HalfDuplexLink *link){ m_deviceLink = link; }
+
+  //------------pump------------
+  // Move everything that fits in both directions; call from the main
+  // loop as often as possible. Never blocks.
+  // Input: none
+  // Output: number of bytes moved, 0 if the bridge is idle
+  uint32_t pump(void);
+
+  const BridgeDirStats &toDevice(void) const { return m_toDevice; }
+  const BridgeDirStats &toPC(void) const { return m_toPC; }
+
+  //------------bytesPerSecond------------
+  // Input: stats for one direction
+  // Output: average forwarding rate since start()
+  uint32_t bytesPerSecond(const BridgeDirStats &dir) const;
+
+  //------------report------------
+  // Print one key=value line per direction
+  // Input: out is where to print
+  // Output: none
+  void report(ByteStream &out) const;
+
+private:
+  uint32_t forward(BufferedUART &src, BufferedUART &dst,
+                   BridgeDirStats &dir, uint32_t dropBase,
+                   HalfDuplexLink *link);
+
+  BufferedUART &m_pc;
+  BufferedUART &m_device;
+  HalfDuplexLink *m_deviceLink;         // 0: full-duplex device
+  BridgeDirStats m_toDevice;
+  BridgeDirStats m_toPC;
+  uint32_t m_pcDropBase;
+  uint32_t m_deviceDropBase;
+  uint64_t m_cycles;                    // throughput window length
+  uint32_t m_lastCycle;
+};
+
+#endif /* BRIDGE_H_ */
@@ -0,0 +1,451 @@
+/*
+ * BufferedUART.cpp
+ *
+ *  Interrupt driven UART driver built on the driverlib UART interrupt API.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "uart.h"
+#include "CycleCount.h"
+#include "Profile.h"
+#include "StreamPrint.h"
+#include "SysClock.h"
+#include "BufferedUART.h"
+
+BufferedUART UART0_Buffered(UART0_BASE);
+BufferedUART UART1_Buffered(UART1_BASE);
+
+BufferedUART::BufferedUART(uint32_t base)
+    : m_base(base), m_txExt(0), m_txExtLen(0), m_rxStamp(0),
+      m_txDoneCallback(0), m_txDoneContext(0), m_rxHook(0),
+      m_rxHookContext(0), m_rxWatch(0), m_rxWatchContext(0),
+      m_rxStreak(0), m_flow(UART_FLOW_NONE),
+      m_rxHighWater(UART_RX_HIGH_WATER), m_rxLowWater(UART_RX_LOW_WATER),
+      m_rxThrottleStart(0), m_txThrottleStart(0), m_txMask(UART_INT_TX),
+      m_txCtrl(0), m_rxThrottled(false), m_txThrottled(false),
+      m_txPaused(false), m_rxAdaptive(false), m_rxHigh(false),
+      m_txDoneArmed(false), m_txEot(false) {
+    m_stats.rxBytes = 0;
+    m_stats.txBytes = 0;
+    m_stats.rxOverflow = 0;
+    m_stats.txOverflow = 0;
+    m_stats.rxInterrupts = 0;
+    m_stats.rxOverrun = 0;
+    m_stats.rxFraming = 0;
+    m_stats.rxParity = 0;
+    m_stats.rxBreak = 0;
+    m_stats.rxThrottles = 0;
+    m_stats.rxThrottledUs = 0;
+    m_stats.txThrottles = 0;
+    m_stats.txThrottledUs = 0;
+}
+
+void BufferedUART::init(void (*handler)(void)){
+    UARTIntDisable(m_base, 0xFFFFFFFF);
+    UARTIntClear(m_base, 0xFFFFFFFF);
+    UARTIntRegister(m_base, handler);   // also enables the NVIC line
+    UARTIntEnable(m_base, UART_INT_RX | UART_INT_RT | UART_INT_OE |
+                          UART_INT_TX);
+}
+
+#ifdef UART_RX_ERROR_TAGS
+uint32_t BufferedUART::read(uint8_t *data, uint32_t len){
+    return readTagged(data, 0, len);
+}
+
+uint32_t BufferedUART::readTagged(uint8_t *data, uint8_t *errors,
+                                  uint32_t len){
+    // The ISR queues each tag before its byte, so there are always at
+    // least count() tags; taking them first keeps the tag ring from
+    // filling up while the bytes are copied out
+    uint32_t n = m_rx.count();
+    if(len > n){
+        len = n;
+    }
+    if(errors){
+        m_rxTags.read(errors, len);
+    }else{
+        m_rxTags.discard(len);
+    }
+    len = m_rx.read(data, len);
+    releaseThrottle();
+    return len;
+}
+#else
+uint32_t BufferedUART::read(uint8_t *data, uint32_t len){
+    len = m_rx.read(data, len);
+    releaseThrottle();
+    return len;
+}
+#endif
+
+uint32_t BufferedUART::write(const uint8_t *data, uint32_t len){
+    uint32_t n = sendBusy() ? 0 : m_tx.write(data, len);
+    m_stats.txOverflow += len - n;
+
+    // The TX interrupt only fires when the FIFO drains past its trigger
+    // level, so an idle transmitter has to be primed from here. Masking
+    // the TX source (and RX, which can queue XON/XOFF) keeps the ISR from
+    // consuming the ring at the same time.
+    UARTIntDisable(m_base, m_txMask);
+    fillTxFifo();
+    UARTIntEnable(m_base, m_txMask);
+    return n;
+}
+
+bool BufferedUART::send(const uint8_t *data, uint32_t len){
+    if(sendBusy()){
+        return false;
+    }
+    if(len == 0){
+        return true;
+    }
+    UARTIntDisable(m_base, m_txMask);
+    m_txExt = data;
+    m_txExtLen = len;
+    fillTxFifo();
+    UARTIntEnable(m_base, m_txMask);
+    return true;
+}
+
+void BufferedUART::notifyTxDone(UARTTxDoneCallback callback, void *context){
+    UARTIntDisable(m_base, m_txMask);
+    m_txDoneCallback = callback;
+    m_txDoneContext = context;
+    m_txDoneArmed = true;
+    fillTxFifo();
+    UARTIntEnable(m_base, m_txMask);
+}
+
+void BufferedUART::txCommit(uint32_t len){
+    m_tx.commit(len);
+    UARTIntDisable(m_base, m_txMask);
+    fillTxFifo();
+    UARTIntEnable(m_base, m_txMask);
+}
+
+void BufferedUART::setRxHook(UARTRxHook hook, void *context){
+    // Mask RX so the ISR never sees a hook without its context
+    UARTIntDisable(m_base, UART_INT_RX | UART_INT_RT);
+    m_rxHook = hook;
+    m_rxHookContext = context;
+    UARTIntEnable(m_base, UART_INT_RX | UART_INT_RT);
+}
+
+void BufferedUART::setRxWatch(UARTRxHook watch, void *context){
+    UARTIntDisable(m_base, UART_INT_RX | UART_INT_RT);
+    m_rxWatch = watch;
+    m_rxWatchContext = context;
+    UARTIntEnable(m_base, UART_INT_RX | UART_INT_RT);
+}
+
+void BufferedUART::setRxAdaptive(bool enable){
+    UARTIntDisable(m_base, UART_INT_RX | UART_INT_RT);
+    m_rxAdaptive = enable && (m_flow != UART_FLOW_XONXOFF);
+    if(m_rxAdaptive){
+        m_rxStreak = 0;
+        setRxLevel(false);
+    }
+    UARTIntEnable(m_base, UART_INT_RX | UART_INT_RT);
+}
+
+// Only the RX field changes; the TX level belongs to whoever set it
+void BufferedUART::setRxLevel(bool high){
+    uint32_t ifls = HWREG(m_base + UART_O_IFLS) & ~UART_IFLS_RX_M;
+    HWREG(m_base + UART_O_IFLS) = ifls | (high ? UART_IFLS_RX7_8
+                                               : UART_IFLS_RX1_8);
+    m_rxHigh = high;
+}
+
+// A receive timeout means the line has been quiet for 32 bit times, so
+// whatever burst was running is over: go back to interrupting early. A
+// run of level interrupts with no timeout between them is a stream: let
+// the FIFO fill before interrupting.
+void BufferedUART::adaptRxLevel(uint32_t status){
+    if(status & UART_INT_RT){
+        m_rxStreak = 0;
+        if(m_rxHigh){
+            setRxLevel(false);
+        }
+    }else if(!m_rxHigh && (++m_rxStreak >= UART_RX_ADAPT_STREAK)){
+        setRxLevel(true);
+    }
+}
+
+bool BufferedUART::setFlowControl(UARTFlowControl mode, uint32_t highWater,
+                                  uint32_t lowWater){
+    if(((mode == UART_FLOW_RTSCTS) && (m_base != UART1_BASE)) ||
+       (lowWater >= highWater) || (highWater > UART_RX_BUFFER_SIZE)){
+        return false;
+    }
+    UARTIntDisable(m_base, UART_INT_RX | UART_INT_RT | UART_INT_CTS |
+                           UART_INT_TX);
+    if(m_rxThrottled){
+        releaseRx();                    // in the old mode
+    }
+    holdTx(false);
+    m_txPaused = false;
+    m_txCtrl = 0;
+    m_flow = mode;
+    m_rxHighWater = highWater;
+    m_rxLowWater = lowWater;
+    m_txMask = UART_INT_TX;
+    uint32_t rxInts = UART_INT_RX | UART_INT_RT;
+    if(mode == UART_FLOW_RTSCTS){
+        UARTModemControlSet(m_base, UART_OUTPUT_RTS);   // ready to receive
+        UARTFlowControlSet(m_base, UART_FLOWCONTROL_TX);
+        ctsChanged();                   // start timing if already held
+        rxInts |= UART_INT_CTS;
+    }else if(m_base == UART1_BASE){
+        UARTFlowControlSet(m_base, UART_FLOWCONTROL_NONE);
+    }
+    if(mode == UART_FLOW_XONXOFF){
+        // An XOFF must not wait behind a 7/8 FIFO trigger, and the main
+        // loop must keep the ISR out while it feeds the TX FIFO, since
+        // the RX path can inject XOFF there
+        m_rxAdaptive = false;
+        setRxLevel(false);
+        m_txMask = UART_INT_TX | UART_INT_RX | UART_INT_RT;
+    }
+    UARTTxIntModeSet(m_base, ((mode == UART_FLOW_XONXOFF) || m_txEot) ?
+                             UART_TXINT_MODE_EOT : UART_TXINT_MODE_FIFO);
+    UARTIntEnable(m_base, rxInts | UART_INT_TX);
+    return true;
+}
+
+// Called from the ISR once the ring reaches the high watermark
+void BufferedUART::throttleRx(void){
+    m_rxThrottled = true;
+    m_rxThrottleStart = CycleCounterGet();
+    m_stats.rxThrottles++;
+    if(m_flow == UART_FLOW_RTSCTS){
+        UARTModemControlClear(m_base, UART_OUTPUT_RTS);
+    }else if(m_flow == UART_FLOW_XONXOFF){
+        m_txCtrl = UART_XOFF;
+        fillTxFifo();
+    }
+}
+
+// Called with RX and TX masked once the ring is down to the low watermark
+// After a read: let the sender go again once the ring is down to
+// lowWater. RX masked so the ISR cannot throttle again halfway through,
+// TX because XON goes out through fillTxFifo()
+void BufferedUART::releaseThrottle(void){
+    if(m_rxThrottled && (m_rx.count() <= m_rxLowWater)){
+        UARTIntDisable(m_base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+        releaseRx();
+        UARTIntEnable(m_base, UART_INT_RX | UART_INT_RT | UART_INT_TX);
+    }
+}
+
+void BufferedUART::releaseRx(void){
+    m_stats.rxThrottledUs += (CycleCounterGet() - m_rxThrottleStart) /
+                             SysClock_CyclesPerUs();
+    if(m_flow == UART_FLOW_RTSCTS){
+        UARTModemControlSet(m_base, UART_OUTPUT_RTS);
+    }else if(m_flow == UART_FLOW_XONXOFF){
+        m_txCtrl = UART_XON;
+        fillTxFifo();
+    }
+    m_rxThrottled = false;
+}
+
+// Keep time while the receiver holds our transmitter off
+void BufferedUART::holdTx(bool held){
+    if(held && !m_txThrottled){
+        m_txThrottled = true;
+        m_txThrottleStart = CycleCounterGet();
+        m_stats.txThrottles++;
+    }else if(!held && m_txThrottled){
+        m_txThrottled = false;
+        m_stats.txThrottledUs += (CycleCounterGet() - m_txThrottleStart) /
+                                 SysClock_CyclesPerUs();
+    }
+}
+
+// The hardware already holds the transmitter while CTS is deasserted
+void BufferedUART::ctsChanged(void){
+    holdTx((UARTModemStatusGet(m_base) & UART_INPUT_CTS) == 0);
+}
+
+// XOFF/XON from the receiver, in the ISR. Only data is held back: the
+// transmitter stays enabled so our own XOFF/XON can still leave, and
+// what is already in the FIFO (at most a burst) goes out.
+void BufferedUART::pauseTx(bool pause){
+    m_txPaused = pause;
+    holdTx(pause);
+    if(!pause){
+        fillTxFifo();                   // no TX interrupt is due
+    }
+}
+
+void BufferedUART::txDone(void){
+    m_txDoneArmed = false;
+    if(m_txEot){
+        if(m_flow != UART_FLOW_XONXOFF){
+            UARTTxIntModeSet(m_base, UART_TXINT_MODE_FIFO);
+        }
+        m_txEot = false;
+    }
+    m_txDoneCallback(m_txDoneContext);
+}
+
+void BufferedUART::fillTxFifo(void){
+    uint8_t data;
+    uint32_t room = 0xFFFFFFFF;         // FIFO bytes to fill, TXFF aside
+    bool more = !m_tx.empty() || (m_txExtLen != 0);
+    if((m_txCtrl != 0) && ((HWREG(m_base + UART_O_FR) & UART_FR_TXFF) == 0)){
+        // XON/XOFF go ahead of everything not yet in the FIFO
+        HWREG(m_base + UART_O_DR) = m_txCtrl;
+        m_txCtrl = 0;
+    }
+    if(m_txEot && more){
+        // New data arrived behind the final burst; go back to refilling
+        // at the FIFO trigger level (XON/XOFF always refills at EOT)
+        if(m_flow != UART_FLOW_XONXOFF){
+            UARTTxIntModeSet(m_base, UART_TXINT_MODE_FIFO);
+        }
+        m_txEot = false;
+    }
+    if(m_flow == UART_FLOW_XONXOFF){
+        // A burst at a time into an empty FIFO, none while paused
+        room = (m_txPaused ||
+                ((HWREG(m_base + UART_O_FR) & UART_FR_TXFE) == 0)) ?
+               0 : UART_XONXOFF_TX_BURST;
+    }
+    while((room-- != 0) && ((HWREG(m_base + UART_O_FR) & UART_FR_TXFF) == 0)){
+        if(m_tx.get(data)){
+            HWREG(m_base + UART_O_DR) = data;
+        }else if(m_txExtLen != 0){
+            HWREG(m_base + UART_O_DR) = *m_txExt++;
+            m_txExtLen--;
+        }else{
+            break;
+        }
+        m_stats.txBytes++;
+    }
+    if(m_txDoneArmed && m_tx.empty() && (m_txExtLen == 0)){
+        // Last burst is in the FIFO: interrupt when the line goes idle
+        if(!m_txEot){
+            UARTTxIntModeSet(m_base, UART_TXINT_MODE_EOT);
+            m_txEot = true;
+        }
+        if(!UARTBusy(m_base)){
+            txDone();                   // drained before EOT was armed
+        }
+    }
+}
+
+// Per-byte flags come with the data register read the ISR does anyway,
+// so clean bytes cost one test
+void BufferedUART::countRxErrors(uint32_t dr){
+    if(dr & UART_DR_BE){
+        m_stats.rxBreak++;              // a break also fails framing
+    }else{
+        if(dr & UART_DR_FE){
+            m_stats.rxFraming++;
+        }
+        if(dr & UART_DR_PE){
+            m_stats.rxParity++;
+        }
+    }
+}
+
+void BufferedUART::handleInterrupt(void){
+    uint32_t status = UARTIntStatus(m_base, true);
+    UARTIntClear(m_base, status);
+
+    if(status & UART_INT_OE){
+        // The byte that overran never reached the FIFO; the sticky flag
+        // in the status register has to be cleared by hand
+        m_stats.rxOverrun++;
+        UARTRxErrorClear(m_base);
+    }
+    if(status & (UART_INT_RX | UART_INT_RT)){
+        m_stats.rxInterrupts++;
+        if(m_rxAdaptive){
+            adaptRxLevel(status);
+        }
+        while((HWREG(m_base + UART_O_FR) & UART_FR_RXFE) == 0){
+            uint32_t dr = HWREG(m_base + UART_O_DR);
+            uint8_t data = (uint8_t)(dr & UART_DR_DATA_M);
+            if(dr & (UART_DR_BE | UART_DR_PE | UART_DR_FE)){
+                countRxErrors(dr);
+            }
+            if((m_flow == UART_FLOW_XONXOFF) &&
+               ((data == UART_XOFF) || (data == UART_XON))){
+                pauseTx(data == UART_XOFF);
+                continue;
+            }
+            if(m_rxWatch){
+                m_rxWatch(m_rxWatchContext, data);
+            }
+            if(m_rxHook){
+                m_stats.rxBytes++;
+                m_rxHook(m_rxHookContext, data);
+                continue;
+            }
+            if(m_rx.empty()){
+                m_rxStamp = CycleCounterGet();
+            }
+#ifdef UART_RX_ERROR_TAGS
+            if(!m_rx.full()){
+                m_rxTags.put((uint8_t)((dr >> 8) & (UART_RXERROR_BREAK |
+                             UART_RXERROR_PARITY | UART_RXERROR_FRAMING)));
+            }
+#endif
+            if(m_rx.put(data)){
+                m_stats.rxBytes++;
+            }else{
+                m_stats.rxOverflow++;
+            }
+        }
+        if((m_flow != UART_FLOW_NONE) && !m_rxThrottled && !m_rxHook &&
+           (m_rx.count() >= m_rxHighWater)){
+            throttleRx();
+        }
+    }
+    if(status & UART_INT_CTS){
+        ctsChanged();
+    }
+    if(status & UART_INT_TX){
+        fillTxFifo();
+    }
+}
+
+void UART_Report(ByteStream &out, const char *name, const UARTStats &stats){
+    StreamPrint(out, "uart port=");
+    StreamPrint(out, name);
+    StreamPrintField(out, "rx", stats.rxBytes);
+    StreamPrintField(out, "tx", stats.txBytes);
+    StreamPrintField(out, "rx_overflow", stats.rxOverflow);
+    StreamPrintField(out, "tx_overflow", stats.txOverflow);
+    StreamPrintField(out, "rx_irqs", stats.rxInterrupts);
+    StreamPrintField(out, "rx_irq_per_kb", stats.rxBytes ?
+                     (uint32_t)(((uint64_t)stats.rxInterrupts * 1024) /
+                                stats.rxBytes) : 0);
+    StreamPrintField(out, "overrun", stats.rxOverrun);
+    StreamPrintField(out, "framing", stats.rxFraming);
+    StreamPrintField(out, "parity", stats.rxParity);
+    StreamPrintField(out, "break", stats.rxBreak);
+    StreamPrintField(out, "rx_throttles", stats.rxThrottles);
+    StreamPrintField(out, "rx_throttled_us", stats.rxThrottledUs);
+    StreamPrintField(out, "tx_throttles", stats.txThrottles);
+    StreamPrintField(out, "tx_throttled_us", stats.txThrottledUs);
+    StreamPrint(out, "\r\n");
+}
+
+// One profile site per port, so the two ISRs are timed apart
+void UART0_Handler(void){
+    PROFILE_SCOPE("uart0_isr");
+    UART0_Buffered.handleInterrupt();
+}
+
+void UART1_Handler(void){
+    PROFILE_SCOPE("uart1_isr");
+    UART1_Buffered.handleInterrupt();
+}
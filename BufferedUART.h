@@ -0,0 +1,262 @@
+/*
+ * BufferedUART.h
+ *
+ *  Interrupt driven UART driver. The ISR moves bytes between the hardware
+ *  FIFOs and a pair of software ring buffers, so the main loop never spins
+ *  on the flag register and bytes are not lost while it is busy.
+ */
+
+#ifndef BUFFEREDUART_H_
+#define BUFFEREDUART_H_
+
+#include <stdint.h>
+#include "ByteStream.h"
+#include "RingBuffer.h"
+
+#define UART_RX_BUFFER_SIZE 256         // must be a power of two
+#define UART_TX_BUFFER_SIZE 256         // must be a power of two
+#define UART_RX_ADAPT_STREAK 4          // level interrupts in a row that
+                                        // count as streaming traffic
+#define UART_RX_HIGH_WATER  (UART_RX_BUFFER_SIZE * 3 / 4)   // stop the sender
+#define UART_RX_LOW_WATER   (UART_RX_BUFFER_SIZE / 4)       // let it go again
+
+// Receive flow control, see BufferedUART::setFlowControl()
+enum UARTFlowControl {
+    UART_FLOW_NONE,
+    UART_FLOW_RTSCTS,                   // UART1 only, the one port with
+                                        // modem lines (U1RTS/U1CTS)
+    UART_FLOW_XONXOFF                   // in band; text links only, since
+                                        // XON/XOFF bytes are never data
+};
+
+#define UART_XON            0x11        // DC1
+#define UART_XOFF           0x13        // DC3
+#define UART_XONXOFF_TX_BURST 4         // TX FIFO bytes at once with XON/XOFF
+
+// Build with UART_RX_ERROR_TAGS to keep the receive error flags of every
+// byte in a second ring alongside the data (UART_RX_BUFFER_SIZE more
+// bytes of SRAM per port), readable with readTagged().
+
+// Line errors are counted in hardware terms so noise on the wire can be
+// told apart from software drops: rxOverrun means the ISR did not empty
+// the RX FIFO in time, rxOverflow that the main loop did not empty the
+// ring in time.
+struct UARTStats {
+    uint32_t rxBytes;                   // bytes moved from the RX FIFO
+    uint32_t txBytes;                   // bytes moved into the TX FIFO
+    uint32_t rxOverflow;                // bytes dropped, RX ring full
+    uint32_t txOverflow;                // bytes refused, TX ring full
+    uint32_t rxInterrupts;              // interrupts that serviced RX
+    uint32_t rxOverrun;                 // RX FIFO overruns, bytes lost
+    uint32_t rxFraming;                 // bytes with a bad stop bit
+    uint32_t rxParity;                  // bytes with a bad parity bit
+    uint32_t rxBreak;                   // break conditions
+    uint32_t rxThrottles;               // times the sender was stopped
+    uint32_t rxThrottledUs;             // time it stayed stopped
+    uint32_t txThrottles;               // times the receiver stopped us
+    uint32_t txThrottledUs;             // time it kept us stopped
+};
+
+//------------UART_Report------------
+// Print "uart port= rx= tx= rx_overflow= tx_overflow= rx_irqs=
+// rx_irq_per_kb= overrun= framing= parity= break= rx_throttles=
+// rx_throttled_us= tx_throttles= tx_throttled_us=" for one port's
+// counters
+// Input: out is the destination, name the port label, stats its counters
+// Output: none
+void UART_Report(ByteStream &out, const char *name, const UARTStats &stats);
+
+// One-shot notification that the transmitter has gone completely idle
+typedef void (*UARTTxDoneCallback)(void *context);
+
+// Per-byte receive hook, called from the ISR instead of queueing
+typedef void (*UARTRxHook)(void *context, uint8_t data);
+
+class BufferedUART : public ByteStream {
+public:
+    explicit BufferedUART(uint32_t base);
+
+    //------------init------------
+    // Hook the ISR into the vector table and enable RX, RX timeout,
+    // overrun and TX interrupts. The UART itself must already be
+    // configured.
+    // Input: handler is the vector that calls handleInterrupt()
+    // Output: none
+    void init(void (*handler)(void));
+
+    //------------read------------
+    // Non-blocking read from the RX ring
+    // Input: data receives up to len bytes
+    // Output: number of bytes copied
+    uint32_t read(uint8_t *data, uint32_t len) override;
+
+#ifdef UART_RX_ERROR_TAGS
+    //------------readTagged------------
+    // Non-blocking read from the RX ring along with each byte's receive
+    // error flags (UART_RXERROR_FRAMING, _PARITY, _BREAK; 0 if clean).
+    // Overruns lose bytes rather than damage them, so they only show in
+    // stats().rxOverrun.
+    // Input: data and errors receive up to len entries; errors may be 0
+    // Output: number of bytes copied
+    uint32_t readTagged(uint8_t *data, uint8_t *errors, uint32_t len);
+#endif
+
+    //------------write------------
+    // Non-blocking write into the TX ring
+    // Input: data points to len bytes to send
+    // Output: number of bytes accepted, the rest count as txOverflow
+    uint32_t write(const uint8_t *data, uint32_t len) override;
+
+    //------------send------------
+    // Hand a caller-owned buffer to the TX ISR without copying it. The
+    // ISR drains it straight into the FIFO once the TX ring is empty;
+    // write() refuses data until it finishes so ordering is preserved.
+    // The buffer must stay unchanged until sendBusy() returns false.
+    // Input: data points to len bytes to send
+    // Output: false if a previous send is still in progress
+    bool send(const uint8_t *data, uint32_t len);
+    bool sendBusy(void) const { return m_txExtLen != 0; }
+
+    //------------notifyTxDone------------
+    // Call back once everything queued so far, including the last stop
+    // bit, has left the shift register. The TX interrupt is switched to
+    // end-of-transmission mode for the final burst only, so streaming
+    // throughput is unaffected. The callback runs in interrupt context,
+    // or immediately if the transmitter is already idle.
+    // Input: callback and the context pointer passed back to it
+    // Output: none
+    void notifyTxDone(UARTTxDoneCallback callback, void *context);
+
+    //------------txPoke/txCommit------------
+    // Build outbound data in place in the TX ring instead of copying it
+    // in with write(). txPoke() stages a byte at an offset past what is
+    // already queued; txCommit() publishes the first len staged bytes
+    // and starts the transmitter. Main loop only, and check space()
+    // first: offsets must stay below it.
+    // Input: offset and data byte / number of bytes to publish
+    // Output: none
+    void txPoke(uint32_t offset, uint8_t data) { m_tx.poke(offset, data); }
+    void txCommit(uint32_t len);
+
+    //------------setRxAdaptive------------
+    // Let the ISR pick the RX FIFO trigger level from the traffic. It
+    // starts at 1/8 so light traffic is serviced early (a lone byte
+    // still waits for the receive timeout, about 3 character times).
+    // UART_RX_ADAPT_STREAK level interrupts with no timeout between them
+    // mean a stream, and the level goes to 7/8 so each interrupt moves
+    // 14 bytes; the timeout that ends the stream flushes the remainder
+    // and drops the level back to 1/8. Disabling leaves the current
+    // level; set a fixed one with UARTFIFOLevelSet(). Ignored in
+    // UART_FLOW_XONXOFF mode.
+    // Input: enable
+    // Output: none
+    void setRxAdaptive(bool enable);
+    bool rxLevelHigh(void) const { return m_rxHigh; }
+
+    //------------setFlowControl------------
+    // Stop the sender when the ISR fills the RX ring to highWater and
+    // let it go once read() drains it to lowWater. UART_FLOW_RTSCTS
+    // drives RTS from the watermarks and CTS holds our transmitter;
+    // UART_FLOW_XONXOFF sends XOFF/XON, takes them out of the received
+    // stream and fixes the RX trigger at 1/8. Time stopped is counted
+    // in stats(). No effect while an RX hook is installed.
+    // Input: mode, and the watermarks in bytes, lowWater < highWater
+    // Output: false (nothing changed) if the port has no such lines or
+    //         the watermarks do not fit the ring
+    bool setFlowControl(UARTFlowControl mode,
+                        uint32_t highWater = UART_RX_HIGH_WATER,
+                        uint32_t lowWater = UART_RX_LOW_WATER);
+    bool rxThrottled(void) const { return m_rxThrottled; }
+    bool txThrottled(void) const { return m_txThrottled; }
+
+    //------------setRxHook------------
+    // Hand every received byte to hook from the ISR instead of the RX
+    // ring, e.g. for a streaming protocol decoder. rxBytes still counts
+    // them; rxStamp() is not updated.
+    // Input: hook and the context pointer passed back to it, or 0 to go
+    //        back to the RX ring
+    // Output: none
+    void setRxHook(UARTRxHook hook, void *context);
+
+    //------------setRxWatch------------
+    // Show every received byte to watch from the ISR before it goes to
+    // the RX ring or hook, e.g. to spot an in-band escape sequence. The
+    // byte is still delivered; XON/XOFF consumed by flow control is not
+    // shown.
+    // Input: watch and the context pointer passed back to it, or 0
+    // Output: none
+    void setRxWatch(UARTRxHook watch, void *context);
+
+    uint32_t available(void) const override { return m_rx.count(); }
+    uint32_t space(void) const { return sendBusy() ? 0 : m_tx.space(); }
+    bool txIdle(void) const { return m_tx.empty() && !sendBusy(); }
+    uint32_t base(void) const { return m_base; }
+    const UARTStats &stats(void) const { return m_stats; }
+
+    //------------rxStamp------------
+    // Output: cycle count when the oldest byte now in the RX ring arrived,
+    // i.e. when the ring last went from empty to non-empty
+    uint32_t rxStamp(void) const { return m_rxStamp; }
+
+    //------------handleInterrupt------------
+    // Service RX/TX interrupt sources; called from the port's vector
+    // Input: none
+    // Output: none
+    void handleInterrupt(void);
+
+private:
+    void fillTxFifo(void);
+    void txDone(void);
+    void countRxErrors(uint32_t dr);
+    void adaptRxLevel(uint32_t status);
+    void setRxLevel(bool high);
+    void throttleRx(void);
+    void releaseRx(void);
+    void releaseThrottle(void);
+    void holdTx(bool held);
+    void ctsChanged(void);
+    void pauseTx(bool pause);
+
+    uint32_t m_base;
+    RingBuffer<UART_RX_BUFFER_SIZE> m_rx;
+#ifdef UART_RX_ERROR_TAGS
+    RingBuffer<UART_RX_BUFFER_SIZE> m_rxTags;   // error flags, one per byte
+#endif
+    RingBuffer<UART_TX_BUFFER_SIZE> m_tx;
+    const uint8_t *volatile m_txExt;    // zero-copy buffer being sent
+    volatile uint32_t m_txExtLen;       // bytes left in m_txExt
+    volatile uint32_t m_rxStamp;
+    UARTTxDoneCallback m_txDoneCallback;
+    void *m_txDoneContext;
+    UARTRxHook m_rxHook;
+    void *m_rxHookContext;
+    UARTRxHook m_rxWatch;
+    void *m_rxWatchContext;
+    uint32_t m_rxStreak;                // level interrupts since a timeout
+    UARTFlowControl m_flow;
+    uint32_t m_rxHighWater;
+    uint32_t m_rxLowWater;
+    uint32_t m_rxThrottleStart;         // cycle count when stopped
+    uint32_t m_txThrottleStart;
+    uint32_t m_txMask;                  // sources masked while the main
+                                        // loop feeds the TX FIFO
+    volatile uint8_t m_txCtrl;          // XON/XOFF to send next, 0 if none
+    volatile bool m_rxThrottled;        // sender told to stop
+    volatile bool m_txThrottled;        // CTS deasserted or XOFF received
+    volatile bool m_txPaused;           // XOFF received, data held back
+    bool m_rxAdaptive;
+    volatile bool m_rxHigh;             // RX trigger at 7/8
+    volatile bool m_txDoneArmed;
+    bool m_txEot;                       // TX interrupt in EOT mode
+    UARTStats m_stats;
+};
+
+extern BufferedUART UART0_Buffered;
+extern BufferedUART UART1_Buffered;
+
+//------------UART0_Handler/UART1_Handler------------
+// Port vectors, registered by UARTn_Buffered.init()
+void UART0_Handler(void);
+void UART1_Handler(void);
+
+#endif /* BUFFEREDUART_H_ */
@@ -0,0 +1,42 @@
+/*
+ * ByteStream.h
+ *
+ *  Common non-blocking byte stream interface shared by the polled,
+ *  interrupt driven and DMA UART drivers, so protocol code does not care
+ *  which transport is underneath.
+ */
+
+#ifndef BYTESTREAM_H_
+#define BYTESTREAM_H_
+
+#include <stdint.h>
+
+// One fragment of a scatter-gather write
+struct UARTIOVec {
+  const uint8_t *data;
+  uint32_t len;
+};
+
+class ByteStream {
+public:
+    //------------read------------
+    // Copy out whatever received data is ready, never waits
+    // Input: data receives up to len bytes
+    // Output: number of bytes copied
+    virtual uint32_t read(uint8_t *data, uint32_t len) = 0;
+
+    //------------write------------
+    // Queue as much as the transport can take right now, never waits
+    // Input: data points to len bytes to send
+    // Output: number of bytes accepted
+    virtual uint32_t write(const uint8_t *data, uint32_t len) = 0;
+
+    //------------available------------
+    // Output: number of received bytes read() would return
+    virtual uint32_t available(void) const = 0;
+
+protected:
+    ~ByteStream() {}
+};
+
+#endif /* BYTESTREAM_H_ */
@@ -0,0 +1,35 @@
+/*
+ * Cobs.cpp
+ *
+ *  Buffer to buffer COBS encode and decode.
+ */
+
+#include <stdint.h>
+#include "Cobs.h"
+
+uint32_t Cobs_Encode(const uint8_t *data, uint32_t len, uint8_t *dst){
+    uint32_t n = Cobs_EncodeWith(data, len,
+                                 [dst](uint32_t offset, uint8_t byte){
+                                     dst[offset] = byte;
+                                 });
+    dst[n] = 0;
+    return n + 1;
+}
+
+int32_t Cobs_Decode(const uint8_t *src, uint32_t len, uint8_t *dst,
+                    uint32_t maxLen){
+    CobsDecoder decoder;
+    decoder.begin(dst, maxLen);
+    for(uint32_t i = 0; i < len; i++){
+        CobsStatus status = decoder.put(src[i]);
+        if(status == COBS_FRAME){
+            return (int32_t)decoder.length();
+        }
+        if(status != COBS_MORE){
+            return -1;
+        }
+    }
+    // No delimiter in the buffer: finish the frame as if one followed
+    CobsStatus status = decoder.put(0);
+    return (status == COBS_FRAME) ? (int32_t)decoder.length() : -1;
+}
@@ -0,0 +1,163 @@
+/*
+ * Cobs.h
+ *
+ *  Consistent Overhead Byte Stuffing. A frame is encoded so it contains
+ *  no zero bytes and is terminated by a single zero, so a receiver that
+ *  loses sync (noise, a dropped byte, joining mid-stream) recovers at the
+ *  very next delimiter. Overhead is one byte per 254 bytes of payload
+ *  (rounded up) plus the delimiter.
+ */
+
+#ifndef COBS_H_
+#define COBS_H_
+
+#include <stdint.h>
+
+#define COBS_BLOCK      254             // data bytes per code byte, at most
+
+//------------Cobs_EncodedMax------------
+// Input: len payload bytes
+// Output: worst case encoded size, not counting the delimiter
+static inline constexpr uint32_t Cobs_EncodedMax(uint32_t len){
+    return (len == 0) ? 1 : len + ((len + COBS_BLOCK - 1) / COBS_BLOCK);
+}
+
+//------------Cobs_EncodeWith------------
+// Encode a payload, handing every output byte to a sink as it is
+// produced. Code bytes are filled in behind the data they describe, so
+// the sink must accept writes at earlier offsets (an in-place buffer or
+// ring slot); nothing is buffered here. The delimiter is not written.
+// Input: data points to len bytes, out(offset, byte) stores one byte
+// Output: encoded length, at most Cobs_EncodedMax(len)
+template <class Out>
+uint32_t Cobs_EncodeWith(const uint8_t *data, uint32_t len, Out out){
+    uint32_t codeAt = 0;
+    uint32_t next = 1;
+    uint8_t code = 1;
+
+    for(uint32_t i = 0; i < len; i++){
+        if(data[i] == 0){
+            out(codeAt, code);
+            codeAt = next++;
+            code = 1;
+            continue;
+        }
+        out(next++, data[i]);
+        if((++code == 0xFF) && ((i + 1) < len)){
+            // Block full, no implied zero. A full block that ends the
+            // payload is closed below instead.
+            out(codeAt, code);
+            codeAt = next++;
+            code = 1;
+        }
+    }
+    out(codeAt, code);
+    return next;
+}
+
+//------------Cobs_Encode------------
+// Encode into a buffer and append the zero delimiter
+// Input: data points to len bytes, dst has room for
+//        Cobs_EncodedMax(len) + 1 bytes
+// Output: bytes written including the delimiter
+uint32_t Cobs_Encode(const uint8_t *data, uint32_t len, uint8_t *dst);
+
+//------------Cobs_Decode------------
+// Decode one frame held in a buffer, with or without its delimiter
+// Input: src points to len encoded bytes, dst receives up to maxLen bytes
+// Output: payload length, or -1 if the frame is malformed or too long
+int32_t Cobs_Decode(const uint8_t *src, uint32_t len, uint8_t *dst,
+                    uint32_t maxLen);
+
+enum CobsStatus {
+    COBS_MORE,                          // byte consumed, frame not finished
+    COBS_FRAME,                         // delimiter ended a good frame
+    COBS_OVERSIZE,                      // frame outgrew the buffer
+    COBS_CORRUPT                        // delimiter inside a block
+};
+
+// Streaming decoder, fed one byte at a time (e.g. from an RX ISR). It
+// writes payload straight into the caller's buffer; after COBS_FRAME the
+// caller takes length() bytes and calls begin() before the next byte.
+// After an error it discards everything up to the next delimiter.
+class CobsDecoder {
+public:
+    CobsDecoder(void) { begin(0, 0); }
+
+    //------------begin------------
+    // Start a new frame
+    // Input: buf receives up to maxLen payload bytes; a null buffer
+    //        reports every non-empty frame as COBS_OVERSIZE
+    // Output: none
+    void begin(uint8_t *buf, uint32_t maxLen){
+        m_buf = buf;
+        m_maxLen = buf ? maxLen : 0;
+        m_frameLen = 0;
+        restart();
+    }
+
+    //------------put------------
+    // Input: one received byte
+    // Output: what the byte did, see CobsStatus. Each bad frame is
+    //         reported once; empty frames (back to back delimiters)
+    //         are skipped silently.
+    CobsStatus put(uint8_t byte){
+        if(byte == 0){
+            CobsStatus status = m_discard ? COBS_MORE :
+                                (m_left != 0) ? COBS_CORRUPT :
+                                m_started ? COBS_FRAME : COBS_MORE;
+            m_frameLen = m_len;
+            restart();
+            return status;
+        }
+        if(m_discard){
+            return COBS_MORE;
+        }
+        if(m_left == 0){
+            // Code byte: the block before it implied a zero unless it
+            // was a full one
+            if(m_started && (m_code != 0xFF) && !store(0)){
+                return COBS_OVERSIZE;
+            }
+            m_code = byte;
+            m_left = byte - 1;
+            m_started = true;
+            return COBS_MORE;
+        }
+        m_left--;
+        return store(byte) ? COBS_MORE : COBS_OVERSIZE;
+    }
+
+    //------------length------------
+    // Output: payload length of the frame just reported as COBS_FRAME
+    uint32_t length(void) const { return m_frameLen; }
+
+private:
+    void restart(void){
+        m_len = 0;
+        m_left = 0;
+        m_code = 0;
+        m_started = false;
+        m_discard = false;
+    }
+
+    bool store(uint8_t byte){
+        if(m_len >= m_maxLen){
+            m_discard = true;           // resync at the next delimiter
+            return false;
+        }
+        m_buf[m_len++] = byte;
+        return true;
+    }
+
+    uint8_t *m_buf;
+    uint32_t m_maxLen;
+    uint32_t m_len;                     // payload bytes stored so far
+    uint32_t m_frameLen;
+    uint8_t m_left;                     // data bytes left in this block
+    uint8_t m_code;                     // code byte of this block
+    bool m_started;                     // a code byte has been seen
+    bool m_discard;                     // bad frame, wait for a delimiter
+};
+
+#endif /* COBS_H_ */
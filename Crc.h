@@ -0,0 +1,153 @@
+/*
+ * Crc.h
+ *
+ *  CRC-16-CCITT (poly 0x1021, init 0xFFFF, MSB first, no final xor; the
+ *  "CCITT-FALSE" variant) and CRC-32 (IEEE 802.3, reflected poly
+ *  0xEDB88320, as in zip and Ethernet).
+ *
+ *  Three ways in, all giving the same result:
+ *    Crc16_Update/Crc32_Update  one byte, inline; cheap enough for an RX
+ *                               ISR that checks a frame as it arrives
+ *    Crc16_Block/Crc32_Block    bytewise table over a buffer
+ *    Crc16_Block4/Crc32_Block4  slicing-by-4, four table lookups per
+ *                               four bytes with no loop carried shift
+ *  Every form takes and returns the running CRC, so a frame can be fed in
+ *  any number of pieces. Start from CRC16_INIT/CRC32_INIT and finish with
+ *  Crc16_Final/Crc32_Final.
+ *
+ *  The tables are built by constexpr functions, so they are computed by
+ *  the compiler and placed in flash with the other constants; nothing is
+ *  generated at run time and no SRAM is used. Sizes: 2 KB for CRC-16,
+ *  4 KB for CRC-32 (four 256 entry tables each, the first of which is the
+ *  bytewise table).
+ */
+
+#ifndef CRC_H_
+#define CRC_H_
+
+#include <stdint.h>
+
+#define CRC16_INIT      0xFFFF
+#define CRC16_POLY      0x1021
+#define CRC32_INIT      0xFFFFFFFF
+#define CRC32_POLY      0xEDB88320      // reflected
+
+// Crc16()/Crc32() of the nine bytes "123456789"
+#define CRC16_CHECK     0x29B1
+#define CRC32_CHECK     0xCBF43926
+
+struct Crc16Tables {
+    uint16_t t[4][256];                 // t[k][i]: byte i followed by k zeros
+};
+
+struct Crc32Tables {
+    uint32_t t[4][256];
+};
+
+//------------Crc16_Build------------
+// Compile time table generator; see Crc16_Tables
+// Input: none
+// Output: the four slicing tables, t[0] being the bytewise table
+constexpr Crc16Tables Crc16_Build(void){
+    Crc16Tables tab = {};
+    for(uint32_t i = 0; i < 256; i++){
+        uint16_t crc = (uint16_t)(i << 8);
+        for(uint32_t bit = 0; bit < 8; bit++){
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ CRC16_POLY)
+                                 : (uint16_t)(crc << 1);
+        }
+        tab.t[0][i] = crc;
+    }
+    for(uint32_t k = 1; k < 4; k++){
+        for(uint32_t i = 0; i < 256; i++){
+            uint16_t prev = tab.t[k - 1][i];
+            tab.t[k][i] = (uint16_t)((prev << 8) ^ tab.t[0][prev >> 8]);
+        }
+    }
+    return tab;
+}
+
+//------------Crc32_Build------------
+// Compile time table generator; see Crc32_Tables
+// Input: none
+// Output: the four slicing tables, t[0] being the bytewise table
+constexpr Crc32Tables Crc32_Build(void){
+    Crc32Tables tab = {};
+    for(uint32_t i = 0; i < 256; i++){
+        uint32_t crc = i;
+        for(uint32_t bit = 0; bit < 8; bit++){
+            crc = (crc & 1) ? ((crc >> 1) ^ CRC32_POLY) : (crc >> 1);
+        }
+        tab.t[0][i] = crc;
+    }
+    for(uint32_t k = 1; k < 4; k++){
+        for(uint32_t i = 0; i < 256; i++){
+            uint32_t prev = tab.t[k - 1][i];
+            tab.t[k][i] = (prev >> 8) ^ tab.t[0][prev & 0xFF];
+        }
+    }
+    return tab;
+}
+
+// Defined in Crc.cpp from Crc16_Build()/Crc32_Build() as constexpr
+extern const Crc16Tables Crc16_Tables;
+extern const Crc32Tables Crc32_Tables;
+
+//------------Crc16_Update------------
+// Input: running crc, one data byte
+// Output: updated crc
+static inline uint16_t Crc16_Update(uint16_t crc, uint8_t data){
+    return (uint16_t)((crc << 8) ^ Crc16_Tables.t[0][(crc >> 8) ^ data]);
+}
+
+//------------Crc32_Update------------
+// Input: running crc, one data byte
+// Output: updated crc
+static inline uint32_t Crc32_Update(uint32_t crc, uint8_t data){
+    return (crc >> 8) ^ Crc32_Tables.t[0][(crc ^ data) & 0xFF];
+}
+
+static inline uint16_t Crc16_Final(uint16_t crc){ return crc; }
+static inline uint32_t Crc32_Final(uint32_t crc){ return ~crc; }
+
+//------------Crc16_Block------------
+// Bytewise table CRC over a buffer
+// Input: running crc, data points to len bytes
+// Output: updated crc
+uint16_t Crc16_Block(uint16_t crc, const uint8_t *data, uint32_t len);
+
+//------------Crc16_Block4------------
+// Slicing-by-4 CRC over a buffer, any length and alignment
+// Input: running crc, data points to len bytes
+// Output: updated crc, identical to Crc16_Block
+uint16_t Crc16_Block4(uint16_t crc, const uint8_t *data, uint32_t len);
+
+//------------Crc32_Block------------
+// Bytewise table CRC over a buffer
+// Input: running crc, data points to len bytes
+// Output: updated crc
+uint32_t Crc32_Block(uint32_t crc, const uint8_t *data, uint32_t len);
+
+//------------Crc32_Block4------------
+// Slicing-by-4 CRC over a buffer, any length and alignment
+// Input: running crc, data points to len bytes
+// Output: updated crc, identical to Crc32_Block
+uint32_t Crc32_Block4(uint32_t crc, const uint8_t *data, uint32_t len);
+
+//------------Crc16------------
+// One shot CRC-16-CCITT of a buffer
+// Input: data points to len bytes
+// Output: finished crc
+static inline uint16_t Crc16(const uint8_t *data, uint32_t len){
+    return Crc16_Final(Crc16_Block4(CRC16_INIT, data, len));
+}
+
+//------------Crc32------------
+// One shot CRC-32 of a buffer
+// Input: data points to len bytes
+// Output: finished crc
+static inline uint32_t Crc32(const uint8_t *data, uint32_t len){
+    return Crc32_Final(Crc32_Block4(CRC32_INIT, data, len));
+}
+
+#endif /* CRC_H_ */
@@ -0,0 +1,98 @@
+/*
+ * CycleCount.h
+ *
+ *  Access to the Cortex-M4 DWT cycle counter, which counts core clock
+ *  cycles and wraps every 2^32 cycles, and to the DWT profiling counters
+ *  from which the number of instructions executed is derived.
+ */
+
+#ifndef CYCLECOUNT_H_
+#define CYCLECOUNT_H_
+
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_types.h"
+
+#define DWT_O_CTRL              0x00000000  // DWT Control
+#define DWT_O_CYCCNT            0x00000004  // DWT Cycle Count
+#define DWT_O_CPICNT            0x00000008  // DWT CPI Count
+#define DWT_O_EXCCNT            0x0000000C  // DWT Exception Overhead Count
+#define DWT_O_SLEEPCNT          0x00000010  // DWT Sleep Count
+#define DWT_O_LSUCNT            0x00000014  // DWT LSU Count
+#define DWT_O_FOLDCNT           0x00000018  // DWT Folded-instruction Count
+#define DWT_CTRL_CYCCNTENA      0x00000001  // Enable the cycle counter
+#define DWT_CTRL_CPIEVTENA      0x00020000  // Enable the CPI counter
+#define DWT_CTRL_EXCEVTENA      0x00040000  // Enable the exception counter
+#define DWT_CTRL_SLEEPEVTENA    0x00080000  // Enable the sleep counter
+#define DWT_CTRL_LSUEVTENA      0x00100000  // Enable the LSU counter
+#define DWT_CTRL_FOLDEVTENA     0x00200000  // Enable the fold counter
+#define DWT_CTRL_EVTENA         (DWT_CTRL_CPIEVTENA | DWT_CTRL_EXCEVTENA |  \
+                                 DWT_CTRL_SLEEPEVTENA | DWT_CTRL_LSUEVTENA | \
+                                 DWT_CTRL_FOLDEVTENA)
+#define DWT_DEMCR               0xE000EDFC  // NVIC_DBG_INT, kept local so this
+                                            // header mixes with tm4c123gh6pm.h
+#define DWT_DEMCR_TRCENA        0x01000000  // Enable DWT and ITM blocks
+
+//------------CycleCounterInit------------
+// Power up the trace block and start the cycle counter. The count is
+// left as it is, since other modules hold timestamps from it; safe to
+// call again at any time.
+// Input: none
+// Output: none
+static inline void CycleCounterInit(void){
+  HWREG(DWT_DEMCR) |= DWT_DEMCR_TRCENA;
+  HWREG(DWT_BASE + DWT_O_CTRL) |= DWT_CTRL_CYCCNTENA;
+}
+
+//------------CycleCounterGet------------
+// Input: none
+// Output: current cycle count; subtract two readings for elapsed cycles
+static inline uint32_t CycleCounterGet(void){
+  return HWREG(DWT_BASE + DWT_O_CYCCNT);
+}
+
+// One reading of the cycle counter and the five 8 bit profiling counters
+struct InstrSample {
+  uint32_t cycles;
+  uint32_t stalls;                      // CPI + exception + sleep + LSU
+  uint32_t folded;
+};
+
+//------------InstrCounterInit------------
+// Start the cycle counter and the profiling counters
+// Input: none
+// Output: none
+static inline void InstrCounterInit(void){
+  CycleCounterInit();
+  HWREG(DWT_BASE + DWT_O_CTRL) |= DWT_CTRL_EVTENA;
+}
+
+//------------InstrCounterGet------------
+// Input: none
+// Output: fills *sample with the current counts
+static inline void InstrCounterGet(InstrSample *sample){
+  sample->cycles = HWREG(DWT_BASE + DWT_O_CYCCNT);
+  sample->stalls = HWREG(DWT_BASE + DWT_O_CPICNT) +
+                   HWREG(DWT_BASE + DWT_O_EXCCNT) +
+                   HWREG(DWT_BASE + DWT_O_SLEEPCNT) +
+                   HWREG(DWT_BASE + DWT_O_LSUCNT);
+  sample->folded = HWREG(DWT_BASE + DWT_O_FOLDCNT);
+}
+
+//------------InstrCounterElapsed------------
+// Every cycle either retires an instruction or is counted by one of the
+// stall counters, and a folded instruction retires for free, so
+//   instructions = cycles - stalls + folded
+// The profiling counters are 8 bits wide, so the result is exact only
+// while the stall total and the fold count each stay under 256 between
+// the two samples; time short sequences and add the results up.
+// Input: two samples, start taken first
+// Output: instructions executed between them
+static inline uint32_t InstrCounterElapsed(const InstrSample *start,
+                                           const InstrSample *end){
+  uint32_t stalls = (end->stalls - start->stalls) & 0xFF;
+  uint32_t folded = (end->folded - start->folded) & 0xFF;
+  return (end->cycles - start->cycles) - stalls + folded;
+}
+
+#endif /* CYCLECOUNT_H_ */
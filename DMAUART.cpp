@@ -0,0 +1,290 @@
+/*
+ * DMAUART.cpp
+ *
+ *  UART transport driven by the micro-DMA controller.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "uart.h"
+#include "uDMA.h"
+#include "Profile.h"
+#include "DMAUART.h"
+
+// RX moves whole DR entries, data byte and error bits, so line errors
+// are counted per byte as on the interrupt path
+#define RX_FLAGS (UDMA_CTL_DSTINC_16 | UDMA_CTL_DSTSIZE_16 |                  \
+                  UDMA_CTL_SRCINC_NONE | UDMA_CTL_SRCSIZE_16 |                \
+                  UDMA_CTL_ARBSIZE_8)
+#define TX_FLAGS (UDMA_CTL_DSTINC_NONE | UDMA_CTL_DSTSIZE_8 |                 \
+                  UDMA_CTL_SRCINC_8 | UDMA_CTL_SRCSIZE_8 |                    \
+                  UDMA_CTL_ARBSIZE_4)
+#define SG_FLAGS (UDMA_CTL_DSTINC_32 | UDMA_CTL_DSTSIZE_32 |                  \
+                  UDMA_CTL_SRCINC_32 | UDMA_CTL_SRCSIZE_32 |                  \
+                  UDMA_CTL_ARBSIZE_4)
+
+DMAUART UART0_DMA(UART0_BASE, UDMA_CH_UART0RX, UDMA_CH_UART0TX);
+DMAUART UART1_DMA(UART1_BASE, UDMA_CH_UART1RX, UDMA_CH_UART1TX);
+
+DMAUART::DMAUART(uint32_t base, uint32_t rxChannel, uint32_t txChannel)
+    : m_base(base), m_rxChannel(rxChannel), m_txChannel(txChannel),
+      m_rxActive(0), m_rxDelivered(0), m_rxCallback(0),
+      m_txBusy(false), m_txPending(0) {
+    m_stats.rxBytes = 0;
+    m_stats.txBytes = 0;
+    m_stats.rxOverflow = 0;
+    m_stats.txOverflow = 0;
+    m_stats.rxInterrupts = 0;
+    m_stats.rxOverrun = 0;
+    m_stats.rxFraming = 0;
+    m_stats.rxParity = 0;
+    m_stats.rxBreak = 0;
+    m_stats.rxThrottles = 0;
+    m_stats.rxThrottledUs = 0;
+    m_stats.txThrottles = 0;
+    m_stats.txThrottledUs = 0;
+}
+
+void DMAUART::init(void (*handler)(void)){
+    uDMA_Init();
+    UARTIntDisable(m_base, 0xFFFFFFFF);
+    UARTIntClear(m_base, 0xFFFFFFFF);
+
+    // RX bursts of 8 match the half-full trigger; anything short of a
+    // burst is left in the FIFO for the receive timeout to flush
+    UARTFIFOLevelSet(m_base, UART_FIFO_TX4_8, UART_FIFO_RX4_8);
+    uDMA_ChannelReset(m_rxChannel);
+    uDMA_ChannelReset(m_txChannel);
+    uDMA_ChannelAssign(m_rxChannel, 0);
+    uDMA_ChannelAssign(m_txChannel, 0);
+    uDMA_UseBurst(m_rxChannel, true);
+
+    m_rxActive = 0;
+    m_rxDelivered = 0;
+    armRx(0);
+    armRx(1);
+    uDMA_ChannelEnable(m_rxChannel);
+
+    UARTDMAEnable(m_base, UART_DMA_RX | UART_DMA_TX);
+    UARTIntRegister(m_base, handler);
+    // Framing, parity and break are counted from the DR entries; their
+    // interrupts only flush, since bad bytes landing as whole bursts
+    // leave nothing in the FIFO for a receive timeout. An overrun loses
+    // the byte, so it can only be seen from its interrupt.
+    UARTIntEnable(m_base, UART_INT_RT | UART_INT_OE | UART_INT_BE |
+                          UART_INT_PE | UART_INT_FE);
+}
+
+void DMAUART::armRx(uint32_t half){
+    uDMAControl *ctl = half ? uDMA_Alternate(m_rxChannel)
+                            : uDMA_Primary(m_rxChannel);
+    ctl->srcEnd = m_base + UART_O_DR;
+    ctl->dstEnd = uDMA_Addr(&m_rxBuf[half][UART_DMA_RX_HALF - 1]);
+    ctl->control = uDMA_Control(RX_FLAGS, UART_DMA_RX_HALF,
+                                UDMA_MODE_PINGPONG);
+}
+
+uint32_t DMAUART::read(uint8_t *data, uint32_t len){
+    return m_rx.read(data, len);
+}
+
+// Same accounting as BufferedUART::countRxErrors()
+void DMAUART::countRxErrors(uint32_t dr){
+    if(dr & UART_DR_BE){
+        m_stats.rxBreak++;              // a break also fails framing
+    }else{
+        if(dr & UART_DR_FE){
+            m_stats.rxFraming++;
+        }
+        if(dr & UART_DR_PE){
+            m_stats.rxParity++;
+        }
+    }
+}
+
+// Strip DR entries down to their data bytes, counting the error flags
+// on the way, and pass the bytes on
+void DMAUART::take(const uint16_t *entries, uint32_t len){
+    uint8_t data[UART_DMA_RX_HALF];
+    uint16_t errors = 0;
+    for(uint32_t i = 0; i < len; i++){
+        data[i] = (uint8_t)entries[i];
+        errors |= entries[i];
+    }
+    if(errors & (UART_DR_BE | UART_DR_PE | UART_DR_FE)){
+        for(uint32_t i = 0; i < len; i++){
+            countRxErrors(entries[i]);
+        }
+    }
+    deliver(data, len);
+}
+
+void DMAUART::deliver(const uint8_t *data, uint32_t len){
+    if(len == 0){
+        return;
+    }
+    m_stats.rxBytes += len;
+    if(m_rxCallback){
+        m_rxCallback(data, len);
+    }else{
+        m_stats.rxOverflow += len - m_rx.write(data, len);
+    }
+}
+
+// Pass on every half the controller has finished, oldest first, and
+// hand it straight back to the controller
+void DMAUART::serviceRx(void){
+    for(uint32_t i = 0; i < 2; i++){
+        uDMAControl *ctl = m_rxActive ? uDMA_Alternate(m_rxChannel)
+                                      : uDMA_Primary(m_rxChannel);
+        if(uDMA_Mode(ctl) != UDMA_MODE_STOP){
+            break;
+        }
+        take(&m_rxBuf[m_rxActive][m_rxDelivered],
+             UART_DMA_RX_HALF - m_rxDelivered);
+        m_rxDelivered = 0;
+        armRx(m_rxActive);
+        m_rxActive ^= 1;
+    }
+
+    // If both halves filled before we got here the controller stopped
+    // the channel; restart it on the half we expect next
+    if(!uDMA_ChannelIsEnabled(m_rxChannel)){
+        uDMA_SelectAlt(m_rxChannel, m_rxActive != 0);
+        uDMA_ChannelEnable(m_rxChannel);
+    }
+}
+
+// Receive timeout: the line went quiet with less than a burst in the
+// FIFO. Pass on what DMA already stored in the active half, then drain
+// the FIFO by hand. Requests are masked meanwhile so the controller
+// cannot slip newer bytes in ahead of the ones being drained.
+void DMAUART::flushRx(void){
+    uint16_t tail[16];
+    uint32_t n = 0;
+
+    uDMA_RequestMask(m_rxChannel, true);
+    serviceRx();
+    uDMAControl *ctl = m_rxActive ? uDMA_Alternate(m_rxChannel)
+                                  : uDMA_Primary(m_rxChannel);
+    uint32_t done = UART_DMA_RX_HALF - uDMA_Remaining(ctl);
+    if(done > m_rxDelivered){
+        take(&m_rxBuf[m_rxActive][m_rxDelivered], done - m_rxDelivered);
+        m_rxDelivered = done;
+    }
+    while((n < sizeof(tail)) &&
+          ((HWREG(m_base + UART_O_FR) & UART_FR_RXFE) == 0)){
+        tail[n++] = (uint16_t)HWREG(m_base + UART_O_DR);
+    }
+    take(tail, n);
+    uDMA_RequestMask(m_rxChannel, false);
+}
+
+void DMAUART::startTx(uint32_t tasks, uint32_t bytes){
+    uDMAControl *pri = uDMA_Primary(m_txChannel);
+    if(tasks > 1){
+        // The primary structure copies each task into the alternate
+        // structure, which then runs it against the UART
+        pri->srcEnd = uDMA_Addr(&m_txTasks[tasks - 1].spare);
+        pri->dstEnd = uDMA_Addr(&uDMA_Alternate(m_txChannel)->spare);
+        pri->control = uDMA_Control(SG_FLAGS, tasks * 4, UDMA_MODE_PER_SG);
+    }else{
+        pri->srcEnd = m_txTasks[0].srcEnd;
+        pri->dstEnd = m_txTasks[0].dstEnd;
+        pri->control = (m_txTasks[0].control & ~UDMA_CTL_MODE_M) |
+                       UDMA_MODE_BASIC;
+    }
+    m_txPending = bytes;
+    m_txBusy = true;
+    uDMA_SelectAlt(m_txChannel, false);
+    uDMA_ChannelEnable(m_txChannel);
+}
+
+uint32_t DMAUART::write(const uint8_t *data, uint32_t len){
+    if(m_txBusy || (len == 0)){
+        return 0;
+    }
+    if(len > UART_DMA_TX_BOUNCE){
+        len = UART_DMA_TX_BOUNCE;
+    }
+    memcpy(m_txBounce, data, len);
+    m_txTasks[0].srcEnd = uDMA_Addr(&m_txBounce[len - 1]);
+    m_txTasks[0].dstEnd = m_base + UART_O_DR;
+    m_txTasks[0].control = uDMA_Control(TX_FLAGS, len, UDMA_MODE_BASIC);
+    startTx(1, len);
+    return len;
+}
+
+bool DMAUART::writev(const UARTIOVec *iov, uint32_t cnt){
+    uint32_t tasks = 0;
+    uint32_t bytes = 0;
+
+    if(m_txBusy){
+        return false;
+    }
+    for(uint32_t i = 0; i < cnt; i++){
+        const uint8_t *data = iov[i].data;
+        uint32_t len = iov[i].len;
+        while(len > 0){
+            uint32_t chunk = (len > UDMA_MAX_XFER) ? UDMA_MAX_XFER : len;
+            if(tasks == UART_DMA_TX_TASKS){
+                return false;
+            }
+            m_txTasks[tasks].srcEnd = uDMA_Addr(&data[chunk - 1]);
+            m_txTasks[tasks].dstEnd = m_base + UART_O_DR;
+            m_txTasks[tasks].control = uDMA_Control(TX_FLAGS, chunk,
+                                                    UDMA_MODE_PER_SG_ALT);
+            tasks++;
+            bytes += chunk;
+            data += chunk;
+            len -= chunk;
+        }
+    }
+    if(tasks == 0){
+        return true;
+    }
+    // The last task runs as a plain basic transfer, ending the list
+    m_txTasks[tasks - 1].control =
+        (m_txTasks[tasks - 1].control & ~UDMA_CTL_MODE_M) | UDMA_MODE_BASIC;
+    startTx(tasks, bytes);
+    return true;
+}
+
+void DMAUART::handleInterrupt(void){
+    uint32_t status = UARTIntStatus(m_base, true);
+    UARTIntClear(m_base, status);
+    HWREG(UDMA_BASE + UDMA_O_CHIS) = (1 << m_rxChannel) | (1 << m_txChannel);
+
+    if(status & UART_INT_OE){
+        m_stats.rxOverrun++;
+        UARTRxErrorClear(m_base);
+    }
+    uint32_t rxBefore = m_stats.rxBytes;
+    serviceRx();
+    if(status & (UART_INT_RT | UART_INT_BE | UART_INT_PE | UART_INT_FE)){
+        flushRx();
+    }
+    if((m_stats.rxBytes != rxBefore) || (status & UART_INT_RT)){
+        m_stats.rxInterrupts++;
+    }
+    if(m_txBusy && !uDMA_ChannelIsEnabled(m_txChannel)){
+        m_stats.txBytes += m_txPending;
+        m_txPending = 0;
+        m_txBusy = false;
+    }
+}
+
+// One profile site per port, so the two ISRs are timed apart
+void UART0_DMAHandler(void){
+    PROFILE_SCOPE("uart0_dma_isr");
+    UART0_DMA.handleInterrupt();
+}
+
+void UART1_DMAHandler(void){
+    PROFILE_SCOPE("uart1_dma_isr");
+    UART1_DMA.handleInterrupt();
+}
@@ -0,0 +1,105 @@
+/*
+ * DMAUART.h
+ *
+ *  UART transport that moves data with the micro-DMA controller. RX runs
+ *  continuously into a ping-pong pair of buffers; TX sends a bounce
+ *  buffer or a caller supplied scatter list. The CPU only takes an
+ *  interrupt per completed half buffer, per finished transmit and per
+ *  RX timeout (to flush a partial burst).
+ */
+
+#ifndef DMAUART_H_
+#define DMAUART_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "ByteStream.h"
+#include "RingBuffer.h"
+#include "uDMA.h"
+
+#define UART_DMA_RX_HALF   128          // bytes per ping-pong half, multiple of 8;
+                                        // each takes a 16-bit DR entry
+#define UART_DMA_TX_BOUNCE 256          // bytes copied by write()
+#define UART_DMA_TX_TASKS  8            // scatter list entries per writev()
+
+// uDMA channel assignments (encoding 0) from the TM4C123 datasheet
+#define UDMA_CH_UART0RX    8
+#define UDMA_CH_UART0TX    9
+#define UDMA_CH_UART1RX    22
+#define UDMA_CH_UART1TX    23
+
+// Called from the ISR with each batch of received bytes. The data is
+// only valid until the callback returns.
+typedef void (*DMARxCallback)(const uint8_t *data, uint32_t len);
+
+class DMAUART : public ByteStream {
+public:
+    DMAUART(uint32_t base, uint32_t rxChannel, uint32_t txChannel);
+
+    //------------init------------
+    // Arm both RX halves, enable UART DMA requests and hook the ISR.
+    // The UART itself must already be configured.
+    // Input: handler is the vector that calls handleInterrupt()
+    // Output: none
+    void init(void (*handler)(void));
+
+    //------------setRxCallback------------
+    // Deliver received data straight from the DMA buffers instead of
+    // copying it into the RX ring for read()
+    // Input: callback, or 0 to go back to the RX ring
+    // Output: none
+    void setRxCallback(DMARxCallback callback) { m_rxCallback = callback; }
+
+    uint32_t read(uint8_t *data, uint32_t len) override;
+    uint32_t available(void) const override { return m_rx.count(); }
+
+    //------------write------------
+    // Copy into the bounce buffer and start a DMA transfer
+    // Input: data points to len bytes to send
+    // Output: bytes accepted; 0 while a transfer is still running
+    uint32_t write(const uint8_t *data, uint32_t len) override;
+
+    //------------writev------------
+    // Send a scatter list in one peripheral scatter-gather transfer
+    // without copying. Fragments over 1024 bytes take several list
+    // entries. The buffers must stay unchanged until txBusy() is false.
+    // Input: iov points to cnt fragments
+    // Output: false if busy or the list needs more than UART_DMA_TX_TASKS
+    bool writev(const UARTIOVec *iov, uint32_t cnt);
+
+    bool txBusy(void) const { return m_txBusy; }
+    const UARTStats &stats(void) const { return m_stats; }
+
+    void handleInterrupt(void);
+
+private:
+    void armRx(uint32_t half);
+    void serviceRx(void);
+    void flushRx(void);
+    void countRxErrors(uint32_t dr);
+    void take(const uint16_t *entries, uint32_t len);
+    void deliver(const uint8_t *data, uint32_t len);
+    void startTx(uint32_t tasks, uint32_t bytes);
+
+    uint32_t m_base;
+    uint32_t m_rxChannel;
+    uint32_t m_txChannel;
+    uint16_t m_rxBuf[2][UART_DMA_RX_HALF];  // DR entries, errors included
+    uint32_t m_rxActive;                // half the DMA is filling
+    uint32_t m_rxDelivered;             // bytes of that half already passed on
+    DMARxCallback m_rxCallback;
+    RingBuffer<UART_RX_BUFFER_SIZE> m_rx;
+    uint8_t m_txBounce[UART_DMA_TX_BOUNCE];
+    uDMAControl m_txTasks[UART_DMA_TX_TASKS];
+    volatile bool m_txBusy;
+    uint32_t m_txPending;               // bytes in the running transfer
+    UARTStats m_stats;
+};
+
+extern DMAUART UART0_DMA;
+extern DMAUART UART1_DMA;
+
+void UART0_DMAHandler(void);
+void UART1_DMAHandler(void);
+
+#endif /* DMAUART_H_ */
@@ -0,0 +1,68 @@
+/*
+ * Escape.cpp
+ *
+ *  Guard time + "+++" + guard time detector.
+ */
+
+#include <stdint.h>
+#include "uart.h"
+#include "Timebase.h"
+#include "Escape.h"
+
+EscapeDetector::EscapeDetector(BufferedUART &uart, uint32_t guardMs,
+                               uint8_t escape)
+  : m_uart(uart), m_guardMs(guardMs), m_escape(escape), m_last(0),
+    m_seen(0), m_escapes(0) {}
+
+void EscapeDetector::start(void){
+  m_last = Timebase_Millis();
+  m_seen = 0;
+  m_uart.setRxWatch(RxWatch, this);
+}
+
+void EscapeDetector::stop(void){
+  m_uart.setRxWatch(0, 0);
+}
+
+// ISR: every byte restarts the guard time. Millisecond stamps, so a gap
+// only counts as a guard time once it is strictly longer.
+void EscapeDetector::RxWatch(void *context, uint8_t data){
+  EscapeDetector *self = (EscapeDetector *)context;
+  uint32_t now = Timebase_Millis();
+  uint32_t gap = now - self->m_last;
+  uint8_t seen = 0;
+  if(data == self->m_escape){
+    if(self->m_seen == 0){
+      seen = (gap > self->m_guardMs) ? 1 : 0;
+    }else if((self->m_seen < ESCAPE_COUNT) && (gap <= self->m_guardMs)){
+      seen = self->m_seen + 1;
+    }
+  }
+  self->m_last = now;
+  self->m_seen = seen;
+}
+
+bool EscapeDetector::poll(void){
+  if(m_seen != ESCAPE_COUNT){
+    return false;
+  }
+  bool done = false;
+  UARTIntDisable(m_uart.base(), UART_INT_RX | UART_INT_RT);
+  // both fields from the same byte, and no byte after the last escape
+  if((m_seen == ESCAPE_COUNT) &&
+     ((Timebase_Millis() - m_last) > m_guardMs)){
+    m_seen = 0;
+    m_escapes++;
+    done = true;
+  }
+  UARTIntEnable(m_uart.base(), UART_INT_RX | UART_INT_RT);
+  return done;
+}
+
+uint32_t EscapeDetector::wakeMs(void) const {
+  if(m_seen != ESCAPE_COUNT){
+    return ESCAPE_NONE;
+  }
+  uint32_t gap = Timebase_Millis() - m_last;
+  return (gap > m_guardMs) ? 0 : m_guardMs + 1 - gap;
+}
@@ -0,0 +1,77 @@
+/*
+ * Escape.h
+ *
+ *  Hayes style in-band escape: a guard time of silence, three escape
+ *  characters ("+++") each within a guard time of the last, then another
+ *  guard time of silence. The RX ISR follows the sequence through the
+ *  port's RX watch with a compare and a timestamp per byte; the bytes
+ *  themselves are delivered as usual, so forwarded traffic, the escape
+ *  characters included, is not held back. The closing guard time is
+ *  checked from the main loop by poll(), which reports the escape once
+ *  it has passed.
+ *
+ *  Timestamps come from Timebase_Millis, which keeps counting through
+ *  the idle manager's sleeps; Timebase_Init must have run.
+ */
+
+#ifndef ESCAPE_H_
+#define ESCAPE_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+
+#define ESCAPE_CHAR         '+'         // Hayes S2
+#define ESCAPE_COUNT        3
+#define ESCAPE_GUARD_MS     1000        // Hayes S12 default, 50/50 s
+#define ESCAPE_NONE         0xFFFFFFFF  // nothing due; equals IDLE_FOREVER
+
+class EscapeDetector {
+public:
+  EscapeDetector(BufferedUART &uart, uint32_t guardMs = ESCAPE_GUARD_MS,
+                 uint8_t escape = ESCAPE_CHAR);
+
+  //------------start------------
+  // Watch the port's received bytes; the line counts as quiet from now
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------stop------------
+  // Input: none
+  // Output: none
+  void stop(void);
+
+  //------------poll------------
+  // Call from the main loop
+  // Input: none
+  // Output: true, once, when a sequence has been followed by a guard
+  //         time of silence
+  bool poll(void);
+
+  //------------wakeMs------------
+  // For Idle_Enter: the closing guard time passes without an interrupt
+  // Input: none
+  // Output: ms until poll() could next return true, ESCAPE_NONE if no
+  //         complete sequence is waiting on its guard time
+  uint32_t wakeMs(void) const;
+
+  uint32_t escapes(void) const { return m_escapes; }
+
+  //------------RxWatch------------
+  // The per-byte step the RX ISR runs through the port's RX watch;
+  // public so UART0_BenchEscape can time it on its own
+  // Input: context is the detector, data the received byte
+  // Output: none
+  static void RxWatch(void *context, uint8_t data);
+
+private:
+
+  BufferedUART &m_uart;
+  uint32_t m_guardMs;
+  uint8_t m_escape;
+  volatile uint32_t m_last;             // ms, last byte seen; ISR only
+  volatile uint8_t m_seen;              // escape characters in a row
+  uint32_t m_escapes;
+};
+
+#endif /* ESCAPE_H_ */
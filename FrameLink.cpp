@@ -0,0 +1,113 @@
+/*
+ * FrameLink.cpp
+ *
+ *  COBS message framing over a BufferedUART port.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "Cobs.h"
+#include "FrameLink.h"
+
+FrameLink UART1_Frames(UART1_Buffered);
+
+FrameLink::FrameLink(BufferedUART &uart, uint32_t maxPayload)
+  : m_uart(uart),
+    m_maxPayload((maxPayload > FRAME_MAX_PAYLOAD) ? FRAME_MAX_PAYLOAD
+                                                  : maxPayload),
+    m_rxHead(0), m_rxTail(0), m_decoding(false) {
+  m_stats.framesIn = 0;
+  m_stats.framesOut = 0;
+  m_stats.oversize = 0;
+  m_stats.corrupt = 0;
+  m_stats.dropped = 0;
+  m_stats.refused = 0;
+}
+
+// Point the decoder at the next free slot, or at nothing while the main
+// loop has every slot; frames arriving meanwhile are counted as dropped
+void FrameLink::nextSlot(void){
+  m_decoding = (m_rxHead - m_rxTail) < FRAME_RX_SLOTS;
+  if(m_decoding){
+    m_decoder.begin(m_slot[m_rxHead % FRAME_RX_SLOTS], m_maxPayload);
+  }else{
+    m_decoder.begin(0, 0);
+  }
+}
+
+// RX ISR context
+void FrameLink::RxByte(void *context, uint8_t data){
+  FrameLink *link = (FrameLink *)context;
+
+  switch(link->m_decoder.put(data)){
+    case COBS_MORE:
+      break;
+    case COBS_FRAME:
+      if(link->m_decoding && (link->m_decoder.length() != 0)){
+        link->m_slotLen[link->m_rxHead % FRAME_RX_SLOTS] =
+            (uint16_t)link->m_decoder.length();
+        link->m_rxHead = link->m_rxHead + 1;    // publish after the length
+        link->m_stats.framesIn++;
+      }
+      break;
+    case COBS_OVERSIZE:
+      if(link->m_decoding){
+        link->m_stats.oversize++;
+      }else{
+        link->m_stats.dropped++;
+      }
+      break;
+    case COBS_CORRUPT:
+      link->m_stats.corrupt++;
+      break;
+  }
+  if(data == 0){
+    link->nextSlot();                   // every delimiter starts a frame
+  }
+}
+
+void FrameLink::start(void){
+  m_rxHead = 0;
+  m_rxTail = 0;
+  nextSlot();
+  m_uart.setRxHook(RxByte, this);
+}
+
+void FrameLink::stop(void){
+  m_uart.setRxHook(0, 0);
+  m_rxHead = 0;
+  m_rxTail = 0;
+}
+
+uint32_t FrameLink::write(const uint8_t *data, uint32_t len){
+  if(!writable(len)){
+    m_stats.refused++;
+    return 0;
+  }
+  uint32_t n = Cobs_EncodeWith(data, len,
+                               [this](uint32_t offset, uint8_t byte){
+                                 m_uart.txPoke(offset, byte);
+                               });
+  m_uart.txPoke(n, 0);
+  m_uart.txCommit(n + 1);
+  m_stats.framesOut++;
+  return len;
+}
+
+uint32_t FrameLink::read(uint8_t *data, uint32_t len){
+  uint32_t tail = m_rxTail;
+  if(tail == m_rxHead){
+    return 0;
+  }
+  if(len > m_slotLen[tail % FRAME_RX_SLOTS]){
+    len = m_slotLen[tail % FRAME_RX_SLOTS];
+  }
+  memcpy(data, m_slot[tail % FRAME_RX_SLOTS], len);
+  m_rxTail = tail + 1;                  // release the slot after the copy
+  return len;
+}
+
+uint32_t FrameLink::available(void) const {
+  uint32_t tail = m_rxTail;
+  return (tail == m_rxHead) ? 0 : m_slotLen[tail % FRAME_RX_SLOTS];
+}
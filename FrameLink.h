@@ -0,0 +1,101 @@
+/*
+ * FrameLink.h
+ *
+ *  Message framing over a BufferedUART port using COBS with zero
+ *  delimiters. Received bytes are decoded one at a time in the RX ISR
+ *  straight into a small queue of frame slots, so the main loop only
+ *  ever sees whole frames; outbound frames are encoded directly into the
+ *  port's TX ring. Noise costs at most the frame it lands in: the
+ *  decoder resynchronizes at the next delimiter. As a ByteStream, each
+ *  read() and write() moves exactly one frame.
+ */
+
+#ifndef FRAMELINK_H_
+#define FRAMELINK_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "ByteStream.h"
+#include "Cobs.h"
+
+#define FRAME_MAX_PAYLOAD   COBS_BLOCK  // one COBS block; fits the TX ring
+#define FRAME_RX_SLOTS      4           // decoded frames queued, power of two
+
+static_assert(Cobs_EncodedMax(FRAME_MAX_PAYLOAD) + 1 <= UART_TX_BUFFER_SIZE,
+              "largest encoded frame must fit the TX ring");
+
+struct FrameStats {
+  uint32_t framesIn;                    // good frames queued for read()
+  uint32_t framesOut;                   // frames handed to the TX ring
+  uint32_t oversize;                    // frames longer than maxPayload
+  uint32_t corrupt;                     // frames cut short by a delimiter
+  uint32_t dropped;                     // good frames lost, slots full
+  uint32_t refused;                     // write() calls that did not fit
+};
+
+class FrameLink : public ByteStream {
+public:
+  //------------FrameLink------------
+  // Input: uart is the port to frame, maxPayload the largest frame
+  //        accepted in either direction (at most FRAME_MAX_PAYLOAD)
+  FrameLink(BufferedUART &uart, uint32_t maxPayload = FRAME_MAX_PAYLOAD);
+
+  //------------start------------
+  // Take over the port's RX path; raw bytes no longer reach its ring
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------stop------------
+  // Give the RX path back to the port's ring and drop queued frames
+  // Input: none
+  // Output: none
+  void stop(void);
+
+  //------------write------------
+  // Encode a frame straight into the TX ring, delimiter included. The
+  // whole frame is published at once, so the ISR never sends half of it.
+  // Input: data points to len bytes, 1 <= len <= maxPayload
+  // Output: len, or 0 if the frame is too long or the ring lacks room
+  uint32_t write(const uint8_t *data, uint32_t len) override;
+
+  //------------read------------
+  // Take the oldest received frame
+  // Input: data receives up to len bytes; the rest of a longer frame
+  //        is discarded
+  // Output: bytes copied, 0 if no frame is waiting
+  uint32_t read(uint8_t *data, uint32_t len) override;
+
+  //------------available------------
+  // Output: length of the oldest received frame, 0 if none
+  uint32_t available(void) const override;
+
+  //------------writable------------
+  // Input: len payload bytes
+  // Output: true if write() would take a frame of that length now
+  bool writable(uint32_t len) const {
+    return (len != 0) && (len <= m_maxPayload) &&
+           (m_uart.space() >= Cobs_EncodedMax(len) + 1);
+  }
+
+  uint32_t pending(void) const { return m_rxHead - m_rxTail; }
+  const FrameStats &stats(void) const { return m_stats; }
+
+private:
+  static void RxByte(void *context, uint8_t data);
+  void nextSlot(void);
+
+  BufferedUART &m_uart;
+  uint32_t m_maxPayload;
+  CobsDecoder m_decoder;
+  uint8_t m_slot[FRAME_RX_SLOTS][FRAME_MAX_PAYLOAD];
+  uint16_t m_slotLen[FRAME_RX_SLOTS];
+  volatile uint32_t m_rxHead;           // written by the ISR only
+  volatile uint32_t m_rxTail;           // written by the main loop only
+  bool m_decoding;                      // decoder owns slot m_rxHead
+  FrameStats m_stats;
+};
+
+extern FrameLink UART1_Frames;
+
+#endif /* FRAMELINK_H_ */
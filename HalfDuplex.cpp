@@ -0,0 +1,218 @@
+/*
+ * HalfDuplex.cpp
+ *
+ *  Table driven turnaround scheduler for the half-duplex device link.
+ */
+
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "cpu.h"
+#include "CycleCount.h"
+#include "SysClock.h"
+#include "HalfDuplex.h"
+
+#define GPIO_O_DIR          0x00000400  // GPIO Direction
+#define GPIO_O_AFSEL        0x00000420  // GPIO Alternate Function Select
+#define GPIO_O_DEN          0x0000051C  // GPIO Digital Enable
+
+// Every direction change the link can make. RX -> TX happens once frames
+// are waiting and the line has been quiet for guardToTxUs; TX -> RX
+// happens on the end-of-transmission interrupt, after guardToRxUs.
+const HalfDuplexLink::Transition HalfDuplexLink::Table[] = {
+  {LINK_RX,       EV_FRAMES_PENDING, LINK_TX_DRAIN, ACT_SEND_BATCH},
+  {LINK_TX_DRAIN, EV_EOT,            LINK_GUARD_RX, ACT_HOLD_DRIVER},
+  {LINK_GUARD_RX, EV_GUARD_EXPIRED,  LINK_RX,       ACT_RELEASE_DRIVER},
+};
+
+HalfDuplexLink::HalfDuplexLink(BufferedUART &uart,
+                               const HalfDuplexConfig &config)
+  : m_uart(uart), m_config(config), m_state(LINK_RX),
+    m_frameHead(0), m_frameTail(0), m_eot(false), m_eotCycle(0),
+    m_lastRxBytes(0), m_lastRxCycle(0), m_passThrough(false) {
+  if(m_config.bytesPerTurn > UART_TX_BUFFER_SIZE){
+    m_config.bytesPerTurn = UART_TX_BUFFER_SIZE;
+  }
+  m_stats.turns = 0;
+  m_stats.framesSent = 0;
+  m_stats.bytesSent = 0;
+  m_stats.framesRefused = 0;
+  m_stats.txToRxUsLast = 0;
+  m_stats.txToRxUsMax = 0;
+  m_stats.rxToTxUsLast = 0;
+  m_stats.rxToTxUsMax = 0;
+}
+
+void HalfDuplexLink::drive(bool transmit){
+  // masked data address touches only the direction pin
+  HWREG(m_config.gpioBase + (m_config.gpioPin << 2)) =
+      transmit ? m_config.gpioPin : 0;
+}
+
+void HalfDuplexLink::setup(void){
+  HWREG(SYSCTL_RCGCGPIO) |= m_config.gpioClock;
+  while((HWREG(SYSCTL_PRGPIO) & m_config.gpioClock) == 0);
+  HWREG(m_config.gpioBase + GPIO_O_AFSEL) &= ~m_config.gpioPin;
+  HWREG(m_config.gpioBase + GPIO_O_DIR) |= m_config.gpioPin;
+  HWREG(m_config.gpioBase + GPIO_O_DEN) |= m_config.gpioPin;
+  drive(false);
+  m_state = LINK_RX;
+  m_eot = false;
+  m_lastRxBytes = m_uart.stats().rxBytes;
+  m_lastRxCycle = CycleCounterGet();
+}
+
+void HalfDuplexLink::start(void){
+  setup();
+  m_passThrough = false;
+}
+
+void HalfDuplexLink::passThrough(void){
+  setup();
+  m_passThrough = true;
+}
+
+uint32_t HalfDuplexLink::write(const uint8_t *data, uint32_t len){
+  if(len == 0){
+    return 0;
+  }
+  // The EOT callback armed for the previous write must not release the
+  // driver between drive() and these bytes reaching the FIFO
+  uint32_t masked = CPUcpsid();
+  drive(true);
+  m_state = LINK_TX_DRAIN;
+  m_eot = false;
+  uint32_t n = m_uart.write(data, len);
+  m_uart.notifyTxDone(EndOfTransmission, this);
+  if(!masked){
+    CPUcpsie();
+  }
+  return n;
+}
+
+bool HalfDuplexLink::queueFrame(const uint8_t *data, uint32_t len){
+  if((len == 0) || (len > m_config.bytesPerTurn) ||
+     ((m_frameHead - m_frameTail) >= HALFDUPLEX_MAX_FRAMES) ||
+     (m_store.space() < len)){
+    m_stats.framesRefused++;
+    return false;
+  }
+  m_store.write(data, len);
+  m_frameLen[m_frameHead % HALFDUPLEX_MAX_FRAMES] = (uint16_t)len;
+  m_frameHead++;
+  return true;
+}
+
+// Runs from the UART ISR the moment the last stop bit leaves. With no
+// hold time the driver is released right here rather than a main loop
+// pass later.
+void HalfDuplexLink::EndOfTransmission(void *context){
+  HalfDuplexLink *link = (HalfDuplexLink *)context;
+  uint32_t now = CycleCounterGet();
+  link->m_eotCycle = now;
+  if((link->m_config.guardToRxUs == 0) && (link->m_state == LINK_TX_DRAIN)){
+    link->releaseDriver(now);
+    link->m_state = LINK_RX;
+  }else{
+    link->m_eot = true;
+  }
+}
+
+void HalfDuplexLink::releaseDriver(uint32_t now){
+  drive(false);
+  uint32_t us = (CycleCounterGet() - m_eotCycle) / SysClock_CyclesPerUs();
+  m_stats.txToRxUsLast = us;
+  if(us > m_stats.txToRxUsMax) m_stats.txToRxUsMax = us;
+  m_lastRxCycle = now;                  // restart the quiet-line timer
+  m_lastRxBytes = m_uart.stats().rxBytes;
+}
+
+HalfDuplexLink::Event HalfDuplexLink::nextEvent(uint32_t now){
+  switch(m_state){
+    case LINK_RX: {
+      uint32_t rxBytes = m_uart.stats().rxBytes;
+      if(rxBytes != m_lastRxBytes){
+        m_lastRxBytes = rxBytes;        // other end still talking
+        m_lastRxCycle = now;
+        return EV_NONE;
+      }
+      // bytes someone else left in the TX ring (the bridge) can hold up
+      // a turn; it starts once the first frame fits whole
+      if(!m_passThrough && (m_frameHead != m_frameTail) &&
+         (m_uart.space() >= m_frameLen[m_frameTail % HALFDUPLEX_MAX_FRAMES]) &&
+         ((now - m_lastRxCycle) >= m_config.guardToTxUs * SysClock_CyclesPerUs())){
+        return EV_FRAMES_PENDING;
+      }
+      return EV_NONE;
+    }
+    case LINK_TX_DRAIN:
+      return m_eot ? EV_EOT : EV_NONE;
+    case LINK_GUARD_RX:
+      return ((now - m_eotCycle) >= m_config.guardToRxUs * SysClock_CyclesPerUs())
+             ? EV_GUARD_EXPIRED : EV_NONE;
+  }
+  return EV_NONE;
+}
+
+void HalfDuplexLink::run(Action action, uint32_t now){
+  switch(action){
+    case ACT_SEND_BATCH: {
+      uint8_t chunk[32];
+      uint32_t frames = 0;
+      uint32_t bytes = 0;
+      uint32_t room = m_uart.space();   // only grows while the ISR drains
+      drive(true);
+      uint32_t us = (CycleCounterGet() - m_lastRxCycle) / SysClock_CyclesPerUs();
+      m_stats.rxToTxUsLast = us;
+      if(us > m_stats.rxToTxUsMax) m_stats.rxToTxUsMax = us;
+      while((m_frameHead != m_frameTail) &&
+            (frames < m_config.framesPerTurn)){
+        uint32_t len = m_frameLen[m_frameTail % HALFDUPLEX_MAX_FRAMES];
+        if(((bytes + len) > m_config.bytesPerTurn) || ((bytes + len) > room)){
+          break;                        // the rest waits for the next turn
+        }
+        while(len > 0){
+          uint32_t n = m_store.read(chunk, (len < sizeof(chunk)) ? len : sizeof(chunk));
+          m_uart.write(chunk, n);
+          len -= n;
+        }
+        bytes += m_frameLen[m_frameTail % HALFDUPLEX_MAX_FRAMES];
+        m_frameTail++;
+        frames++;
+      }
+      m_stats.turns++;
+      m_stats.framesSent += frames;
+      m_stats.bytesSent += bytes;
+      m_eot = false;
+      m_uart.notifyTxDone(EndOfTransmission, this);
+      break;
+    }
+    case ACT_HOLD_DRIVER:
+      m_eot = false;                    // guard runs from m_eotCycle
+      break;
+    case ACT_RELEASE_DRIVER:
+      releaseDriver(now);
+      break;
+  }
+}
+
+void HalfDuplexLink::poll(void){
+  // Zero guard times let several transitions fire in one pass
+  for(uint32_t pass = 0; pass < 3; pass++){
+    uint32_t now = CycleCounterGet();
+    Event event = nextEvent(now);
+    if(event == EV_NONE){
+      return;
+    }
+    for(uint32_t i = 0; i < sizeof(Table)/sizeof(Table[0]); i++){
+      if((Table[i].state == m_state) && (Table[i].event == event)){
+        // state must change before the action: sending a batch arms the
+        // EOT callback, which may fire straight away
+        m_state = Table[i].next;
+        run(Table[i].action, now);
+        break;
+      }
+    }
+  }
+}
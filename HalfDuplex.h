@@ -0,0 +1,132 @@
+/*
+ * HalfDuplex.h
+ *
+ *  Turnaround scheduler for a shared half-duplex device link (RS-485 style
+ *  transceiver with DE and /RE tied to one GPIO). Direction changes are
+ *  driven by a transition table: the driver is released from the UART's
+ *  end-of-transmission interrupt as soon as the shift register drains,
+ *  and queued frames are sent in batches so each turn carries as much as
+ *  the configuration allows.
+ *
+ *  In pass-through mode another writer (the bridge) owns the byte stream:
+ *  queued frames wait for start(), and bytes sent with write() drive the
+ *  line for as long as they take.
+ */
+
+#ifndef HALFDUPLEX_H_
+#define HALFDUPLEX_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "RingBuffer.h"
+
+#define HALFDUPLEX_FRAME_STORE 512      // queued outbound bytes, power of two
+#define HALFDUPLEX_MAX_FRAMES  16       // queued outbound frames
+
+struct HalfDuplexConfig {
+  uint32_t gpioBase;                    // port holding the direction pin
+  uint32_t gpioPin;                     // pin mask, high = transmit
+  uint32_t gpioClock;                   // SYSCTL_RCGCGPIO bit for the port
+  uint32_t guardToTxUs;                 // line must be quiet this long before we drive it
+  uint32_t guardToRxUs;                 // hold the driver this long after the last stop bit
+  uint32_t framesPerTurn;               // batch limit per transmit turn
+  uint32_t bytesPerTurn;                // batch limit, at most UART_TX_BUFFER_SIZE
+};
+
+struct HalfDuplexStats {
+  uint32_t turns;                       // transmit turns taken
+  uint32_t framesSent;
+  uint32_t bytesSent;
+  uint32_t framesRefused;               // queueFrame() calls that did not fit
+  uint32_t txToRxUsLast;                // last stop bit out -> receiver enabled
+  uint32_t txToRxUsMax;
+  uint32_t rxToTxUsLast;                // last byte in -> driver enabled
+  uint32_t rxToTxUsMax;
+};
+
+enum HalfDuplexState {LINK_RX, LINK_TX_DRAIN, LINK_GUARD_RX};
+
+class HalfDuplexLink {
+public:
+  HalfDuplexLink(BufferedUART &uart, const HalfDuplexConfig &config);
+
+  //------------start------------
+  // Configure the direction pin and enter receive
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------passThrough------------
+  // Configure the direction pin and enter receive with frame batches
+  // held; send with write() until start() is called again
+  // Input: none
+  // Output: none
+  void passThrough(void);
+
+  //------------write------------
+  // Pass-through send: drive the line, queue the bytes on the UART and
+  // release the driver once they are out, as after a batch
+  // Input: data points to len bytes
+  // Output: number of bytes the UART took
+  uint32_t write(const uint8_t *data, uint32_t len);
+
+  //------------queueFrame------------
+  // Copy a frame into the outbound store; it goes out on a later turn
+  // Input: data points to len bytes (len <= bytesPerTurn)
+  // Output: false if the store is full or the frame is too long
+  bool queueFrame(const uint8_t *data, uint32_t len);
+
+  //------------poll------------
+  // Evaluate the current state's event and fire any matching transition;
+  // call from the main loop. Never blocks.
+  // Input: none
+  // Output: none
+  void poll(void);
+
+  HalfDuplexState state(void) const { return m_state; }
+  bool transmitting(void) const { return m_state != LINK_RX; }
+
+  //------------idle------------
+  // Output: true if the link is only waiting on interrupts (received
+  // bytes or end of transmission), false while a guard timer is running
+  bool idle(void) const {
+    return (m_state == LINK_TX_DRAIN) ||
+           ((m_state == LINK_RX) &&
+            (m_passThrough || (m_frameHead == m_frameTail)));
+  }
+  const HalfDuplexStats &stats(void) const { return m_stats; }
+
+private:
+  enum Event {EV_NONE, EV_FRAMES_PENDING, EV_EOT, EV_GUARD_EXPIRED};
+  enum Action {ACT_SEND_BATCH, ACT_HOLD_DRIVER, ACT_RELEASE_DRIVER};
+  struct Transition {
+    HalfDuplexState state;
+    Event event;
+    HalfDuplexState next;
+    Action action;
+  };
+  static const Transition Table[];
+
+  void setup(void);
+  Event nextEvent(uint32_t now);
+  void run(Action action, uint32_t now);
+  void drive(bool transmit);
+  void releaseDriver(uint32_t now);
+  static void EndOfTransmission(void *context);
+
+  BufferedUART &m_uart;
+  HalfDuplexConfig m_config;
+  HalfDuplexStats m_stats;
+  volatile HalfDuplexState m_state;
+  RingBuffer<HALFDUPLEX_FRAME_STORE> m_store;
+  uint16_t m_frameLen[HALFDUPLEX_MAX_FRAMES];
+  uint32_t m_frameHead;
+  uint32_t m_frameTail;
+  volatile bool m_eot;                  // set by the EOT callback
+  volatile uint32_t m_eotCycle;
+  uint32_t m_lastRxBytes;
+  uint32_t m_lastRxCycle;
+  bool m_passThrough;                   // write() owns the transmitter
+};
+
+#endif /* HALFDUPLEX_H_ */
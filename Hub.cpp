@@ -0,0 +1,129 @@
+/*
+ * Hub.cpp
+ *
+ *  Fan-in of several device UARTs to one framed PC link.
+ */
+
+#include <stdint.h>
+#include "StreamPrint.h"
+#include "Hub.h"
+
+UARTHub::UARTHub(FrameLink &pc)
+  : m_pc(pc), m_devices(0), m_next(0), m_downLen(0), m_downOff(0),
+    m_badFrames(0) {
+  for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+    m_device[i] = 0;
+  }
+}
+
+int32_t UARTHub::attach(BufferedUART &device){
+  if(m_devices == HUB_MAX_DEVICES){
+    return -1;
+  }
+  m_device[m_devices] = &device;
+  return (int32_t)m_devices++;
+}
+
+void UARTHub::start(void){
+  for(uint32_t i = 0; i < m_devices; i++){
+    m_stats[i].bytesUp = 0;
+    m_stats[i].framesUp = 0;
+    m_stats[i].bytesDown = 0;
+    m_stats[i].drops = 0;
+    m_dropBase[i] = m_device[i]->stats().rxOverflow;
+  }
+  m_next = 0;
+  m_downLen = 0;
+  m_downOff = 0;
+  m_badFrames = 0;
+  m_pc.start();
+}
+
+// One frame per device with data, starting where the last pass stopped.
+// A full PC link ends the pass; that device goes first next time.
+uint32_t UARTHub::upstream(void){
+  uint8_t frame[HUB_CHUNK + 1];
+  uint32_t moved = 0;
+
+  for(uint32_t k = 0; k < m_devices; k++){
+    uint32_t id = (m_next + k) % m_devices;
+    BufferedUART &device = *m_device[id];
+    uint32_t n = device.available();
+    if(n == 0){
+      continue;
+    }
+    if(n > HUB_CHUNK){
+      n = HUB_CHUNK;
+    }
+    if(!m_pc.writable(n + 1)){
+      m_next = id;
+      return moved;
+    }
+    frame[0] = (uint8_t)id;
+    n = device.read(&frame[1], n);
+    m_pc.write(frame, n + 1);
+    m_stats[id].bytesUp += n;
+    m_stats[id].framesUp++;
+    m_stats[id].drops = device.stats().rxOverflow - m_dropBase[id];
+    moved += n;
+  }
+  if(m_devices != 0){
+    m_next = (m_next + 1) % m_devices;
+  }
+  return moved;
+}
+
+// Frames are delivered in order; one whose device has no TX room waits
+// here and holds up the frames behind it
+uint32_t UARTHub::downstream(void){
+  uint32_t moved = 0;
+
+  for(;;){
+    if(m_downOff == m_downLen){
+      m_downLen = m_pc.read(m_down, sizeof(m_down));
+      m_downOff = 1;
+      if(m_downLen == 0){
+        m_downOff = 0;
+        return moved;
+      }
+      if(m_down[0] >= m_devices){
+        m_badFrames++;
+        m_downOff = m_downLen;
+        continue;
+      }
+    }
+    // Only offer what fits, so the device's txOverflow stays a count of
+    // real losses
+    uint32_t id = m_down[0];
+    uint32_t n = m_downLen - m_downOff;
+    if(n > m_device[id]->space()){
+      n = m_device[id]->space();
+    }
+    n = m_device[id]->write(&m_down[m_downOff], n);
+    m_downOff += n;
+    m_stats[id].bytesDown += n;
+    moved += n;
+    if(m_downOff != m_downLen){
+      return moved;                     // device TX ring full
+    }
+  }
+}
+
+uint32_t UARTHub::pump(void){
+  return upstream() + downstream();
+}
+
+void UARTHub::report(ByteStream &out) const {
+  for(uint32_t i = 0; i < m_devices; i++){
+    StreamPrint(out, "hub");
+    StreamPrintField(out, "port", i);
+    StreamPrintField(out, "up_bytes", m_stats[i].bytesUp);
+    StreamPrintField(out, "up_frames", m_stats[i].framesUp);
+    StreamPrintField(out, "down_bytes", m_stats[i].bytesDown);
+    StreamPrintField(out, "drops", m_stats[i].drops);
+    StreamPrint(out, "\r\n");
+  }
+  StreamPrint(out, "hub");
+  StreamPrintField(out, "bad_frames", m_badFrames);
+  StreamPrint(out, "\r\n");
+}
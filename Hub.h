@@ -0,0 +1,86 @@
+/*
+ * Hub.h
+ *
+ *  Fan-in of up to seven field devices, each on its own UART, to one PC
+ *  link. Traffic on the PC side is COBS framed (FrameLink); the first
+ *  byte of every frame is the device's port id, the rest is raw device
+ *  data:
+ *    device -> PC  whatever a device sent since its last frame, up to
+ *                  HUB_CHUNK bytes per frame, devices served round robin
+ *    PC -> device  the payload is written to the device's TX ring as is
+ *  A device that floods cannot starve the others: each gets at most one
+ *  frame per pump() while the PC link has room.
+ */
+
+#ifndef HUB_H_
+#define HUB_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "ByteStream.h"
+#include "FrameLink.h"
+
+#define HUB_MAX_DEVICES     7           // UART1..7 with UART0 to the PC
+#define HUB_CHUNK           64          // device bytes per upstream frame
+
+static_assert(HUB_CHUNK + 1 <= FRAME_MAX_PAYLOAD,
+              "an upstream frame must fit the PC link");
+
+struct HubPortStats {
+  uint32_t bytesUp;                     // device bytes sent to the PC
+  uint32_t framesUp;
+  uint32_t bytesDown;                   // PC bytes handed to the device
+  uint32_t drops;                       // device bytes lost, RX ring full
+};
+
+class UARTHub {
+public:
+  explicit UARTHub(FrameLink &pc);
+
+  //------------attach------------
+  // Add a device port; ids are handed out in order from 0
+  // Input: device is an opened port
+  // Output: the device's id on the PC link, or -1 if the hub is full
+  int32_t attach(BufferedUART &device);
+
+  //------------start------------
+  // Zero the statistics and take over the PC link's framing
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------pump------------
+  // Move everything that fits in both directions; call from the main
+  // loop as often as possible. Never blocks.
+  // Input: none
+  // Output: number of payload bytes moved, 0 if the hub is idle
+  uint32_t pump(void);
+
+  uint32_t devices(void) const { return m_devices; }
+  const HubPortStats &stats(uint32_t id) const { return m_stats[id]; }
+  uint32_t badFrames(void) const { return m_badFrames; }
+
+  //------------report------------
+  // Print one "hub port= up_bytes= up_frames= down_bytes= drops=" line
+  // per device and one "hub bad_frames=" line
+  // Input: out is where to print
+  // Output: none
+  void report(ByteStream &out) const;
+
+private:
+  uint32_t upstream(void);
+  uint32_t downstream(void);
+
+  FrameLink &m_pc;
+  BufferedUART *m_device[HUB_MAX_DEVICES];
+  HubPortStats m_stats[HUB_MAX_DEVICES];
+  uint32_t m_dropBase[HUB_MAX_DEVICES];
+  uint32_t m_devices;
+  uint32_t m_next;                      // first device served next pump
+  uint8_t m_down[FRAME_MAX_PAYLOAD];    // PC frame waiting for TX room
+  uint32_t m_downLen;
+  uint32_t m_downOff;
+  uint32_t m_badFrames;                 // PC frames with no such port
+};
+
+#endif /* HUB_H_ */
@@ -0,0 +1,111 @@
+/*
+ * Idle.cpp
+ *
+ *  Tickless WFI/deep-sleep idle for the main loop.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hw_nvic.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "cpu.h"
+#include "StreamPrint.h"
+#include "SysClock.h"
+#include "Timebase.h"
+#include "Idle.h"
+
+static IdleMode Mode = IDLE_RUN;
+static uint32_t SleepHz;                // SysTick clock while asleep
+static ByteStream *Ports[IDLE_MAX_PORTS];
+static uint32_t NumPorts;
+static IdleStats Stats;
+static uint32_t WindowStart;            // Timebase_Micros at the last report
+
+IdleMode Idle_Init(IdleMode mode){
+#ifndef UART_CLOCK_PIOSC
+  if(mode == IDLE_DEEP_SLEEP){
+    mode = IDLE_SLEEP;                  // baud clock would change under the UARTs
+  }
+#endif
+  SleepHz = SysClock_Get();
+  if(mode == IDLE_DEEP_SLEEP){
+    // Deep sleep runs from PIOSC undivided with the PLL off. Only the
+    // modules running now keep their clocks; the UARTs must be able to
+    // receive and wake us, and the GPIOs hold pins such as the
+    // half-duplex direction line.
+    HWREG(SYSCTL_DSLPCLKCFG) = SYSCTL_DSLPCLKCFG_O_IO;
+    HWREG(SYSCTL_DCGCUART) = HWREG(SYSCTL_RCGCUART);
+    HWREG(SYSCTL_DCGCGPIO) = HWREG(SYSCTL_RCGCGPIO);
+    SleepHz = SYSCLOCK_PIOSC_HZ;
+  }
+  Mode = mode;
+  Stats.sleeps = 0;
+  Stats.busy = 0;
+  Stats.sleepUs = 0;
+  Stats.lastSleepUs = 0;
+  Stats.maxSleepUs = 0;
+  WindowStart = Timebase_Micros();
+  return mode;
+}
+
+bool Idle_Watch(ByteStream &port){
+  if(NumPorts >= IDLE_MAX_PORTS){
+    return false;
+  }
+  Ports[NumPorts++] = &port;
+  return true;
+}
+
+bool Idle_Enter(uint32_t maxMs){
+  if(Mode == IDLE_RUN){
+    return false;
+  }
+  uint32_t start = Timebase_Micros();
+  // Mask interrupts so a byte arriving after the check still wakes the
+  // WFI below instead of being serviced in between and slept through
+  CPUcpsid();
+  for(uint32_t i = 0; i < NumPorts; i++){
+    if(Ports[i]->available()){
+      CPUcpsie();
+      Stats.busy++;
+      return false;
+    }
+  }
+  if(Mode == IDLE_DEEP_SLEEP){
+    HWREG(NVIC_SYS_CTRL) |= NVIC_SYS_CTRL_SLEEPDEEP;
+  }
+  Timebase_IdleFor(maxMs, SleepHz);
+  HWREG(NVIC_SYS_CTRL) &= ~NVIC_SYS_CTRL_SLEEPDEEP;
+  CPUcpsie();                           // wakeup source is serviced here
+
+  uint32_t us = Timebase_Micros() - start;
+  Stats.sleeps++;
+  Stats.sleepUs += us;
+  Stats.lastSleepUs = us;
+  if(us > Stats.maxSleepUs) Stats.maxSleepUs = us;
+  return true;
+}
+
+const IdleStats &Idle_Stats(void){
+  return Stats;
+}
+
+void Idle_Report(ByteStream &out){
+  uint32_t now = Timebase_Micros();
+  uint32_t window = now - WindowStart;
+  StreamPrint(out, "idle");
+  StreamPrintField(out, "sleeps", Stats.sleeps);
+  StreamPrintField(out, "busy", Stats.busy);
+  StreamPrintField(out, "sleep_us", Stats.sleepUs);
+  StreamPrintField(out, "max_sleep_us", Stats.maxSleepUs);
+  StreamPrintField(out, "window_us", window);
+  StreamPrintField(out, "sleep_permille",
+                   window ? (uint32_t)(((uint64_t)Stats.sleepUs * 1000) / window) : 0);
+  StreamPrint(out, "\r\n");
+  Stats.sleeps = 0;
+  Stats.busy = 0;
+  Stats.sleepUs = 0;
+  Stats.maxSleepUs = 0;
+  WindowStart = now;
+}
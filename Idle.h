@@ -0,0 +1,65 @@
+/*
+ * Idle.h
+ *
+ *  Low-power idle for the main loop. When none of the watched UARTs has
+ *  received data waiting to be processed, the core sleeps (WFI, or deep
+ *  sleep with unused peripherals clock gated) with SysTick stretched so
+ *  it is not woken every millisecond. A UART RX/RX-timeout interrupt or
+ *  the caller's deadline wakes it.
+ *
+ *  Deep sleep drops the system clock to PIOSC, so it needs the UARTs
+ *  built with UART_CLOCK_PIOSC; otherwise it falls back to WFI sleep.
+ *  uDMA is gated in deep sleep, so DMAUART ports should use IDLE_SLEEP.
+ */
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+#include "ByteStream.h"
+
+#define IDLE_MAX_PORTS  4
+#define IDLE_FOREVER    0xFFFFFFFF      // no deadline, wake on interrupts only
+
+enum IdleMode {IDLE_RUN, IDLE_SLEEP, IDLE_DEEP_SLEEP};
+
+struct IdleStats {
+  uint32_t sleeps;                      // times the core went to sleep
+  uint32_t busy;                        // Idle_Enter calls with data pending
+  uint32_t sleepUs;                     // time asleep this report window
+  uint32_t lastSleepUs;
+  uint32_t maxSleepUs;
+};
+
+//------------Idle_Init------------
+// Select the sleep mode; for deep sleep, keep the running UART and GPIO
+// modules clocked while everything else is gated. Call after the
+// peripherals are set up and Timebase_Init has run.
+// Input: mode, IDLE_RUN never sleeps
+// Output: mode actually in effect
+IdleMode Idle_Init(IdleMode mode);
+
+//------------Idle_Watch------------
+// Add a port whose pending RX data keeps the core awake
+// Input: port to watch
+// Output: false if IDLE_MAX_PORTS are already watched
+bool Idle_Watch(ByteStream &port);
+
+//------------Idle_Enter------------
+// Sleep until an interrupt or maxMs, unless a watched port has data
+// waiting. Call from the main loop once it has nothing else to do.
+// Input: maxMs until the caller's next timer is due, or IDLE_FOREVER
+// Output: true if the core slept
+bool Idle_Enter(uint32_t maxMs);
+
+const IdleStats &Idle_Stats(void);
+
+//------------Idle_Report------------
+// Print "idle sleeps= busy= sleep_us= window_us= sleep_permille=" and
+// start a new window
+// Input: out is the destination
+// Output: none
+void Idle_Report(ByteStream &out);
+
+#endif /* IDLE_H_ */
@@ -0,0 +1,241 @@
+/*
+ * Multidrop.cpp
+ *
+ *  Addressed master/slave transport over a BufferedUART port.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "uart.h"
+#include "Crc.h"
+#include "CycleCount.h"
+#include "SysClock.h"
+#include "Multidrop.h"
+
+#define MULTIDROP_STICK_ZERO (UART_LCRH_PEN | UART_LCRH_EPS | UART_LCRH_SPS)
+
+MultidropNode::MultidropNode(BufferedUART &uart, uint8_t address,
+                             MultidropAddressing mode)
+  : m_uart(uart), m_address(address), m_mode(mode), m_frameLen(0),
+    m_frameReady(false), m_rxState(RX_ADDRESS), m_rxKeep(false),
+    m_rxOurs(false), m_rxCount(0), m_rxCrc(0), m_rxCheck(0) {
+  m_stats.framesIn = 0;
+  m_stats.framesOut = 0;
+  m_stats.foreign = 0;
+  m_stats.crcErrors = 0;
+  m_stats.oversize = 0;
+  m_stats.dropped = 0;
+  m_stats.timeouts = 0;
+}
+
+void MultidropNode::start(void){
+  uint32_t base = m_uart.base();
+
+  m_rxState = RX_ADDRESS;
+  m_frameReady = false;
+  if(m_mode == MULTIDROP_9BIT){
+    // Data characters go out with a 0 ninth bit (stick parity);
+    // UART9BitAddrSend flips it for the address character
+    HWREG(base + UART_O_LCRH) |= MULTIDROP_STICK_ZERO;
+    UART9BitAddrSet(base, m_address, 0xFF);     // clears 9BITEN too
+    UART9BitEnable(base);
+  }
+  m_uart.setRxHook(RxByte, this);
+}
+
+void MultidropNode::stop(void){
+  uint32_t base = m_uart.base();
+
+  m_uart.setRxHook(0, 0);
+  if(m_mode == MULTIDROP_9BIT){
+    UART9BitDisable(base);
+    HWREG(base + UART_O_LCRH) &= ~MULTIDROP_STICK_ZERO;
+  }
+}
+
+// RX ISR context. Only frames for this node are checked and copied;
+// the others are skipped by their length byte, which in 9-bit mode
+// never happens since the UART does not pass them on.
+void MultidropNode::RxByte(void *context, uint8_t data){
+  MultidropNode *node = (MultidropNode *)context;
+
+  switch(node->m_rxState){
+    case RX_ADDRESS:
+      node->m_rxOurs = (data == node->m_address);
+      node->m_rxKeep = node->m_rxOurs && !node->m_frameReady;
+      node->m_rxCrc = Crc16_Update(CRC16_INIT, data);
+      node->m_rxState = RX_LENGTH;
+      break;
+    case RX_LENGTH:
+      if(data > MULTIDROP_MAX_PAYLOAD){
+        node->m_stats.oversize++;
+        node->m_rxState = RX_ADDRESS;
+        break;
+      }
+      node->m_rxCount = data;
+      if(node->m_rxKeep){
+        node->m_frameLen = data;
+      }
+      node->m_rxCrc = Crc16_Update(node->m_rxCrc, data);
+      node->m_rxState = (data != 0) ? RX_DATA : RX_CRC_HI;
+      break;
+    case RX_DATA:
+      if(node->m_rxKeep){
+        node->m_frame[node->m_frameLen - node->m_rxCount] = data;
+      }
+      if(node->m_rxOurs){
+        node->m_rxCrc = Crc16_Update(node->m_rxCrc, data);
+      }
+      if(--node->m_rxCount == 0){
+        node->m_rxState = RX_CRC_HI;
+      }
+      break;
+    case RX_CRC_HI:
+      node->m_rxCheck = (uint16_t)(data << 8);
+      node->m_rxState = RX_CRC_LO;
+      break;
+    case RX_CRC_LO:
+      node->endFrame((uint16_t)(node->m_rxCheck | data));
+      break;
+  }
+}
+
+void MultidropNode::endFrame(uint16_t check){
+  m_rxState = RX_ADDRESS;
+  if(!m_rxOurs){
+    m_stats.foreign++;
+  }else if(check != Crc16_Final(m_rxCrc)){
+    m_stats.crcErrors++;
+  }else if(!m_rxKeep){
+    m_stats.dropped++;
+  }else{
+    m_stats.framesIn++;
+    m_frameReady = true;                // publish after the data
+  }
+}
+
+bool MultidropNode::sendFrame(uint8_t to, const uint8_t *data, uint32_t len){
+  if((len > MULTIDROP_MAX_PAYLOAD) ||
+     (m_uart.space() < len + MULTIDROP_OVERHEAD)){
+    return false;
+  }
+  uint16_t crc = Crc16_Update(CRC16_INIT, to);
+  uint32_t n = 0;
+  if(m_mode == MULTIDROP_9BIT){
+    // The address character needs its own LCRH setting, so it cannot
+    // share the FIFO with data of the previous frame; rather than wait
+    // for that to drain, let the caller try again on its next poll
+    if(!m_uart.txIdle() || UARTBusy(m_uart.base())){
+      return false;
+    }
+    UART9BitAddrSend(m_uart.base(), to);
+  }else{
+    m_uart.txPoke(n++, to);
+  }
+  crc = Crc16_Update(crc, (uint8_t)len);
+  m_uart.txPoke(n++, (uint8_t)len);
+  for(uint32_t i = 0; i < len; i++){
+    crc = Crc16_Update(crc, data[i]);
+    m_uart.txPoke(n++, data[i]);
+  }
+  crc = Crc16_Final(crc);
+  m_uart.txPoke(n++, (uint8_t)(crc >> 8));
+  m_uart.txPoke(n++, (uint8_t)crc);
+  m_uart.txCommit(n);
+  m_stats.framesOut++;
+  return true;
+}
+
+MultidropMaster::MultidropMaster(BufferedUART &uart, MultidropAddressing mode)
+  : MultidropNode(uart, MULTIDROP_MASTER, mode), m_count(0), m_next(0),
+    m_current(0), m_waiting(false), m_sentCycle(0),
+    m_timeoutUs(MULTIDROP_TIMEOUT_US), m_polls(0), m_handler(0),
+    m_context(0) {
+}
+
+bool MultidropMaster::attach(uint8_t address){
+  if((m_count >= MULTIDROP_MAX_SLAVES) || (address == MULTIDROP_MASTER) ||
+     (address == 0xFF)){
+    return false;
+  }
+  m_slaves[m_count].address = address;
+  m_slaves[m_count].len = 0;
+  m_slaves[m_count].queued = false;
+  m_count++;
+  return true;
+}
+
+bool MultidropMaster::queue(uint8_t address, const uint8_t *data,
+                            uint32_t len){
+  if(len > MULTIDROP_MAX_PAYLOAD){
+    return false;
+  }
+  for(uint32_t i = 0; i < m_count; i++){
+    if(m_slaves[i].address == address){
+      memcpy(m_slaves[i].data, data, len);
+      m_slaves[i].len = (uint8_t)len;
+      m_slaves[i].queued = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+void MultidropMaster::poll(void){
+  if(m_waiting){
+    if(m_frameReady){
+      if(m_handler){
+        m_handler(m_context, m_slaves[m_current].address, m_frame,
+                  m_frameLen);
+      }
+      m_frameReady = false;
+      m_waiting = false;
+    }else if((CycleCounterGet() - m_sentCycle) >=
+             m_timeoutUs * SysClock_CyclesPerUs()){
+      m_stats.timeouts++;
+      m_waiting = false;
+    }else{
+      return;
+    }
+  }
+  if(m_count == 0){
+    return;
+  }
+  Slave &slave = m_slaves[m_next];
+  m_frameReady = false;                 // a late reply to the last poll
+  if(!sendFrame(slave.address, slave.data, slave.queued ? slave.len : 0)){
+    return;
+  }
+  slave.queued = false;
+  m_current = m_next;
+  m_next = (m_next + 1) % m_count;
+  m_sentCycle = CycleCounterGet();
+  m_waiting = true;
+  m_polls++;
+}
+
+MultidropSlave::MultidropSlave(BufferedUART &uart, uint8_t address,
+                               MultidropAddressing mode)
+  : MultidropNode(uart, address, mode), m_handler(0), m_context(0),
+    m_replyLen(0), m_replyPending(false) {
+}
+
+bool MultidropSlave::service(void){
+  if(!m_replyPending){
+    if(!m_frameReady){
+      return false;
+    }
+    m_replyLen = m_handler ? m_handler(m_context, m_frame, m_frameLen,
+                                       m_reply)
+                           : 0;
+    m_frameReady = false;
+    m_replyPending = true;
+  }
+  if(!sendFrame(MULTIDROP_MASTER, m_reply, m_replyLen)){
+    return false;                       // line busy, next call retries
+  }
+  m_replyPending = false;
+  return true;
+}
@@ -0,0 +1,207 @@
+/*
+ * Multidrop.h
+ *
+ *  Master/slave transport for one master and up to MULTIDROP_MAX_SLAVES
+ *  slaves sharing a bus (RS-485 pair). Every frame starts with the
+ *  address of the node it is for:
+ *
+ *    address | length | payload (length bytes) | CRC-16 hi | CRC-16 lo
+ *
+ *  with the CRC-16-CCITT of address, length and payload. The master
+ *  polls the slaves in turn and each slave answers its poll with a frame
+ *  to MULTIDROP_MASTER, so only one node drives the bus at a time.
+ *
+ *  In MULTIDROP_9BIT mode the address goes out as a 9-bit address
+ *  character (UART9BitAddrSend) and every node's UART matches it against
+ *  its own address in hardware: a slave's UART drops foreign frames, so
+ *  its ISR never runs for traffic addressed elsewhere. MULTIDROP_SOFTWARE
+ *  sends the address as a plain byte; every node then takes every byte
+ *  and follows each frame's length to find the next address.
+ *
+ *  Frames are decoded in the RX ISR through the port's RX hook; requests
+ *  and replies are handled from the main loop. Direction control is left
+ *  to the transceiver (auto-direction RS-485 parts); HalfDuplexLink is
+ *  not used here.
+ *
+ *  Usage, device link on UART1:
+ *    MultidropMaster bus(UART1_Buffered);
+ *    bus.attach(1); bus.attach(2); bus.setReplyHandler(OnReply, 0);
+ *    bus.start();
+ *    for(;;){ bus.poll(); ... }
+ */
+
+#ifndef MULTIDROP_H_
+#define MULTIDROP_H_
+
+#include <stdint.h>
+#include "BufferedUART.h"
+
+#define MULTIDROP_MAX_PAYLOAD   32
+#define MULTIDROP_MAX_SLAVES    8
+#define MULTIDROP_MASTER        0x00    // slaves use 1-254
+#define MULTIDROP_OVERHEAD      4       // address, length, CRC
+#define MULTIDROP_TIMEOUT_US    2000    // default reply timeout
+
+enum MultidropAddressing {
+  MULTIDROP_9BIT,                       // hardware address match
+  MULTIDROP_SOFTWARE                    // every node parses every frame
+};
+
+struct MultidropStats {
+  uint32_t framesIn;                    // good frames for this node
+  uint32_t framesOut;
+  uint32_t foreign;                     // frames skipped for other nodes
+  uint32_t crcErrors;
+  uint32_t oversize;                    // length byte over the maximum
+  uint32_t dropped;                     // ours, but the last one was unread
+  uint32_t timeouts;                    // master: polls left unanswered
+};
+
+// Master: called from poll() with each reply, empty ones included
+typedef void (*MultidropReplyHandler)(void *context, uint8_t address,
+                                      const uint8_t *data, uint32_t len);
+
+// Slave: called from service() with each request, empty polls included;
+// fills reply (MULTIDROP_MAX_PAYLOAD bytes) and returns its length
+typedef uint32_t (*MultidropRequestHandler)(void *context,
+                                            const uint8_t *data,
+                                            uint32_t len, uint8_t *reply);
+
+class MultidropNode {
+public:
+  //------------start------------
+  // Switch the port to the addressing mode (for MULTIDROP_9BIT, 9-bit
+  // characters matched against this node's address) and take over its
+  // RX path
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------stop------------
+  // Back to 8N1 with the RX path returned to the port's ring
+  // Input: none
+  // Output: none
+  void stop(void);
+
+  uint8_t address(void) const { return m_address; }
+  const MultidropStats &stats(void) const { return m_stats; }
+
+protected:
+  MultidropNode(BufferedUART &uart, uint8_t address,
+                MultidropAddressing mode);
+
+  //------------sendFrame------------
+  // Queue a whole frame; in 9-bit mode the transmitter has to be idle
+  // and the call waits for the address character (one character time)
+  // Input: to is the destination, data points to len bytes
+  // Output: false if the frame is too long, the TX ring lacks room or,
+  // in 9-bit mode, the previous frame is still going out
+  bool sendFrame(uint8_t to, const uint8_t *data, uint32_t len);
+
+  BufferedUART &m_uart;
+  uint8_t m_address;
+  MultidropAddressing m_mode;
+  MultidropStats m_stats;
+  uint8_t m_frame[MULTIDROP_MAX_PAYLOAD];
+  uint32_t m_frameLen;
+  volatile bool m_frameReady;           // set by the ISR, cleared by main
+
+private:
+  enum RxState {RX_ADDRESS, RX_LENGTH, RX_DATA, RX_CRC_HI, RX_CRC_LO};
+
+  static void RxByte(void *context, uint8_t data);
+  void endFrame(uint16_t check);
+
+  RxState m_rxState;
+  bool m_rxKeep;                        // frame is ours and has a slot
+  bool m_rxOurs;
+  uint8_t m_rxCount;                    // payload bytes still to come
+  uint16_t m_rxCrc;
+  uint16_t m_rxCheck;
+};
+
+class MultidropMaster : public MultidropNode {
+public:
+  MultidropMaster(BufferedUART &uart,
+                  MultidropAddressing mode = MULTIDROP_9BIT);
+
+  //------------attach------------
+  // Add a slave to the polling round
+  // Input: address 1-254
+  // Output: false if the table is full or the address is reserved
+  bool attach(uint8_t address);
+
+  //------------queue------------
+  // Payload for the next poll of a slave, replacing any not yet sent;
+  // slaves with nothing queued get an empty poll
+  // Input: address of an attached slave, data points to len bytes
+  // Output: false if the slave is unknown or len is too long
+  bool queue(uint8_t address, const uint8_t *data, uint32_t len);
+
+  void setReplyHandler(MultidropReplyHandler handler, void *context){
+    m_handler = handler;
+    m_context = context;
+  }
+  void setTimeout(uint32_t us){ m_timeoutUs = us; }
+
+  //------------poll------------
+  // Scheduler step for the main loop: deliver a reply or expire the
+  // outstanding poll, then poll the next slave round robin. The timeout
+  // runs from when the poll is queued, so it has to cover both frames'
+  // time on the line. Blocks only for the address character in 9-bit
+  // mode.
+  // Input: none
+  // Output: none
+  void poll(void);
+
+  //------------idle------------
+  // Output: true if no poll is outstanding
+  bool idle(void) const { return !m_waiting; }
+  uint32_t polls(void) const { return m_polls; }
+
+private:
+  struct Slave {
+    uint8_t address;
+    uint8_t len;                        // queued payload length
+    bool queued;
+    uint8_t data[MULTIDROP_MAX_PAYLOAD];
+  };
+
+  Slave m_slaves[MULTIDROP_MAX_SLAVES];
+  uint32_t m_count;
+  uint32_t m_next;                      // slave to poll next
+  uint32_t m_current;                   // slave polled, while m_waiting
+  bool m_waiting;
+  uint32_t m_sentCycle;
+  uint32_t m_timeoutUs;
+  uint32_t m_polls;
+  MultidropReplyHandler m_handler;
+  void *m_context;
+};
+
+class MultidropSlave : public MultidropNode {
+public:
+  MultidropSlave(BufferedUART &uart, uint8_t address,
+                 MultidropAddressing mode = MULTIDROP_9BIT);
+
+  void setRequestHandler(MultidropRequestHandler handler, void *context){
+    m_handler = handler;
+    m_context = context;
+  }
+
+  //------------service------------
+  // Answer a received poll; call from the main loop. A reply that
+  // cannot be queued yet is kept and retried on the next call.
+  // Input: none
+  // Output: true if a reply was sent
+  bool service(void);
+
+private:
+  MultidropRequestHandler m_handler;
+  void *m_context;
+  uint8_t m_reply[MULTIDROP_MAX_PAYLOAD];
+  uint32_t m_replyLen;
+  bool m_replyPending;                  // handler ran, reply not queued
+};
+
+#endif /* MULTIDROP_H_ */
@@ -0,0 +1,32 @@
+/*
+ * PolledUART.cpp
+ *
+ *  ByteStream over the bare hardware FIFOs.
+ */
+
+#include <stdint.h>
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "PolledUART.h"
+
+uint32_t PolledUART::read(uint8_t *data, uint32_t len){
+    uint32_t n = 0;
+    while((n < len) && ((HWREG(m_base + UART_O_FR) & UART_FR_RXFE) == 0)){
+        data[n++] = (uint8_t)(HWREG(m_base + UART_O_DR) & UART_DR_DATA_M);
+    }
+    return n;
+}
+
+uint32_t PolledUART::write(const uint8_t *data, uint32_t len){
+    uint32_t n = 0;
+    while((n < len) && ((HWREG(m_base + UART_O_FR) & UART_FR_TXFF) == 0)){
+        HWREG(m_base + UART_O_DR) = data[n++];
+    }
+    return n;
+}
+
+// The flag register only says empty/non-empty, so at most one byte can
+// be promised without draining the FIFO
+uint32_t PolledUART::available(void) const {
+    return (HWREG(m_base + UART_O_FR) & UART_FR_RXFE) ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+/*
+ * PolledUART.h
+ *
+ *  ByteStream over the bare hardware FIFOs: no interrupts, no buffering.
+ *  read()/write() move only what the 16-byte FIFOs can hold right now.
+ */
+
+#ifndef POLLEDUART_H_
+#define POLLEDUART_H_
+
+#include <stdint.h>
+#include "ByteStream.h"
+
+class PolledUART : public ByteStream {
+public:
+    explicit PolledUART(uint32_t base) : m_base(base) {}
+
+    uint32_t read(uint8_t *data, uint32_t len) override;
+    uint32_t write(const uint8_t *data, uint32_t len) override;
+    uint32_t available(void) const override;
+    uint32_t base(void) const { return m_base; }
+
+private:
+    uint32_t m_base;
+};
+
+#endif /* POLLEDUART_H_ */
@@ -0,0 +1,91 @@
+/*
+ * Profile.cpp
+ *
+ *  DWT cycle counter profiler: site table, aggregation and report.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cpu.h"
+#include "CycleCount.h"
+#include "StreamPrint.h"
+#include "Profile.h"
+
+static ProfileSite *Sites[PROFILE_MAX_SITES];
+static uint32_t NumSites;
+static uint32_t Overhead;               // cycles of an empty ProfileScope
+
+static void Clear(ProfileSite &site){
+  site.count = 0;
+  site.min = 0xFFFFFFFF;
+  site.max = 0;
+  site.total = 0;
+  for(uint32_t i = 0; i < PROFILE_HIST_BUCKETS; i++){
+    site.hist[i] = 0;
+  }
+}
+
+static uint32_t Bucket(uint32_t cycles){
+  uint32_t b = 0;
+  cycles >>= PROFILE_HIST_MIN_LOG2;
+  while(cycles && (b < PROFILE_HIST_BUCKETS - 1)){
+    cycles >>= 1;
+    b++;
+  }
+  return b;
+}
+
+void Profile_Init(void){
+  CycleCounterInit();
+  uint32_t start = CycleCounterGet();
+  Overhead = CycleCounterGet() - start;
+}
+
+void Profile_Record(ProfileSite &site, uint32_t cycles){
+  if(!site.registered){
+    uint32_t masked = CPUcpsid();
+    if(!site.registered && (NumSites < PROFILE_MAX_SITES)){
+      Clear(site);
+      Sites[NumSites++] = &site;
+      site.registered = true;
+    }
+    if(!masked){
+      CPUcpsie();
+    }
+    if(!site.registered){
+      return;                           // table full, site is dropped
+    }
+  }
+  cycles = (cycles > Overhead) ? cycles - Overhead : 0;
+  site.count++;
+  site.total += cycles;
+  if(cycles < site.min) site.min = cycles;
+  if(cycles > site.max) site.max = cycles;
+  site.hist[Bucket(cycles)]++;
+}
+
+void Profile_Reset(void){
+  for(uint32_t i = 0; i < NumSites; i++){
+    Clear(*Sites[i]);
+  }
+}
+
+void Profile_Report(ByteStream &out){
+  for(uint32_t i = 0; i < NumSites; i++){
+    const ProfileSite &site = *Sites[i];
+    StreamPrint(out, "prof site=");
+    StreamPrint(out, site.name);
+    StreamPrintField(out, "n", site.count);
+    StreamPrintField(out, "min", site.count ? site.min : 0);
+    StreamPrintField(out, "max", site.max);
+    StreamPrintField(out, "mean", site.count ? (uint32_t)(site.total / site.count) : 0);
+    StreamPrint(out, " hist=");
+    for(uint32_t b = 0; b < PROFILE_HIST_BUCKETS; b++){
+      if(b != 0){
+        StreamPrint(out, "/");
+      }
+      StreamPrintUDec(out, site.hist[b]);
+    }
+    StreamPrint(out, "\r\n");
+  }
+}
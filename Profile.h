@@ -0,0 +1,85 @@
+/*
+ * Profile.h
+ *
+ *  Cycle accurate timing of hot paths with the DWT cycle counter. Each
+ *  PROFILE_SCOPE site is a static record (count, min/max/mean and a
+ *  log2 histogram of cycles) that links itself into a fixed table the
+ *  first time it runs. Build with PROFILE_ENABLE to turn the sites on;
+ *  otherwise they compile to nothing.
+ *
+ *  Under HOST_SIM the counter is a plain simulated register, so host
+ *  code can drive it with HWREG(DWT_BASE + DWT_O_CYCCNT) = n and check
+ *  the aggregation.
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ByteStream.h"
+#include "CycleCount.h"
+
+#define PROFILE_MAX_SITES       16
+#define PROFILE_HIST_BUCKETS    8       // <16, <32, ... <1024, >=1024 cycles
+#define PROFILE_HIST_MIN_LOG2   4       // upper bound of bucket 0 is 2^4
+
+struct ProfileSite {
+  const char *name;
+  bool registered;                      // linked into the site table
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+  uint32_t hist[PROFILE_HIST_BUCKETS];
+};
+
+//------------Profile_Init------------
+// Start the cycle counter and measure the cost of an empty scope, which
+// is subtracted from every sample
+// Input: none
+// Output: none
+void Profile_Init(void);
+
+//------------Profile_Record------------
+// Add one sample to a site, registering it on first use. Safe from ISRs;
+// a site should only be recorded from one priority level.
+// Input: site, cycles measured including the counter read overhead
+// Output: none
+void Profile_Record(ProfileSite &site, uint32_t cycles);
+
+//------------Profile_Reset------------
+// Clear the statistics of every registered site
+// Input: none
+// Output: none
+void Profile_Reset(void);
+
+//------------Profile_Report------------
+// Print one "prof site= n= min= max= mean= hist=a/b/..." line per site
+// Input: out is the destination
+// Output: none
+void Profile_Report(ByteStream &out);
+
+// Times the enclosing block into its site
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileSite &site)
+    : m_site(site), m_start(CycleCounterGet()) {}
+  ~ProfileScope(void){ Profile_Record(m_site, CycleCounterGet() - m_start); }
+private:
+  ProfileSite &m_site;
+  uint32_t m_start;
+};
+
+#define PROFILE_CAT2(a, b) a##b
+#define PROFILE_CAT(a, b) PROFILE_CAT2(a, b)
+
+#ifdef PROFILE_ENABLE
+#define PROFILE_SCOPE(label)                                                  \
+  static ProfileSite PROFILE_CAT(ProfileSite_, __LINE__) = {label, false};    \
+  ProfileScope PROFILE_CAT(ProfileScope_, __LINE__)(PROFILE_CAT(ProfileSite_, __LINE__))
+#else
+#define PROFILE_SCOPE(label)
+#endif
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,131 @@
+/*
+ * RingBuffer.h
+ *
+ *  Single-producer/single-consumer byte queue shared between an ISR and
+ *  the main loop. The size must be a power of two so the free running
+ *  head/tail counters can be masked instead of wrapped.
+ */
+
+#ifndef RINGBUFFER_H_
+#define RINGBUFFER_H_
+
+#include <stdint.h>
+
+template <uint32_t SIZE>
+class RingBuffer {
+public:
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0,
+                  "RingBuffer size must be a power of two");
+
+    RingBuffer(void) : m_head(0), m_tail(0) {}
+
+    //------------put------------
+    // Append one byte (producer side only)
+    // Input: data is the byte to queue
+    // Output: true if queued, false if the buffer was full
+    bool put(uint8_t data){
+        uint32_t head = m_head;
+        if((head - m_tail) >= SIZE){
+            return false;
+        }
+        m_data[head & (SIZE - 1)] = data;
+        m_head = head + 1;              // publish after the data is stored
+        return true;
+    }
+
+    //------------get------------
+    // Remove one byte (consumer side only)
+    // Input: data receives the oldest byte
+    // Output: true if a byte was removed, false if the buffer was empty
+    bool get(uint8_t &data){
+        uint32_t tail = m_tail;
+        if(tail == m_head){
+            return false;
+        }
+        data = m_data[tail & (SIZE - 1)];
+        m_tail = tail + 1;              // release the slot after the read
+        return true;
+    }
+
+    //------------write------------
+    // Append as many bytes as fit (producer side only)
+    // Input: data points to len bytes to queue
+    // Output: number of bytes actually queued
+    uint32_t write(const uint8_t *data, uint32_t len){
+        uint32_t head = m_head;
+        uint32_t room = SIZE - (head - m_tail);
+        if(len > room){
+            len = room;
+        }
+        for(uint32_t i = 0; i < len; i++){
+            m_data[(head + i) & (SIZE - 1)] = data[i];
+        }
+        m_head = head + len;
+        return len;
+    }
+
+    //------------read------------
+    // Remove up to len bytes (consumer side only)
+    // Input: data receives up to len bytes
+    // Output: number of bytes actually removed
+    uint32_t read(uint8_t *data, uint32_t len){
+        uint32_t tail = m_tail;
+        uint32_t used = m_head - tail;
+        if(len > used){
+            len = used;
+        }
+        for(uint32_t i = 0; i < len; i++){
+            data[i] = m_data[(tail + i) & (SIZE - 1)];
+        }
+        m_tail = tail + len;
+        return len;
+    }
+
+    //------------discard------------
+    // Drop up to len of the oldest bytes (consumer side only)
+    // Input: len bytes to drop
+    // Output: number of bytes actually dropped
+    uint32_t discard(uint32_t len){
+        uint32_t tail = m_tail;
+        uint32_t used = m_head - tail;
+        if(len > used){
+            len = used;
+        }
+        m_tail = tail + len;
+        return len;
+    }
+
+    //------------poke------------
+    // Stage a byte past the head without publishing it, so a producer
+    // can build a message in place, filling bytes in any order
+    // Input: offset from the head (must be below space()), data byte
+    // Output: none
+    void poke(uint32_t offset, uint8_t data){
+        m_data[(m_head + offset) & (SIZE - 1)] = data;
+    }
+
+    //------------commit------------
+    // Publish the first len staged bytes in one step
+    // Input: len bytes, at most space()
+    // Output: none
+    void commit(uint32_t len){
+        m_head = m_head + len;
+    }
+
+    uint32_t count(void) const { return m_head - m_tail; }
+    uint32_t space(void) const { return SIZE - (m_head - m_tail); }
+    bool empty(void) const { return m_head == m_tail; }
+    bool full(void) const { return (m_head - m_tail) >= SIZE; }
+    static uint32_t capacity(void) { return SIZE; }
+
+private:
+    // Each index has exactly one writer, and every access is a single
+    // aligned 32-bit load or store, so no locking is needed on the M4.
+    // The data array is volatile too so the compiler cannot sink a data
+    // store below the index store that publishes it.
+    volatile uint32_t m_head;           // written by the producer only
+    volatile uint32_t m_tail;           // written by the consumer only
+    volatile uint8_t m_data[SIZE];
+};
+
+#endif /* RINGBUFFER_H_ */
@@ -0,0 +1,208 @@
+/*
+ * SelfTest.cpp
+ *
+ *  Loopback line self-test and max-rate characterization.
+ */
+
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "uart.h"
+#include "AutoBaud.h"
+#include "BaudRate.h"
+#include "CycleCount.h"
+#include "StreamPrint.h"
+#include "SysClock.h"
+#include "SelfTest.h"
+
+#define SELFTEST_CHUNK      64          // bytes read back per call
+#define SELFTEST_QUIET      32          // idle frame times that end a drain
+
+static const char *const ModeName[] = {"polled", "irq", "dma"};
+
+static SelfTestResult Results[SELFTEST_RESULTS];
+static uint8_t Pattern[SELFTEST_BYTES]; // static: a DMA source
+static uint16_t Prbs = 1;               // PRBS-15 state, runs on across rates
+
+static void (*DriverIsr)(void);
+static uint32_t IsrCycles;
+
+// Stands in for the driver's vector while a rate runs, to time its ISR
+static void TimedIsr(void){
+  uint32_t start = CycleCounterGet();
+  DriverIsr();
+  IsrCycles += CycleCounterGet() - start;
+}
+
+// x^15 + x^14 + 1, eight steps per byte
+static uint8_t PrbsByte(void){
+  uint8_t data = 0;
+  for(uint32_t i = 0; i < 8; i++){
+    uint16_t bit = ((Prbs >> 14) ^ (Prbs >> 13)) & 1;
+    Prbs = (uint16_t)(((Prbs << 1) | bit) & 0x7FFF);
+    data = (uint8_t)((data << 1) | bit);
+  }
+  return data;
+}
+
+static uint32_t BaudClock(uint32_t base){
+  return (UARTClockSourceGet(base) == UART_CLOCK_PIOSC) ? SYSCLOCK_PIOSC_HZ :
+                                                          SysClock_Get();
+}
+
+// Read and drop whatever is still arriving
+static void Drain(ByteStream &port, uint32_t frameCycles){
+  uint8_t data[SELFTEST_CHUNK];
+  uint32_t quiet = CycleCounterGet();
+  while(CycleCounterGet() - quiet < SELFTEST_QUIET * frameCycles){
+    if(port.read(data, sizeof(data)) != 0){
+      quiet = CycleCounterGet();
+    }
+  }
+}
+
+//------------LoopRate------------
+// Send the next SELFTEST_BYTES of the pattern and check them coming back
+// Input: port, frameCycles of one character at the rate under test,
+//        cycles receives the time spent in the driver's calls
+// Output: bytes wrong or missing
+static uint32_t LoopRate(ByteStream &port, uint32_t frameCycles,
+                         uint32_t *cycles){
+  uint8_t data[SELFTEST_CHUNK];
+  uint32_t sent = 0;
+  uint32_t got = 0;
+  uint32_t errors = 0;
+  uint32_t driver = 0;
+
+  for(uint32_t i = 0; i < SELFTEST_BYTES; i++){
+    Pattern[i] = PrbsByte();
+  }
+  // the line takes SELFTEST_BYTES frames; four times that is a stall
+  uint32_t limit = 4 * SELFTEST_BYTES * frameCycles;
+  uint32_t start = CycleCounterGet();
+  while(got < SELFTEST_BYTES){
+    uint32_t t = CycleCounterGet();
+    if(sent < SELFTEST_BYTES){
+      sent += port.write(&Pattern[sent], SELFTEST_BYTES - sent);
+    }
+    uint32_t n = port.read(data, sizeof(data));
+    driver += CycleCounterGet() - t;
+    for(uint32_t i = 0; i < n; i++){
+      // a dropped byte shifts the rest, which then counts against it too
+      if((got >= SELFTEST_BYTES) || (data[i] != Pattern[got])){
+        errors++;
+      }
+      got++;
+    }
+    if(CycleCounterGet() - start > limit){
+      errors += SELFTEST_BYTES - got;
+      break;
+    }
+  }
+  *cycles = driver;
+  return errors;
+}
+
+const SelfTestResult *SelfTest_Run(ByteStream &port, uint32_t base,
+                                   SelfTestMode mode, void (*handler)(void)){
+  SelfTestResult *result = 0;
+  for(uint32_t i = 0; (i < SELFTEST_RESULTS) && (result == 0); i++){
+    if(((Results[i].base == base) && (Results[i].mode == mode)) ||
+       (Results[i].base == 0)){
+      result = &Results[i];
+    }
+  }
+  if(result == 0){
+    return 0;
+  }
+  result->base = base;
+  result->mode = mode;
+  result->maxBaud = 0;
+  result->cycPerByte = 0;
+  result->failBaud = 0;
+  result->errors = 0;
+  result->rates = 0;
+
+  uint32_t clock = BaudClock(base);
+  uint32_t ibrd = HWREG(base + UART_O_IBRD);
+  uint32_t fbrd = HWREG(base + UART_O_FBRD);
+  uint32_t lcrh = HWREG(base + UART_O_LCRH);
+  uint32_t ctl = HWREG(base + UART_O_CTL);
+  uint32_t frameCycles = 0;
+  if(handler){
+    DriverIsr = handler;
+    UARTIntRegister(base, TimedIsr);
+  }
+
+  for(uint32_t r = 0; r < AUTOBAUD_RATES; r++){
+    uint32_t baud = AutoBaud_Ladder[r];
+    if((baud > BaudCalc::maxBaud(clock)) ||
+       (BaudCalc::errorPpm(clock, baud) > BAUD_MAX_ERROR_PPM)){
+      break;
+    }
+    UARTConfigSetExpClk(base, clock, baud, UART_CONFIG_WLEN_8 |
+                        UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+    UARTLoopbackEnable(base);
+    frameCycles = (SysClock_Get() / baud) * 10 + 1;
+    IsrCycles = 0;
+    uint32_t cycles;
+    uint32_t errors = LoopRate(port, frameCycles, &cycles);
+    result->rates++;
+    if(errors){
+      result->failBaud = baud;
+      result->errors = errors;
+      Drain(port, frameCycles);
+      break;
+    }
+    result->maxBaud = baud;
+    result->cycPerByte = (cycles + IsrCycles) / SELFTEST_BYTES;
+  }
+
+  // Back to the port's own rate with the loopback off; a write to LCRH
+  // latches the divisors
+  while(UARTBusy(base));
+  HWREG(base + UART_O_CTL) &= ~UART_CTL_UARTEN;
+  HWREG(base + UART_O_IBRD) = ibrd;
+  HWREG(base + UART_O_FBRD) = fbrd;
+  HWREG(base + UART_O_LCRH) = lcrh;
+  HWREG(base + UART_O_CTL) = ctl;
+  if(handler){
+    UARTIntRegister(base, handler);
+  }
+  return result;
+}
+
+const SelfTestResult *SelfTest_Best(uint32_t base){
+  const SelfTestResult *best = 0;
+  for(uint32_t i = 0; i < SELFTEST_RESULTS; i++){
+    const SelfTestResult *r = &Results[i];
+    if((r->base != base) || (r->maxBaud == 0)){
+      continue;
+    }
+    if((best == 0) || (r->maxBaud > best->maxBaud) ||
+       ((r->maxBaud == best->maxBaud) && (r->cycPerByte < best->cycPerByte))){
+      best = r;
+    }
+  }
+  return best;
+}
+
+void SelfTest_Report(ByteStream &out){
+  for(uint32_t i = 0; i < SELFTEST_RESULTS; i++){
+    const SelfTestResult &r = Results[i];
+    if(r.base == 0){
+      continue;
+    }
+    StreamPrint(out, "selftest");
+    StreamPrintField(out, "port", (r.base - UART0_BASE) >> 12);
+    StreamPrint(out, " mode=");
+    StreamPrint(out, ModeName[r.mode]);
+    StreamPrintField(out, "max_baud", r.maxBaud);
+    StreamPrintField(out, "cyc_per_byte", r.cycPerByte);
+    StreamPrintField(out, "fail_baud", r.failBaud);
+    StreamPrintField(out, "errors", r.errors);
+    StreamPrintField(out, "rates", r.rates);
+    StreamPrint(out, "\r\n");
+  }
+}
@@ -0,0 +1,67 @@
+/*
+ * SelfTest.h
+ *
+ *  Line self-test in internal loopback (UARTLoopbackEnable). A port is
+ *  run up AutoBaud_Ladder with a PRBS-15 pattern sent and read back
+ *  through one of the drivers, and the highest rate at which it, and
+ *  every rate below it, came back intact is kept together with the CPU
+ *  cost of moving the data there. Loopback takes the pins out of the
+ *  path, so this measures the clock, the divisors and whether the driver
+ *  keeps up, not the cable; AutoBaud finds the cable's limit.
+ *
+ *  Run it at boot before the bridge starts, or on demand with the port
+ *  quiet: whatever the far end sends meanwhile is lost, and the driver's
+ *  rings must be empty. The port's rate and line settings are put back
+ *  afterwards. Usage, device link:
+ *    const SelfTestResult *r = SelfTest_Run(UART1_Buffered, UART1_BASE,
+ *                                           SELFTEST_IRQ, UART1_Handler);
+ *    link.setCeiling(SelfTest_Best(UART1_BASE)->maxBaud);
+ */
+
+#ifndef SELFTEST_H_
+#define SELFTEST_H_
+
+#include <stdint.h>
+#include "ByteStream.h"
+
+#define SELFTEST_BYTES      512         // pattern bytes per rate
+#define SELFTEST_RESULTS    8           // port and mode pairs kept
+
+enum SelfTestMode {SELFTEST_POLLED, SELFTEST_IRQ, SELFTEST_DMA};
+
+struct SelfTestResult {
+  uint32_t base;                        // 0 for an unused entry
+  SelfTestMode mode;
+  uint32_t maxBaud;                     // 0 if even the safe rate failed
+  uint32_t cycPerByte;                  // driver cycles, calls plus ISR,
+                                        // per byte looped at maxBaud
+  uint32_t failBaud;                    // first rate that failed, 0 if none
+  uint32_t errors;                      // bytes wrong or missing there
+  uint32_t rates;                       // rates run
+};
+
+//------------SelfTest_Run------------
+// Loop the port back on itself and step through the ladder until a rate
+// fails. The result replaces any earlier one for the same port and mode.
+// Input: port is the driver for mode, already initialized on base, with
+//        its interrupt (polled: no interrupts enabled on the port);
+//        handler is the vector the driver was initialized with, 0 for
+//        SELFTEST_POLLED
+// Output: the stored result, 0 if the table is full
+const SelfTestResult *SelfTest_Run(ByteStream &port, uint32_t base,
+                                   SelfTestMode mode, void (*handler)(void));
+
+//------------SelfTest_Best------------
+// Operating point for a port: the fastest mode, the cheaper one on a tie
+// Input: base of the port
+// Output: the result, 0 if the port has not been tested
+const SelfTestResult *SelfTest_Best(uint32_t base);
+
+//------------SelfTest_Report------------
+// Print one "selftest port= mode= max_baud= cyc_per_byte= fail_baud=
+// errors= rates=" line per stored result
+// Input: out is the destination
+// Output: none
+void SelfTest_Report(ByteStream &out);
+
+#endif /* SELFTEST_H_ */
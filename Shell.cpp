@@ -0,0 +1,269 @@
+/*
+ * Shell.cpp
+ *
+ *  Non-blocking line editing shell with a perfect hashed command table.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "StreamPrint.h"
+#include "UART0.h"
+#include "Shell.h"
+
+uint32_t ShellOutput::write(const uint8_t *data, uint32_t len){
+  uint32_t n = SHELL_OUT_MAX - m_len;
+  if(n > len){
+    n = len;
+  }
+  memcpy(&m_data[m_len], data, n);
+  m_len += n;
+  m_dropped += len - n;
+  return n;
+}
+
+bool ShellOutput::flush(void){
+  m_sent += m_io.write(&m_data[m_sent], m_len - m_sent);
+  if(m_sent != m_len){
+    return false;
+  }
+  m_len = 0;
+  m_sent = 0;
+  return true;
+}
+
+Shell::Shell(ByteStream &io, const ShellCommand *commands,
+             const ShellIndex &index, const char *prompt)
+  : m_io(io), m_out(io), m_keyCount(0), m_keyPos(0), m_commands(commands),
+    m_index(index), m_prompt(prompt),
+    m_len(0), m_cursor(0), m_keyState(KEY_TEXT), m_csiParam(0),
+    m_histCount(0), m_histPos(0) {
+  m_line[0] = 0;
+  m_edit[0] = 0;
+}
+
+void Shell::start(void){
+  m_out.discard();
+  m_keyCount = 0;
+  m_keyPos = 0;
+  prompt();
+}
+
+void Shell::prompt(void){
+  m_len = 0;
+  m_cursor = 0;
+  m_line[0] = 0;
+  m_keyState = KEY_TEXT;
+  m_histPos = 0;
+  StreamPrint(m_out, m_prompt);
+}
+
+// At most SHELL_CHUNK keys per call, so a pasted block is spread over
+// several passes of the main loop; the rest wait in the port's ring.
+// Handling stops after a command, so its output is all out before the
+// next key is echoed behind it and only one report is ever held.
+bool Shell::poll(void){
+  if(!m_out.flush()){
+    return false;
+  }
+  if(m_keyPos == m_keyCount){
+    m_keyCount = m_io.read(m_keys, sizeof(m_keys));
+    m_keyPos = 0;
+  }
+  bool ran = false;
+  while((m_keyPos < m_keyCount) && !ran){
+    ran = key(m_keys[m_keyPos++]);
+  }
+  m_out.flush();
+  return ran;
+}
+
+bool Shell::key(uint8_t c){
+  if(m_keyState == KEY_ESC){
+    m_keyState = (c == '[') ? KEY_CSI : KEY_TEXT;
+    m_csiParam = 0;
+    return false;
+  }
+  if(m_keyState == KEY_CSI){
+    csi(c);
+    return false;
+  }
+  switch(c){
+    case CR:
+      StreamPrint(m_out, "\r\n");
+      return run();
+    case BS:
+    case DEL:                           // what most terminals send for BS
+      if(m_cursor > 0){
+        back(1);
+        erase(m_cursor - 1);
+      }
+      break;
+    case ESC:
+      m_keyState = KEY_ESC;
+      break;
+    default:
+      if((c >= SP) && (c < DEL)){
+        insert((char)c);
+      }
+      break;                            // LF and other controls dropped
+  }
+  return false;
+}
+
+// ESC [ <digits> <final>; only the keys the shell edits with
+void Shell::csi(uint8_t c){
+  if((c >= '0') && (c <= '9')){
+    m_csiParam = (uint8_t)(m_csiParam * 10 + (c - '0'));
+    return;
+  }
+  m_keyState = KEY_TEXT;
+  switch(c){
+    case 'A':
+      recall(1);
+      break;
+    case 'B':
+      recall(-1);
+      break;
+    case 'C':
+      if(m_cursor < m_len){
+        m_out.write((const uint8_t *)&m_line[m_cursor], 1);
+        m_cursor++;
+      }
+      break;
+    case 'D':
+      if(m_cursor > 0){
+        back(1);
+        m_cursor--;
+      }
+      break;
+    case '~':
+      if((m_csiParam == 3) && (m_cursor < m_len)){
+        erase(m_cursor);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Insert at the cursor and rewrite the tail behind it
+void Shell::insert(char c){
+  if(m_len >= SHELL_LINE_MAX){
+    return;
+  }
+  memmove(&m_line[m_cursor + 1], &m_line[m_cursor], m_len - m_cursor + 1);
+  m_line[m_cursor] = c;
+  m_len++;
+  m_out.write((const uint8_t *)&m_line[m_cursor], m_len - m_cursor);
+  m_cursor++;
+  back(m_len - m_cursor);
+}
+
+// Remove the character at position at, with the terminal's cursor there
+void Shell::erase(uint32_t at){
+  memmove(&m_line[at], &m_line[at + 1], m_len - at);
+  m_len--;
+  m_cursor = at;
+  m_out.write((const uint8_t *)&m_line[at], m_len - at);
+  uint8_t blank = SP;
+  m_out.write(&blank, 1);
+  back(m_len - at + 1);
+}
+
+// Step through the history, newest first; step 1 is older
+void Shell::recall(int32_t step){
+  uint32_t kept = (m_histCount < SHELL_HISTORY) ? m_histCount :
+                                                  SHELL_HISTORY;
+  uint32_t pos = m_histPos + step;
+  if(((step < 0) && (m_histPos == 0)) || (pos > kept)){
+    return;
+  }
+  if(m_histPos == 0){
+    memcpy(m_edit, m_line, m_len + 1);
+  }
+  m_histPos = pos;
+  const char *line = (pos == 0) ? m_edit :
+                     m_history[(m_histCount - pos) % SHELL_HISTORY];
+  m_len = (uint32_t)strlen(line);
+  memcpy(m_line, line, m_len + 1);
+  m_cursor = m_len;
+  redraw();
+}
+
+void Shell::redraw(void){
+  StreamPrint(m_out, "\r");
+  StreamPrint(m_out, m_prompt);
+  m_out.write((const uint8_t *)m_line, m_len);
+  StreamPrint(m_out, "\x1B[K");          // clear what a longer line left
+}
+
+void Shell::back(uint32_t n){
+  static const uint8_t bs[8] = {BS, BS, BS, BS, BS, BS, BS, BS};
+  while(n != 0){
+    uint32_t k = (n < sizeof(bs)) ? n : sizeof(bs);
+    m_out.write(bs, k);
+    n -= k;
+  }
+}
+
+const ShellCommand *Shell::find(const char *name) const {
+  uint32_t s = Shell_Hash(name, m_index.seed) & (SHELL_SLOTS - 1);
+  uint32_t c = m_index.slot[s];
+  if((c == 0) || (strcmp(m_commands[c - 1].name, name) != 0)){
+    return 0;
+  }
+  return &m_commands[c - 1];
+}
+
+void Shell::help(ByteStream &out) const {
+  for(uint32_t c = 0; c < m_index.count; c++){
+    StreamPrint(out, m_commands[c].help);
+    StreamPrint(out, "\r\n");
+  }
+}
+
+// Store the line in the history, split it in place and dispatch
+bool Shell::run(void){
+  char *argv[SHELL_MAX_ARGS];
+  uint32_t argc = 0;
+  bool ran = false;
+
+  if((m_len != 0) && ((m_histCount == 0) ||
+     (strcmp(m_history[(m_histCount - 1) % SHELL_HISTORY], m_line) != 0))){
+    memcpy(m_history[m_histCount % SHELL_HISTORY], m_line, m_len + 1);
+    m_histCount++;
+  }
+  char *p = m_line;
+  while(*p && (argc < SHELL_MAX_ARGS)){
+    while(*p == SP){
+      *p++ = 0;
+    }
+    if(*p == 0){
+      break;
+    }
+    argv[argc++] = p;
+    while(*p && (*p != SP)){
+      p++;
+    }
+  }
+  if(argc != 0){
+    for(char *c = argv[0]; *c; c++){
+      if((*c >= 'A') && (*c <= 'Z')){
+        *c = (char)(*c + ('a' - 'A'));
+      }
+    }
+    const ShellCommand *command = find(argv[0]);
+    if(command == 0){
+      StreamPrint(m_out, "ERROR\r\n");
+    }else{
+      ran = true;
+      if(!command->handler(m_out, argc, argv)){
+        StreamPrint(m_out, "usage: ");
+        StreamPrint(m_out, command->help);
+        StreamPrint(m_out, "\r\n");
+      }
+    }
+  }
+  prompt();
+  return ran;
+}
@@ -0,0 +1,211 @@
+/*
+ * Shell.h
+ *
+ *  Line editing command shell on any ByteStream, run from the main loop.
+ *  poll() takes whatever keystrokes have arrived, edits the line in a
+ *  fixed buffer and echoes, and returns without waiting for more, so the
+ *  rest of the loop keeps running between keys. Editing: BS/DEL erase
+ *  left, ESC [3~ (Delete) erases under the cursor, ESC [D/[C move the
+ *  cursor, ESC [A/[B walk the history. CR runs the line: it is split on
+ *  spaces in place into argv and the command name, lowercased, is looked
+ *  up in a table hashed at compile time with no collisions, so a lookup
+ *  is one hash and one string compare. Nothing is allocated. Output is
+ *  held in a ShellOutput and handed to the port as it drains; keys are
+ *  not taken while a command's output is still going out.
+ *
+ *  Usage:
+ *    static bool CmdStats(ByteStream &out, uint32_t argc, char *argv[]);
+ *    constexpr ShellCommand Commands[] = {
+ *      {"stats", CmdStats, "stats        port counters"}, ...
+ *    };
+ *    constexpr ShellIndex CommandIndex = Shell_Index(Commands);
+ *    static_assert(CommandIndex.perfect, "command names collide");
+ *    Shell console(UART0_Buffered, Commands, CommandIndex);
+ *    console.start(); for(;;){ console.poll(); ... }
+ */
+
+#ifndef SHELL_H_
+#define SHELL_H_
+
+#include <stdint.h>
+#include "ByteStream.h"
+
+#define SHELL_LINE_MAX      64          // characters per line
+#define SHELL_HISTORY       4           // lines kept for ESC [A
+#define SHELL_MAX_ARGS      8           // argv entries, command included
+#define SHELL_SLOTS         32          // hash slots, power of two
+#define SHELL_SEEDS         256         // hash seeds tried for a perfect fit
+#define SHELL_CHUNK         16          // keystrokes taken per poll()
+#define SHELL_OUT_MAX       1024        // output held, one report's worth
+
+// Runs one command line; argv[0] is the command. Output goes to out.
+// Output: false to have the command's help printed as a usage line
+typedef bool (*ShellHandler)(ByteStream &out, uint32_t argc, char *argv[]);
+
+struct ShellCommand {
+  const char *name;                     // lowercase
+  ShellHandler handler;
+  const char *help;                     // one line for "help"
+};
+
+// Slot table for one command table: slot[] holds command index + 1
+struct ShellIndex {
+  uint8_t slot[SHELL_SLOTS];
+  uint32_t seed;
+  uint32_t count;
+  bool perfect;                         // false: no seed avoided a collision
+};
+
+//------------Shell_Hash------------
+// FNV-1a with the seed folded into the offset basis
+// Input: NUL terminated name, seed
+// Output: hash
+constexpr uint32_t Shell_Hash(const char *name, uint32_t seed){
+  uint32_t h = 2166136261u ^ seed;
+  while(*name){
+    h = (h ^ (uint8_t)*name++) * 16777619u;
+  }
+  return h;
+}
+
+//------------Shell_Index------------
+// Find a seed that gives every command its own slot; evaluated by the
+// compiler when assigned to a constexpr ShellIndex
+// Input: commands, the table
+// Output: the index; check perfect with a static_assert
+template <uint32_t N>
+constexpr ShellIndex Shell_Index(const ShellCommand (&commands)[N]){
+  static_assert(N < SHELL_SLOTS, "more commands than hash slots");
+  ShellIndex index = {};
+  index.count = N;
+  for(uint32_t seed = 0; seed < SHELL_SEEDS; seed++){
+    bool clash = false;
+    for(uint32_t s = 0; s < SHELL_SLOTS; s++){
+      index.slot[s] = 0;
+    }
+    for(uint32_t c = 0; (c < N) && !clash; c++){
+      uint32_t s = Shell_Hash(commands[c].name, seed) & (SHELL_SLOTS - 1);
+      clash = (index.slot[s] != 0);
+      index.slot[s] = (uint8_t)(c + 1);
+    }
+    if(!clash){
+      index.seed = seed;
+      index.perfect = true;
+      return index;
+    }
+  }
+  return index;
+}
+
+// Shell output, echo included, held until the port has room: a report
+// is longer than a TX ring, so it goes out over several polls instead of
+// being cut short or waited for. Whatever does not fit in SHELL_OUT_MAX
+// is dropped and counted.
+class ShellOutput : public ByteStream {
+public:
+  explicit ShellOutput(ByteStream &io)
+    : m_io(io), m_len(0), m_sent(0), m_dropped(0) {}
+
+  uint32_t read(uint8_t *data, uint32_t len){ return m_io.read(data, len); }
+  uint32_t available(void) const { return m_io.available(); }
+
+  //------------write------------
+  // Append to the held output, never waits
+  // Input: data points to len bytes to send
+  // Output: number of bytes accepted, short only when the buffer is full
+  uint32_t write(const uint8_t *data, uint32_t len);
+
+  //------------flush------------
+  // Hand the port as much held output as it takes now, never waits
+  // Input: none
+  // Output: true once nothing is held back
+  bool flush(void);
+
+  //------------discard------------
+  // Forget held output not yet handed to the port
+  // Input: none
+  // Output: none
+  void discard(void){ m_len = 0; m_sent = 0; }
+
+  bool pending(void) const { return m_sent != m_len; }
+  uint32_t dropped(void) const { return m_dropped; }
+
+private:
+  ByteStream &m_io;
+  uint8_t m_data[SHELL_OUT_MAX];
+  uint32_t m_len;                       // bytes held
+  uint32_t m_sent;                      // of those, handed to the port
+  uint32_t m_dropped;                   // bytes lost to a full buffer
+};
+
+class Shell {
+public:
+  Shell(ByteStream &io, const ShellCommand *commands,
+        const ShellIndex &index, const char *prompt = "> ");
+
+  //------------start------------
+  // Clear the line, drop held output and print the prompt
+  // Input: none
+  // Output: none
+  void start(void);
+
+  //------------poll------------
+  // Send held output as the port takes it, then, once it is all out,
+  // handle the keystrokes received so far; call from the main loop
+  // Input: none
+  // Output: true if a command ran
+  bool poll(void);
+
+  //------------find------------
+  // Input: name of a command, lowercase
+  // Output: its table entry, 0 if there is none
+  const ShellCommand *find(const char *name) const;
+
+  //------------idle------------
+  // For Idle_Enter: nothing left for poll() to send
+  // Output: true if no output is held back
+  bool idle(void) const { return !m_out.pending(); }
+
+  //------------dropped------------
+  // Output: output bytes lost to a full ShellOutput buffer
+  uint32_t dropped(void) const { return m_out.dropped(); }
+
+  //------------help------------
+  // Print every command's help line
+  // Input: out is the destination
+  // Output: none
+  void help(ByteStream &out) const;
+
+private:
+  enum KeyState {KEY_TEXT, KEY_ESC, KEY_CSI};
+
+  bool key(uint8_t c);
+  void csi(uint8_t c);
+  void insert(char c);
+  void erase(uint32_t at);
+  void recall(int32_t step);
+  void redraw(void);
+  void back(uint32_t n);
+  bool run(void);
+  void prompt(void);
+
+  ByteStream &m_io;
+  ShellOutput m_out;                    // everything written to m_io
+  uint8_t m_keys[SHELL_CHUNK];          // read but not yet handled
+  uint32_t m_keyCount;
+  uint32_t m_keyPos;
+  const ShellCommand *m_commands;
+  const ShellIndex &m_index;
+  const char *m_prompt;
+  char m_line[SHELL_LINE_MAX + 1];
+  uint32_t m_len;
+  uint32_t m_cursor;
+  KeyState m_keyState;
+  uint8_t m_csiParam;
+  char m_history[SHELL_HISTORY][SHELL_LINE_MAX + 1];
+  uint32_t m_histCount;                 // lines ever stored
+  uint32_t m_histPos;                   // 0 = the line being edited
+  char m_edit[SHELL_LINE_MAX + 1];      // that line, while browsing
+};
+
+#endif /* SHELL_H_ */
@@ -0,0 +1,31 @@
+/*
+ * StreamPrint.cpp
+ *
+ *  Allocation free text output onto any ByteStream.
+ */
+
+#include <stdint.h>
+#include "StreamPrint.h"
+
+void StreamPrint(ByteStream &out, const char *str){
+  const char *end = str;
+  while(*end) end++;
+  out.write((const uint8_t *)str, (uint32_t)(end - str));
+}
+
+void StreamPrintUDec(ByteStream &out, uint32_t n){
+  uint8_t digits[10];
+  uint32_t i = sizeof(digits);
+  do{
+    digits[--i] = '0' + (n % 10);
+    n /= 10;
+  }while(n);
+  out.write(&digits[i], sizeof(digits) - i);
+}
+
+void StreamPrintField(ByteStream &out, const char *name, uint32_t n){
+  StreamPrint(out, " ");
+  StreamPrint(out, name);
+  StreamPrint(out, "=");
+  StreamPrintUDec(out, n);
+}
@@ -0,0 +1,32 @@
+/*
+ * StreamPrint.h
+ *
+ *  Allocation free text output onto any ByteStream, for diagnostics that
+ *  must share a link with interrupt driven traffic.
+ */
+
+#ifndef STREAMPRINT_H_
+#define STREAMPRINT_H_
+
+#include <stdint.h>
+#include "ByteStream.h"
+
+//------------StreamPrint------------
+// Queue a NUL terminated string; anything the stream refuses is dropped
+// Input: out is the destination, str the text
+// Output: none
+void StreamPrint(ByteStream &out, const char *str);
+
+//------------StreamPrintUDec------------
+// Queue a 32-bit number in unsigned decimal format
+// Input: out is the destination, n the number
+// Output: none
+void StreamPrintUDec(ByteStream &out, uint32_t n);
+
+//------------StreamPrintField------------
+// Queue " name=value", the key/value format used by all reports
+// Input: out is the destination, name the key, n the value
+// Output: none
+void StreamPrintField(ByteStream &out, const char *name, uint32_t n);
+
+#endif /* STREAMPRINT_H_ */
@@ -0,0 +1,49 @@
+/*
+ * SysClock.cpp
+ *
+ *  PLL bring-up through RCC2, following the sequence in the TM4C123GH6PM
+ *  datasheet (5.3 Initialization and Configuration).
+ */
+
+#include <stdint.h>
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "SysClock.h"
+
+#define SYSCTL_RCC2_SYSDIV_M    (SYSCTL_RCC2_SYSDIV2_M | SYSCTL_RCC2_SYSDIV2LSB)
+#define SYSCTL_RCC2_SYSDIV_S    22          // 7 bit divisor with DIV400
+
+static uint32_t ClockHz = SYSCLOCK_PIOSC_HZ;
+static uint32_t CyclesPerUs = SYSCLOCK_PIOSC_HZ / 1000000;
+
+void SysClock_Init(void){
+  // 1) use RCC2 for the wider divisor field
+  HWREG(SYSCTL_RCC2) |= SYSCTL_RCC2_USERCC2;
+  // 2) bypass the PLL while it is being configured
+  HWREG(SYSCTL_RCC2) |= SYSCTL_RCC2_BYPASS2;
+  // 3) 16 MHz crystal on the main oscillator
+  HWREG(SYSCTL_RCC) = (HWREG(SYSCTL_RCC) & ~(SYSCTL_RCC_XTAL_M | SYSCTL_RCC_MOSCDIS))
+                      | SYSCTL_RCC_XTAL_16MHZ;
+  HWREG(SYSCTL_RCC2) = (HWREG(SYSCTL_RCC2) & ~SYSCTL_RCC2_OSCSRC2_M)
+                       | SYSCTL_RCC2_OSCSRC2_MO;
+  // 4) power up the PLL
+  HWREG(SYSCTL_RCC2) &= ~SYSCTL_RCC2_PWRDN2;
+  // 5) divide the 400 MHz PLL output down to SYSCLOCK_HZ
+  HWREG(SYSCTL_RCC2) |= SYSCTL_RCC2_DIV400;
+  HWREG(SYSCTL_RCC2) = (HWREG(SYSCTL_RCC2) & ~SYSCTL_RCC2_SYSDIV_M)
+                       | (SYSCLOCK_SYSDIV << SYSCTL_RCC2_SYSDIV_S);
+  // 6) wait for lock, then switch over
+  while((HWREG(SYSCTL_RIS) & SYSCTL_RIS_PLLLRIS) == 0){};
+  HWREG(SYSCTL_RCC2) &= ~SYSCTL_RCC2_BYPASS2;
+
+  ClockHz = SYSCLOCK_HZ;
+  CyclesPerUs = SYSCLOCK_HZ / 1000000;
+}
+
+uint32_t SysClock_Get(void){
+  return ClockHz;
+}
+
+uint32_t SysClock_CyclesPerUs(void){
+  return CyclesPerUs;
+}
@@ -0,0 +1,56 @@
+/*
+ * SysClock.h
+ *
+ *  System clock bring-up. Runs the core from the PLL, fed by the 16 MHz
+ *  crystal on the LaunchPad, instead of the 16 MHz PIOSC it resets to.
+ */
+
+#ifndef SYSCLOCK_H_
+#define SYSCLOCK_H_
+
+#include <stdint.h>
+
+#define SYSCLOCK_PIOSC_HZ   16000000    // reset clock, before SysClock_Init
+#define SYSCLOCK_PLL_HZ     400000000   // PLL output with DIV400
+
+// Target bus clock. Must divide 400 MHz evenly and not exceed the part's
+// 80 MHz limit; override from the build to run slower.
+#ifndef SYSCLOCK_HZ
+#define SYSCLOCK_HZ         80000000
+#endif
+
+static_assert(SYSCLOCK_HZ <= 80000000, "TM4C123 bus clock is 80 MHz max");
+static_assert((SYSCLOCK_PLL_HZ % SYSCLOCK_HZ) == 0 &&
+              (SYSCLOCK_PLL_HZ / SYSCLOCK_HZ) <= 128,
+              "SYSCLOCK_HZ must be 400 MHz / n, n = 5..128");
+
+#define SYSCLOCK_SYSDIV     ((SYSCLOCK_PLL_HZ / SYSCLOCK_HZ) - 1)
+
+// Clock feeding the UART baud generators. UART_CLOCK_PIOSC runs them from
+// PIOSC instead of the system clock, so the baud rate survives deep sleep
+// switching the system clock off the PLL (see Idle.h).
+#ifdef UART_CLOCK_PIOSC
+#define UART_CLOCK_HZ       SYSCLOCK_PIOSC_HZ
+#else
+#define UART_CLOCK_HZ       SYSCLOCK_HZ
+#endif
+
+//------------SysClock_Init------------
+// Switch the bus clock to SYSCLOCK_HZ from the PLL. Call first thing in
+// main(), before any peripheral whose timing depends on the clock (UART
+// baud divisors are computed for SYSCLOCK_HZ).
+// Input: none
+// Output: none
+void SysClock_Init(void);
+
+//------------SysClock_Get------------
+// Input: none
+// Output: current bus clock in Hz, SYSCLOCK_PIOSC_HZ until SysClock_Init
+uint32_t SysClock_Get(void);
+
+//------------SysClock_CyclesPerUs------------
+// Input: none
+// Output: bus clock cycles per microsecond
+uint32_t SysClock_CyclesPerUs(void);
+
+#endif /* SYSCLOCK_H_ */
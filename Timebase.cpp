@@ -0,0 +1,126 @@
+/*
+ * Timebase.cpp
+ *
+ *  SysTick driven millisecond/microsecond timebase.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hw_nvic.h"
+#include "hw_types.h"
+#include "cpu.h"
+#include "SysClock.h"
+#include "Timebase.h"
+
+static volatile uint32_t Ticks;         // ms, written by SysTick_Handler only
+static uint32_t Reload;                 // SysTick reload value
+static uint32_t CyclesPerUs;
+
+void Timebase_Init(void){
+  CyclesPerUs = SysClock_CyclesPerUs();
+  Reload = SysClock_Get() / TIMEBASE_TICK_HZ - 1;
+  Ticks = 0;
+  HWREG(NVIC_ST_CTRL) = 0;              // stop SysTick during setup
+  HWREG(NVIC_ST_RELOAD) = Reload & NVIC_ST_RELOAD_M;
+  HWREG(NVIC_ST_CURRENT) = 0;           // any write clears the counter
+  HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN |
+                        NVIC_ST_CTRL_ENABLE;
+}
+
+uint32_t Timebase_Millis(void){
+  return Ticks;
+}
+
+uint32_t Timebase_Micros(void){
+  uint32_t ms;
+  uint32_t current;
+  // Re-read if the tick interrupt landed between the two reads, so the
+  // millisecond count and the sub-tick counter belong together
+  do{
+    ms = Ticks;
+    current = HWREG(NVIC_ST_CURRENT);
+  }while(ms != Ticks);
+  return ms * (1000000 / TIMEBASE_TICK_HZ) + (Reload - current) / CyclesPerUs;
+}
+
+void Timebase_SleepUntil(uint32_t deadline){
+  while(!Timebase_Expired(deadline)){
+    CPUwfi();                           // SysTick wakes us at least every ms
+  }
+}
+
+void Timebase_SleepMs(uint32_t ms){
+  Timebase_SleepUntil(Timebase_Deadline(ms + 1));
+}
+
+void Timebase_DelayUs(uint32_t us){
+  uint32_t start = Timebase_Micros();
+  while((Timebase_Micros() - start) < us){};
+}
+
+// Convert a cycle count between the run and sleep SysTick clocks
+static uint32_t Scale(uint32_t cycles, uint32_t to, uint32_t from){
+  return (uint32_t)(((uint64_t)cycles * to) / from);
+}
+
+void Timebase_IdleFor(uint32_t ms, uint32_t sleepHz){
+  uint32_t runPerTick = Reload + 1;
+  uint32_t sleepPerTick = sleepHz / TIMEBASE_TICK_HZ;
+  uint32_t maxTicks = (NVIC_ST_RELOAD_M + 1) / sleepPerTick;
+  if(ms > maxTicks){
+    ms = maxTicks;
+  }
+  if(ms < 2){
+    CPUwfi();                           // next tick is the deadline anyway
+    return;
+  }
+  HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN;  // pause
+  if(HWREG(NVIC_INT_CTRL) & NVIC_INT_CTRL_PENDSTSET){
+    // A tick is already waiting to be counted; let it run normally
+    HWREG(NVIC_ST_CTRL) |= NVIC_ST_CTRL_ENABLE;
+    return;
+  }
+
+  // One long period: the rest of the current tick plus ms - 1 whole ones
+  uint32_t left = Scale(HWREG(NVIC_ST_CURRENT), sleepPerTick, runPerTick);
+  uint32_t period = left + (ms - 1) * sleepPerTick;
+  HWREG(NVIC_ST_RELOAD) = period - 1;
+  HWREG(NVIC_ST_CURRENT) = 0;
+  HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN |
+                        NVIC_ST_CTRL_ENABLE;
+  CPUwfi();
+  uint32_t ctrl = HWREG(NVIC_ST_CTRL);  // reading clears COUNT
+  HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN;
+  uint32_t elapsed = (period - 1) - HWREG(NVIC_ST_CURRENT);
+
+  uint32_t ticks;
+  uint32_t next;                        // run cycles until the next tick
+  if(ctrl & NVIC_ST_CTRL_COUNT){
+    ticks = ms - 1;                     // the pending SysTick adds the last
+    next = runPerTick;
+  }else if(elapsed < left){
+    ticks = 0;                          // woken inside the first tick
+    next = Scale(left - elapsed, runPerTick, sleepPerTick);
+  }else{
+    elapsed -= left;
+    ticks = 1 + elapsed / sleepPerTick;
+    next = Scale(sleepPerTick - elapsed % sleepPerTick, runPerTick, sleepPerTick);
+  }
+  if(next < 2){
+    next = 2;
+  }
+  Ticks = Ticks + ticks;
+
+  // Run out the partial tick, then go back to the normal period. RELOAD
+  // is only sampled when the counter reaches zero, so the second write
+  // takes effect from the following tick on.
+  HWREG(NVIC_ST_RELOAD) = next - 1;
+  HWREG(NVIC_ST_CURRENT) = 0;
+  HWREG(NVIC_ST_CTRL) = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN |
+                        NVIC_ST_CTRL_ENABLE;
+  HWREG(NVIC_ST_RELOAD) = Reload;
+}
+
+void SysTick_Handler(void){
+  Ticks = Ticks + 1;
+}
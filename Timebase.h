@@ -0,0 +1,81 @@
+/*
+ * Timebase.h
+ *
+ *  SysTick driven monotonic time. SysTick interrupts once per millisecond;
+ *  microseconds are interpolated from the SysTick down counter. Waits put
+ *  the core to sleep with WFI between interrupts instead of spinning.
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIMEBASE_TICK_HZ    1000        // SysTick interrupt rate
+
+//------------Timebase_Init------------
+// Start SysTick at TIMEBASE_TICK_HZ from the core clock. Call after
+// SysClock_Init so the reload value matches the running clock.
+// Input: none
+// Output: none
+void Timebase_Init(void);
+
+//------------Timebase_Millis------------
+// Input: none
+// Output: milliseconds since Timebase_Init, wraps after ~49.7 days
+uint32_t Timebase_Millis(void);
+
+//------------Timebase_Micros------------
+// Input: none
+// Output: microseconds since Timebase_Init, wraps after ~71.6 minutes
+uint32_t Timebase_Micros(void);
+
+//------------Timebase_Deadline------------
+// Input: ms from now
+// Output: millisecond timestamp to pass to Timebase_Expired/SleepUntil
+static inline uint32_t Timebase_Deadline(uint32_t ms){
+  return Timebase_Millis() + ms;
+}
+
+//------------Timebase_Expired------------
+// Wrap-safe comparison against a deadline up to 2^31 ms away
+// Input: deadline from Timebase_Deadline
+// Output: true once the deadline has passed
+static inline bool Timebase_Expired(uint32_t deadline){
+  return (int32_t)(Timebase_Millis() - deadline) >= 0;
+}
+
+//------------Timebase_SleepUntil------------
+// Sleep (WFI) until the deadline. Other interrupts still run and wake
+// the core; it goes back to sleep until the deadline has passed.
+// Input: deadline from Timebase_Deadline
+// Output: none
+void Timebase_SleepUntil(uint32_t deadline);
+
+//------------Timebase_SleepMs------------
+// Input: ms to sleep, at least ms and less than ms + 1
+// Output: none
+void Timebase_SleepMs(uint32_t ms);
+
+//------------Timebase_DelayUs------------
+// Busy wait for waits shorter than a tick
+// Input: us to wait
+// Output: none
+void Timebase_DelayUs(uint32_t us);
+
+//------------Timebase_IdleFor------------
+// Tickless sleep: stretch the SysTick period so the core sleeps through
+// up to ms ticks in one WFI, then credit the ticks that passed. Call with
+// interrupts masked; the wakeup source runs once they are unmasked.
+// Input: ms is the longest sleep, clipped to what fits in SysTick's 24
+//        bits; sleepHz is the SysTick clock while asleep (the system clock
+//        for WFI, the deep-sleep clock for deep sleep)
+// Output: none
+void Timebase_IdleFor(uint32_t ms, uint32_t sleepHz);
+
+//------------SysTick_Handler------------
+// SysTick vector, placed in the startup vector table
+extern "C" void SysTick_Handler(void);
+
+#endif /* TIMEBASE_H_ */
@@ -4,17 +4,40 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string>
-#include "UART.h"
+#include "UART0.h"
+#include "BaudRate.h"
+#include "Profile.h"
+#include "SysClock.h"
 #include "tm4c123gh6pm.h"
 
+#define UART_FR_TXFE            0x00000080  // UART Transmit FIFO Empty
 #define UART_FR_TXFF            0x00000020  // UART Transmit FIFO Full
 #define UART_FR_RXFE            0x00000010  // UART Receive FIFO Empty
 #define UART_LCRH_WLEN_8        0x00000060  // 8 bit word length
 #define UART_LCRH_FEN           0x00000010  // UART Enable FIFOs
+#define UART_CTL_HSE            0x00000020  // High-Speed Enable
 #define UART_CTL_UARTEN         0x00000001  // UART Enable
+#ifdef UART_CLOCK_PIOSC
+#define UART_CC_CS              0x00000005  // baud clock from PIOSC
+#else
+#define UART_CC_CS              0x00000000  // baud clock from system clock
+#endif
+#define UART_TX_FIFO_DEPTH      16          // hardware TX FIFO entries
+
+#ifndef UART0_BAUD
+#define UART0_BAUD              115200      // PC link
+#endif
+#ifndef UART1_BAUD
+#define UART1_BAUD              115200      // device link
+#endif
+
+// Divisors are fixed at compile time; a rate the clock cannot hit within
+// BAUD_MAX_ERROR_PPM is a build error rather than a garbled link
+typedef BaudDivisor<UART_CLOCK_HZ, UART0_BAUD> UART0Baud;
+typedef BaudDivisor<UART_CLOCK_HZ, UART1_BAUD> UART1Baud;
 
 //------------UART0_Init------------
-// Initialize the UART for 115,200 baud rate (assuming 16 MHz bus clock),
+// Initialize the UART for UART0_BAUD (default 115,200) from UART_CLOCK_HZ,
 // 8 bit word length, no parity bits, one stop bit, FIFOs enabled
 // Input: none
 // Output: none
@@ -22,8 +45,14 @@ void UART0_Init(void){
   SYSCTL_RCGCUART_R |= 0x01;            // activate UART0
   SYSCTL_RCGCGPIO_R |= 0x01;            // activate port A
   UART0_CTL_R &= ~UART_CTL_UARTEN;      // disable UART
-  UART0_IBRD_R = 8;                     // IBRD = int(16,000,000 / (16 * 115,200)) = int(8.680)
-  UART0_FBRD_R = 44;                    // FBRD = round(0.5104 * 64 ) = 33
+  UART0_CC_R = UART_CC_CS;              // UART_CLOCK_HZ source
+  UART0_IBRD_R = UART0Baud::IBRD;       // IBRD = int(clock / (16 * baud))
+  UART0_FBRD_R = UART0Baud::FBRD;       // FBRD = round(fraction * 64)
+  if(UART0Baud::HSE){                   // divide by 8 for rates above clock/16
+    UART0_CTL_R |= UART_CTL_HSE;
+  }else{
+    UART0_CTL_R &= ~UART_CTL_HSE;
+  }
                                         // 8 bit word length (no parity bits, one stop bit, FIFOs)
   UART0_LCRH_R = (UART_LCRH_WLEN_8|UART_LCRH_FEN);
   UART0_CTL_R |= UART_CTL_UARTEN;       // enable UART
@@ -33,9 +62,8 @@ void UART0_Init(void){
   GPIO_PORTA_PCTL_R = (GPIO_PORTA_PCTL_R&0xFFFFFF00)+0x00000011;
   GPIO_PORTA_AMSEL_R &= ~0x03;          // disable analog functionality on PA
 }
-/*
 //------------UART1_Init------------
-// Initialize the UART for 115,200 baud rate (assuming 16 MHz bus clock),
+// Initialize the UART for UART1_BAUD (default 115,200) from UART_CLOCK_HZ,
 // 8 bit word length, no parity bits, one stop bit, FIFOs enabled
 // Input: none
 // Output: none
@@ -43,8 +71,14 @@ void UART1_Init(void){
   SYSCTL_RCGCUART_R |= 0x02;            // activate UART1
   SYSCTL_RCGCGPIO_R |= 0x02;            // activate port B
   UART1_CTL_R &= ~UART_CTL_UARTEN;      // disable UART
-  UART1_IBRD_R = 8;                     // IBRD = int(16,000,000 / (16 * 115,200)) = int(8.680)
-  UART1_FBRD_R = 44;                    // FBRD = round(0.5104 * 64 ) = 33
+  UART1_CC_R = UART_CC_CS;              // UART_CLOCK_HZ source
+  UART1_IBRD_R = UART1Baud::IBRD;       // IBRD = int(clock / (16 * baud))
+  UART1_FBRD_R = UART1Baud::FBRD;       // FBRD = round(fraction * 64)
+  if(UART1Baud::HSE){                   // divide by 8 for rates above clock/16
+    UART1_CTL_R |= UART_CTL_HSE;
+  }else{
+    UART1_CTL_R &= ~UART_CTL_HSE;
+  }
                                         // 8 bit word length (no parity bits, one stop bit, FIFOs)
   UART1_LCRH_R = (UART_LCRH_WLEN_8|UART_LCRH_FEN);
   UART1_CTL_R |= UART_CTL_UARTEN;       // enable UART
@@ -54,12 +88,26 @@ void UART1_Init(void){
   GPIO_PORTB_PCTL_R = (GPIO_PORTB_PCTL_R&0xFFFFFF00)+0x00000011;
   GPIO_PORTB_AMSEL_R &= ~0x03;          // disable analog functionality on PB
 }
-*/
+//------------UART1_InitFlowPins------------
+// Mux U1RTS/U1CTS onto PC4/PC5 for hardware flow control on the device
+// link (PCTL function 8). These are UART4's pins in UARTPinTable, so
+// UART4 cannot be used at the same time.
+// Input: none
+// Output: none
+void UART1_InitFlowPins(void){
+  SYSCTL_RCGCGPIO_R |= 0x04;            // activate port C
+  GPIO_PORTC_AFSEL_R |= 0x30;           // enable alt funct on PC5-4
+  GPIO_PORTC_DEN_R |= 0x30;             // enable digital I/O on PC5-4
+                                        // configure PC5-4 as U1CTS, U1RTS
+  GPIO_PORTC_PCTL_R = (GPIO_PORTC_PCTL_R&0xFF00FFFF)+0x00880000;
+  GPIO_PORTC_AMSEL_R &= ~0x30;          // disable analog functionality on PC5-4
+}
 //------------UART0_InChar------------
 // Wait for new serial port input
 // Input: none
 // Output: ASCII code for key typed
 char UART0_InChar(void){
+  PROFILE_SCOPE("uart0_inchar");
   while((UART0_FR_R&UART_FR_RXFE) != 0);
   return((char)(UART0_DR_R&0xFF));
 }
@@ -68,14 +116,74 @@ char UART0_InChar(void){
 // Input: letter is an 8-bit ASCII character to be transferred
 // Output: none
 void UART0_OutChar(char data){
+  PROFILE_SCOPE("uart0_outchar");
   while((UART0_FR_R&UART_FR_TXFF) != 0);
   UART0_DR_R = data;
 }
 
-void UART0_OutString(const std::string& data){
-    for(int i=0; i<data.length(); i++){
-        UART0_OutChar(data[i]);
+//------------UART0_Write------------
+// Output a block of bytes, filling the TX FIFO a burst at a time.
+// The flag register is polled once per 16-byte burst (FIFO empty)
+// instead of once per byte.
+// Input: data points to len bytes to transmit
+// Output: none
+void UART0_Write(const uint8_t *data, uint32_t len){
+  while(len > 0){
+    uint32_t burst = (len < UART_TX_FIFO_DEPTH) ? len : UART_TX_FIFO_DEPTH;
+    while((UART0_FR_R&UART_FR_TXFE) == 0);
+    len -= burst;
+    while(burst--){
+      UART0_DR_R = *data++;
     }
+  }
+}
+//------------UART0_Writev------------
+// Output a scatter list of blocks; bursts run across block boundaries
+// so short fragments still fill the FIFO
+// Input: iov points to cnt block descriptors
+// Output: none
+void UART0_Writev(const UARTIOVec *iov, uint32_t cnt){
+  uint32_t room = 0;
+  for(uint32_t i=0; i<cnt; i++){
+    const uint8_t *data = iov[i].data;
+    uint32_t len = iov[i].len;
+    while(len > 0){
+      if(room == 0){
+        while((UART0_FR_R&UART_FR_TXFE) == 0);
+        room = UART_TX_FIFO_DEPTH;
+      }
+      uint32_t burst = (len < room) ? len : room;
+      len -= burst;
+      room -= burst;
+      while(burst--){
+        UART0_DR_R = *data++;
+      }
+    }
+  }
+}
+
+void UART0_OutString(const char *data){
+  const char *end = data;
+  while(*end) end++;
+  UART0_Write((const uint8_t *)data, (uint32_t)(end - data));
+}
+
+void UART0_OutString(const std::string& data){
+  UART0_Write((const uint8_t *)data.data(), (uint32_t)data.length());
+}
+
+//------------UART0_OutUDec------------
+// Output a 32-bit number in unsigned decimal format
+// Input: n is the number to print, no leading zeros or padding
+// Output: none
+void UART0_OutUDec(uint32_t n){
+  uint8_t digits[10];
+  uint32_t i = sizeof(digits);
+  do{
+    digits[--i] = '0' + (n % 10);
+    n /= 10;
+  }while(n);
+  UART0_Write(&digits[i], sizeof(digits) - i);
 }
 /*
 
@@ -5,7 +5,9 @@
  *      Author: travp
  */
 
+#include <stdint.h>
 #include <string>
+#include "ByteStream.h"
 
 #ifndef UART_H_
 #define UART_H_
@@ -32,6 +34,21 @@
 // Output: none
 void UART0_Init(void);
 
+//------------UART1_Init------------
+// Initialize UART1 on PB1-0 for UART1_BAUD (default 115,200) from
+// UART_CLOCK_HZ, 8 bit word length, no parity bits, one stop bit,
+// FIFOs enabled
+// Input: none
+// Output: none
+void UART1_Init(void);
+
+//------------UART1_InitFlowPins------------
+// Mux U1RTS/U1CTS onto PC4/PC5 for UART1 RTS/CTS flow control (see
+// BufferedUART::setFlowControl). Takes UART4's pins.
+// Input: none
+// Output: none
+void UART1_InitFlowPins(void);
+
 char UART0_InChar(void);
 
 //------------UART0_OutChar------------
@@ -40,8 +57,27 @@ char UART0_InChar(void);
 // Output: none
 void UART0_OutChar(char data);
 
+//------------UART0_Write------------
+// Output a block of bytes in 16-byte FIFO bursts (blocking)
+// Input: data points to len bytes to transmit
+// Output: none
+void UART0_Write(const uint8_t *data, uint32_t len);
+
+//------------UART0_Writev------------
+// Output a scatter list of blocks in FIFO bursts (blocking)
+// Input: iov points to cnt block descriptors
+// Output: none
+void UART0_Writev(const UARTIOVec *iov, uint32_t cnt);
+
+void UART0_OutString(const char *data);
 void UART0_OutString(const std::string& data);
 
+//------------UART0_OutUDec------------
+// Output a 32-bit number in unsigned decimal format
+// Input: n is the number to print
+// Output: none
+void UART0_OutUDec(uint32_t n);
+
 // Clear display
 void Output_Clear(void);
 
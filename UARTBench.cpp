@@ -0,0 +1,271 @@
+/*
+ * UARTBench.cpp
+ *
+ *  On-target cycle count benchmarks for the UART output paths, the
+ *  COBS and CRC frame codecs, the escape detector and the Uart<Base>
+ *  register template.
+ */
+
+#include <stdint.h>
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "interrupt.h"
+#include "uart.h"
+#include "Cobs.h"
+#include "Crc.h"
+#include "CycleCount.h"
+#include "BufferedUART.h"
+#include "Escape.h"
+#include "SysClock.h"
+#include "UartRegs.h"
+#include "UART0.h"
+#include "UARTBench.h"
+
+#define BENCH_BURST   16                // one full TX FIFO
+#ifndef UART0_BAUD
+#define UART0_BAUD    115200            // as in UART0.cpp
+#endif
+#define BENCH_ROUNDS  64
+
+static const uint8_t BenchPattern[BENCH_BURST] = {
+  'U','U','U','U','U','U','U','U','U','U','U','U','U','U','U','U'
+};
+
+// Wait until the FIFO and shift register are both empty
+static void WaitTxDrained(void){
+  while((HWREG(UART0_BASE + UART_O_FR)&(UART_FR_TXFE|UART_FR_BUSY)) != UART_FR_TXFE);
+}
+
+static void Report(const char *name, uint32_t bytes, uint32_t cycles){
+  UART0_OutString("bench=");
+  UART0_OutString(name);
+  UART0_OutString(" bytes=");
+  UART0_OutUDec(bytes);
+  UART0_OutString(" cycles=");
+  UART0_OutUDec(cycles);
+  UART0_OutString(" cyc_per_byte=");
+  UART0_OutUDec(cycles/bytes);
+  UART0_OutString("\r\n");
+}
+
+void UART0_BenchWrite(void){
+  uint32_t perChar = 0;
+  uint32_t burst = 0;
+  CycleCounterInit();
+
+  for(uint32_t round=0; round<BENCH_ROUNDS; round++){
+    WaitTxDrained();
+    uint32_t start = CycleCounterGet();
+    for(uint32_t i=0; i<BENCH_BURST; i++){
+      UART0_OutChar(BenchPattern[i]);
+    }
+    perChar += CycleCounterGet() - start;
+
+    WaitTxDrained();
+    start = CycleCounterGet();
+    UART0_Write(BenchPattern, BENCH_BURST);
+    burst += CycleCounterGet() - start;
+  }
+  WaitTxDrained();
+  Report("outchar", BENCH_BURST*BENCH_ROUNDS, perChar);
+  Report("write", BENCH_BURST*BENCH_ROUNDS, burst);
+}
+
+void UART0_BenchCOBS(void){
+  static uint8_t data[COBS_BLOCK];
+  static uint8_t encoded[Cobs_EncodedMax(COBS_BLOCK) + 1];
+  static uint8_t decoded[COBS_BLOCK];
+  uint32_t encode = 0;
+  uint32_t decode = 0;
+  uint32_t n = 0;
+  CobsDecoder decoder;
+  CycleCounterInit();
+
+  for(uint32_t i=0; i<COBS_BLOCK; i++){
+    data[i] = (i%16) ? (uint8_t)i : 0;
+  }
+  for(uint32_t round=0; round<BENCH_ROUNDS; round++){
+    uint32_t start = CycleCounterGet();
+    n = Cobs_Encode(data, COBS_BLOCK, encoded);
+    encode += CycleCounterGet() - start;
+
+    decoder.begin(decoded, COBS_BLOCK);
+    start = CycleCounterGet();
+    for(uint32_t i=0; i<n; i++){
+      decoder.put(encoded[i]);
+    }
+    decode += CycleCounterGet() - start;
+  }
+  Report("cobs_encode", COBS_BLOCK*BENCH_ROUNDS, encode);
+  Report("cobs_decode", n*BENCH_ROUNDS, decode);
+}
+
+void UART0_BenchCRC(void){
+  static uint8_t data[COBS_BLOCK];
+  uint32_t cycles[6] = {0};
+  uint16_t crc16 = CRC16_INIT;
+  uint32_t crc32 = CRC32_INIT;
+  CycleCounterInit();
+
+  for(uint32_t i=0; i<COBS_BLOCK; i++){
+    data[i] = (uint8_t)(i*151 + 7);
+  }
+  for(uint32_t round=0; round<BENCH_ROUNDS; round++){
+    uint32_t start = CycleCounterGet();
+    for(uint32_t i=0; i<COBS_BLOCK; i++){
+      crc16 = Crc16_Update(crc16, data[i]);
+    }
+    cycles[0] += CycleCounterGet() - start;
+    start = CycleCounterGet();
+    crc16 = Crc16_Block(crc16, data, COBS_BLOCK);
+    cycles[1] += CycleCounterGet() - start;
+    start = CycleCounterGet();
+    crc16 = Crc16_Block4(crc16, data, COBS_BLOCK);
+    cycles[2] += CycleCounterGet() - start;
+
+    start = CycleCounterGet();
+    for(uint32_t i=0; i<COBS_BLOCK; i++){
+      crc32 = Crc32_Update(crc32, data[i]);
+    }
+    cycles[3] += CycleCounterGet() - start;
+    start = CycleCounterGet();
+    crc32 = Crc32_Block(crc32, data, COBS_BLOCK);
+    cycles[4] += CycleCounterGet() - start;
+    start = CycleCounterGet();
+    crc32 = Crc32_Block4(crc32, data, COBS_BLOCK);
+    cycles[5] += CycleCounterGet() - start;
+  }
+  Report("crc16_update", COBS_BLOCK*BENCH_ROUNDS, cycles[0]);
+  Report("crc16_table", COBS_BLOCK*BENCH_ROUNDS, cycles[1]);
+  Report("crc16_slice4", COBS_BLOCK*BENCH_ROUNDS, cycles[2]);
+  Report("crc32_update", COBS_BLOCK*BENCH_ROUNDS, cycles[3]);
+  Report("crc32_table", COBS_BLOCK*BENCH_ROUNDS, cycles[4]);
+  Report("crc32_slice4", COBS_BLOCK*BENCH_ROUNDS, cycles[5]);
+}
+
+// Stands in for the detector, so only its own work is left
+static void EmptyWatch(void *context, uint8_t data){
+  (void)context;
+  (void)data;
+}
+
+// Cycles for count calls of watch through a pointer, as the ISR makes them
+static uint32_t TimeWatch(UARTRxHook watch, void *context,
+                          const uint8_t *data, uint32_t count){
+  uint32_t start = CycleCounterGet();
+  for(uint32_t i=0; i<count; i++){
+    watch(context, data[i]);
+  }
+  return CycleCounterGet() - start;
+}
+
+void UART0_BenchEscape(void){
+  static uint8_t text[COBS_BLOCK];
+  static uint8_t plus[COBS_BLOCK];
+  uint32_t cycles[4] = {0};
+  // never started, so the port's RX path is left alone
+  EscapeDetector esc(UART0_Buffered);
+  UARTRxHook volatile watch = EscapeDetector::RxWatch;
+  UARTRxHook volatile empty = EmptyWatch;
+
+  for(uint32_t i=0; i<COBS_BLOCK; i++){
+    text[i] = (uint8_t)(' ' + 1 + i%94);    // printable, no '+' runs
+    plus[i] = ESCAPE_CHAR;
+  }
+  for(uint32_t round=0; round<BENCH_ROUNDS; round++){
+    cycles[0] += TimeWatch(empty, &esc, text, COBS_BLOCK);
+    cycles[1] += TimeWatch(watch, &esc, text, COBS_BLOCK);
+    cycles[2] += TimeWatch(empty, &esc, plus, COBS_BLOCK);
+    cycles[3] += TimeWatch(watch, &esc, plus, COBS_BLOCK);
+  }
+  Report("escape_watch", COBS_BLOCK*BENCH_ROUNDS, cycles[1] - cycles[0]);
+  Report("escape_watch_plus", COBS_BLOCK*BENCH_ROUNDS, cycles[3] - cycles[2]);
+}
+
+struct OpCount {
+  uint32_t instr;
+  uint32_t cycles;
+};
+
+// Run op once per round between two counter samples; each window is
+// short enough for the 8 bit DWT profiling counters
+template <class Op>
+static OpCount CountOp(Op op){
+  OpCount total = {0, 0};
+  InstrSample start, end;
+  for(uint32_t round=0; round<BENCH_ROUNDS; round++){
+    InstrCounterGet(&start);
+    op();
+    InstrCounterGet(&end);
+    total.instr += InstrCounterElapsed(&start, &end);
+    total.cycles += end.cycles - start.cycles;
+  }
+  return total;
+}
+
+struct TmplResult {
+  const char *name;
+  OpCount lib;
+  OpCount tmpl;
+};
+
+void UART0_BenchTmpl(void){
+  typedef Uart<UART0_BASE> U0;
+  TmplResult result[10];
+  uint32_t n = 0;
+  uint32_t im = HWREG(UART0_BASE + UART_O_IM);
+  uint32_t ifls = HWREG(UART0_BASE + UART_O_IFLS);
+  InstrCounterInit();
+  WaitTxDrained();
+
+  OpCount base = CountOp([]{});
+  result[n++] = {"chars_avail",
+    CountOp([]{ UARTCharsAvail(UART0_BASE); }),
+    CountOp([]{ U0::charsAvail(); })};
+  result[n++] = {"space_avail",
+    CountOp([]{ UARTSpaceAvail(UART0_BASE); }),
+    CountOp([]{ U0::spaceAvail(); })};
+  result[n++] = {"busy",
+    CountOp([]{ UARTBusy(UART0_BASE); }),
+    CountOp([]{ U0::busy(); })};
+  result[n++] = {"char_get_nb",
+    CountOp([]{ UARTCharGetNonBlocking(UART0_BASE); }),
+    CountOp([]{ U0::charGetNonBlocking(); })};
+  result[n++] = {"int_status",
+    CountOp([]{ UARTIntStatus(UART0_BASE, true); }),
+    CountOp([]{ U0::intStatus(true); })};
+  result[n++] = {"int_clear",
+    CountOp([]{ UARTIntClear(UART0_BASE, 0); }),
+    CountOp([]{ U0::intClear(0); })};
+  result[n++] = {"int_enable",
+    CountOp([im]{ UARTIntEnable(UART0_BASE, im); }),
+    CountOp([im]{ U0::intEnable(im); })};
+  result[n++] = {"fifo_level",
+    CountOp([ifls]{ UARTFIFOLevelSet(UART0_BASE, ifls & 0x07, ifls & 0x38); }),
+    CountOp([ifls]{ U0::fifoLevelSet(ifls & 0x07, ifls & 0x38); })};
+  result[n++] = {"nvic_disable",
+    CountOp([]{ IntDisable(INT_UART0_TM4C123); }),
+    CountOp([]{ U0::nvicDisable(); })};
+  // Same divisors and line settings UART0_Init programmed
+  result[n++] = {"configure",
+    CountOp([]{ UARTConfigSetExpClk(UART0_BASE, UART_CLOCK_HZ, UART0_BAUD,
+                                    UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                                    UART_CONFIG_PAR_NONE); }),
+    CountOp([]{ U0::configure<UART_CLOCK_HZ, UART0_BAUD>(UART_LCRH_WLEN_8); })};
+
+  for(uint32_t i=0; i<n; i++){
+    UART0_OutString("bench=tmpl_");
+    UART0_OutString(result[i].name);
+    UART0_OutString(" lib_instr=");
+    UART0_OutUDec((result[i].lib.instr - base.instr)/BENCH_ROUNDS);
+    UART0_OutString(" tmpl_instr=");
+    UART0_OutUDec((result[i].tmpl.instr - base.instr)/BENCH_ROUNDS);
+    UART0_OutString(" lib_cyc=");
+    UART0_OutUDec((result[i].lib.cycles - base.cycles)/BENCH_ROUNDS);
+    UART0_OutString(" tmpl_cyc=");
+    UART0_OutUDec((result[i].tmpl.cycles - base.cycles)/BENCH_ROUNDS);
+    UART0_OutString("\r\n");
+  }
+}
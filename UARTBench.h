@@ -0,0 +1,60 @@
+/*
+ * UARTBench.h
+ *
+ *  On-target cycle count benchmarks for the UART output paths, the
+ *  COBS and CRC frame codecs, the escape detector and the Uart<Base>
+ *  register template.
+ */
+
+#ifndef UARTBENCH_H_
+#define UARTBENCH_H_
+
+//------------UART0_BenchWrite------------
+// Compare the per-character UART0_OutChar path against the burst
+// UART0_Write path and print one result line per path over UART0:
+//   bench=<name> bytes=<n> cycles=<total> cyc_per_byte=<mean>
+// Each sample starts from an empty TX FIFO so only CPU cost is
+// measured, not time spent waiting on the line.
+// Input: none
+// Output: none
+void UART0_BenchWrite(void);
+
+//------------UART0_BenchCOBS------------
+// Time COBS encode and the per-byte streaming decode used by the RX ISR
+// on one full block of binary payload (a zero every 16 bytes) and print
+//   bench=cobs_encode ... and bench=cobs_decode ...
+// in the same format as UART0_BenchWrite.
+// Input: none
+// Output: none
+void UART0_BenchCOBS(void);
+
+//------------UART0_BenchCRC------------
+// Time CRC-16 and CRC-32 over the same block in their per-byte (ISR),
+// bytewise table and slicing-by-4 forms and print one line per form,
+// e.g. bench=crc32_slice4 bytes=<n> cycles=<total> cyc_per_byte=<mean>
+// Input: none
+// Output: none
+void UART0_BenchCRC(void);
+
+//------------UART0_BenchEscape------------
+// Time the escape detector's RX watch, the work it adds to the RX ISR
+// for each byte, on plain text and on a stream of escape characters,
+// less the cost of calling an empty watch, and print
+//   bench=escape_watch ... and bench=escape_watch_plus ...
+// in the same format as UART0_BenchWrite.
+// Input: none
+// Output: none
+void UART0_BenchEscape(void);
+
+//------------UART0_BenchTmpl------------
+// Count the instructions and cycles of each UART0 operation made through
+// the runtime-base uart.c call and through Uart<UART0_BASE>, and print
+//   bench=tmpl_<op> lib_instr=<n> tmpl_instr=<n> lib_cyc=<n> tmpl_cyc=<n>
+// per call, with the cost of the counter reads themselves removed. The
+// operations leave UART0 (the polled console) as it was, though any
+// character typed meanwhile is consumed.
+// Input: none
+// Output: none
+void UART0_BenchTmpl(void);
+
+#endif /* UARTBENCH_H_ */
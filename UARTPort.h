@@ -0,0 +1,168 @@
+/*
+ * UARTPort.h
+ *
+ *  Any of the eight TM4C123 UARTs as a BufferedUART. The port is chosen
+ *  by its base address as a template argument, so the clock gate bits,
+ *  GPIO port, pin mux values and register addresses used to bring it up
+ *  are constants folded in at compile time (see UartRegs.h), and each
+ *  instance gets its own vector that needs no lookup to find its object.
+ *
+ *  Usage:
+ *    UARTPort<UART3_BASE> Sensor;
+ *    Sensor.open(115200);              // PC6/PC7, 8N1, FIFOs, ISR on
+ *    Sensor.read(...); Sensor.write(...);
+ *
+ *  Only instantiated ports cost RAM (two rings each). UART0 and UART1
+ *  keep their UART0_Buffered/UART1_Buffered objects and Init functions.
+ */
+
+#ifndef UARTPORT_H_
+#define UARTPORT_H_
+
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "BaudRate.h"
+#include "BufferedUART.h"
+#include "SysClock.h"
+#include "UartRegs.h"
+
+#define UART_PORTS          8
+
+// Pins of one UART on the TM4C123GH6PM. These are the default pins from
+// the datasheet's pin mux table, chosen so all eight ports can be used at
+// once (UART1's alternate PC4/PC5 belong to UART4 here).
+struct UARTPinMux {
+    uint32_t gpioBase;
+    uint32_t gpioClock;                 // RCGCGPIO/PRGPIO bit
+    uint32_t pins;                      // RX | TX pin mask
+    bool locked;                        // a pin sits behind the commit lock
+                                        // (PD7, the NMI pin)
+};
+
+constexpr UARTPinMux UARTPinTable[UART_PORTS] = {
+    {GPIO_PORTA_BASE, 0x01, 0x03, false},    // PA0/PA1
+    {GPIO_PORTB_BASE, 0x02, 0x03, false},    // PB0/PB1
+    {GPIO_PORTD_BASE, 0x08, 0xC0, true},     // PD6/PD7
+    {GPIO_PORTC_BASE, 0x04, 0xC0, false},    // PC6/PC7
+    {GPIO_PORTC_BASE, 0x04, 0x30, false},    // PC4/PC5
+    {GPIO_PORTE_BASE, 0x10, 0x30, false},    // PE4/PE5
+    {GPIO_PORTD_BASE, 0x08, 0x30, false},    // PD4/PD5
+    {GPIO_PORTE_BASE, 0x10, 0x03, false},    // PE0/PE1
+};
+
+namespace UARTPortMap {
+
+// PCTL value with the 4 bit field of every pin in the mask set to func
+constexpr uint32_t pctl(uint32_t pins, uint32_t func, uint32_t pin = 0){
+    return (pin == 8) ? 0 :
+           (((pins >> pin) & 1) ? (func << (4 * pin)) : 0) |
+           pctl(pins, func, pin + 1);
+}
+
+} // namespace UARTPortMap
+
+template <uint32_t BASE>
+class UARTPort : public BufferedUART {
+    typedef Uart<BASE> Regs;
+
+public:
+    static const uint32_t INDEX = Regs::INDEX;
+
+    UARTPort(void) : BufferedUART(BASE) {}
+
+    //------------open------------
+    // Gate on the UART and GPIO clocks, mux the pins, program the baud
+    // rate from UART_CLOCK_HZ with 8 bit words, no parity, one stop bit
+    // and FIFOs enabled, then start the buffered ISR
+    // Input: baud rate
+    // Output: false (port untouched) if the rate is not reachable within
+    //         BAUD_MAX_ERROR_PPM
+    bool open(uint32_t baud){
+        const UARTPinMux &mux = UARTPinTable[INDEX];
+        if((baud == 0) || (baud > BaudCalc::maxBaud(UART_CLOCK_HZ)) ||
+           (BaudCalc::errorPpm(UART_CLOCK_HZ, baud) > BAUD_MAX_ERROR_PPM)){
+            return false;
+        }
+        HWREG(SYSCTL_RCGCGPIO) |= mux.gpioClock;
+        Regs::clockEnable();
+        while((HWREG(SYSCTL_PRGPIO) & mux.gpioClock) == 0);
+
+        HWREG(BASE + UART_O_CTL) &= ~UART_CTL_UARTEN;
+        HWREG(BASE + UART_O_CC) = UART_CLOCK_CS;
+        setBaud(baud);
+        HWREG(BASE + UART_O_LCRH) = UART_LCRH_WLEN_8 | UART_LCRH_FEN;
+        HWREG(BASE + UART_O_CTL) |= UART_CTL_UARTEN;
+
+        if(mux.locked){
+            HWREG(mux.gpioBase + GPIO_LOCK) = GPIO_LOCK_KEY;
+            HWREG(mux.gpioBase + GPIO_CR) |= mux.pins;
+            HWREG(mux.gpioBase + GPIO_LOCK) = 0;
+        }
+        HWREG(mux.gpioBase + GPIO_AFSEL) |= mux.pins;
+        HWREG(mux.gpioBase + GPIO_DEN) |= mux.pins;
+        HWREG(mux.gpioBase + GPIO_PCTL) =
+            (HWREG(mux.gpioBase + GPIO_PCTL) &
+             ~UARTPortMap::pctl(mux.pins, 0xF)) |
+            UARTPortMap::pctl(mux.pins, 1);
+        HWREG(mux.gpioBase + GPIO_AMSEL) &= ~mux.pins;
+
+        s_port = this;
+        init(Handler);
+        return true;
+    }
+
+    //------------setBaud------------
+    // Reprogram the divisors; the line must be idle. A new LCRH write
+    // latches them, so the current line settings are written back.
+    // Input: baud rate, already checked by the caller
+    // Output: none
+    void setBaud(uint32_t baud){
+        HWREG(BASE + UART_O_IBRD) = BaudCalc::ibrd(UART_CLOCK_HZ, baud);
+        HWREG(BASE + UART_O_FBRD) = BaudCalc::fbrd(UART_CLOCK_HZ, baud);
+        if(BaudCalc::hse(UART_CLOCK_HZ, baud)){
+            HWREG(BASE + UART_O_CTL) |= UART_CTL_HSE;
+        }else{
+            HWREG(BASE + UART_O_CTL) &= ~UART_CTL_HSE;
+        }
+        HWREG(BASE + UART_O_LCRH) = HWREG(BASE + UART_O_LCRH);
+    }
+
+    //------------close------------
+    // Stop the ISR and the UART and gate its clock; the pins stay muxed
+    // Input: none
+    // Output: none
+    void close(void){
+        Regs::nvicDisable();
+        HWREG(BASE + UART_O_IM) = 0;
+        HWREG(BASE + UART_O_CTL) &= ~UART_CTL_UARTEN;
+        Regs::clockDisable();
+    }
+
+private:
+    // GPIO register offsets; there is no hw_gpio.h in this tree
+    enum {
+        GPIO_AFSEL = 0x420,
+        GPIO_DEN = 0x51C,
+        GPIO_LOCK = 0x520,
+        GPIO_CR = 0x524,
+        GPIO_AMSEL = 0x528,
+        GPIO_PCTL = 0x52C
+    };
+    static const uint32_t GPIO_LOCK_KEY = 0x4C4F434B;
+#ifdef UART_CLOCK_PIOSC
+    static const uint32_t UART_CLOCK_CS = UART_CC_CS_PIOSC;
+#else
+    static const uint32_t UART_CLOCK_CS = UART_CC_CS_SYSCLK;
+#endif
+
+    static void Handler(void){ s_port->handleInterrupt(); }
+    static UARTPort *s_port;
+};
+
+template <uint32_t BASE>
+UARTPort<BASE> *UARTPort<BASE>::s_port = 0;
+
+#endif /* UARTPORT_H_ */
@@ -0,0 +1,206 @@
+/*
+ * UartRegs.h
+ *
+ *  Header-only register access for one TM4C123 UART, chosen by base
+ *  address as a template argument. It mirrors the uart.c calls used in
+ *  this project, but the base, interrupt number, clock gate bit and NVIC
+ *  word are all compile time constants: nothing is looked up, nothing is
+ *  checked at run time, and each call inlines to a load or store (plus a
+ *  mask or a status poll) at a fixed address. The TM4C129 variants of
+ *  uart.c are not carried over.
+ *
+ *  Usage:
+ *    typedef Uart<UART3_BASE> U3;
+ *    U3::clockEnable();
+ *    U3::configure<UART_CLOCK_HZ, 115200>(UART_LCRH_WLEN_8);
+ *    if(U3::charsAvail()) c = U3::charGetNonBlocking();
+ *
+ *  Like driverlib, this is stateless; use BufferedUART/UARTPort for a
+ *  buffered, interrupt-driven port.
+ */
+
+#ifndef UARTREGS_H_
+#define UARTREGS_H_
+
+#include <stdint.h>
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "hw_uart.h"
+#include "BaudRate.h"
+
+namespace UartMap {
+
+constexpr bool valid(uint32_t base){
+    return (base >= UART0_BASE) && (base <= UART7_BASE) &&
+           ((base & 0xFFF) == 0);
+}
+
+// UART0..7 sit 4 KB apart
+constexpr uint32_t index(uint32_t base){
+    return (base - UART0_BASE) >> 12;
+}
+
+// TM4C123 interrupt number of UART0..7
+constexpr uint32_t vector(uint32_t index){
+    return (index == 0) ? INT_UART0_TM4C123 :
+           (index == 1) ? INT_UART1_TM4C123 :
+           (index == 2) ? INT_UART2_TM4C123 :
+           (index == 3) ? INT_UART3_TM4C123 :
+           (index == 4) ? INT_UART4_TM4C123 :
+           (index == 5) ? INT_UART5_TM4C123 :
+           (index == 6) ? INT_UART6_TM4C123 : INT_UART7_TM4C123;
+}
+
+} // namespace UartMap
+
+template <uint32_t BASE>
+struct Uart {
+    static_assert(UartMap::valid(BASE), "not a TM4C123 UART base");
+
+    static const uint32_t INDEX = UartMap::index(BASE);
+    static const uint32_t INT_NUM = UartMap::vector(INDEX);
+    static const uint32_t CLOCK_BIT = 1u << INDEX;  // RCGCUART/PRUART
+
+    //------------clockEnable------------
+    // Gate on the UART clock and wait for the peripheral to be ready
+    // Input: none
+    // Output: none
+    static inline void clockEnable(void){
+        HWREG(SYSCTL_RCGCUART) |= CLOCK_BIT;
+        while((HWREG(SYSCTL_PRUART) & CLOCK_BIT) == 0);
+    }
+
+    static inline void clockDisable(void){
+        HWREG(SYSCTL_RCGCUART) &= ~CLOCK_BIT;
+    }
+
+    //------------configure------------
+    // UARTConfigSetExpClk with the divisors worked out by the compiler;
+    // a rate the clock cannot reach is a build error (see BaudDivisor)
+    // Input: CLOCK UART clock in Hz, BAUD rate; config is the LCRH word
+    //        length, parity and stop bits (UART_LCRH_* bits)
+    // Output: none; the UART is left enabled with FIFOs on
+    template <uint32_t CLOCK, uint32_t BAUD>
+    static inline void configure(uint32_t config){
+        typedef BaudDivisor<CLOCK, BAUD> Divisor;
+        disable();
+        if(Divisor::HSE){
+            HWREG(BASE + UART_O_CTL) |= UART_CTL_HSE;
+        }else{
+            HWREG(BASE + UART_O_CTL) &= ~UART_CTL_HSE;
+        }
+        HWREG(BASE + UART_O_IBRD) = Divisor::IBRD;
+        HWREG(BASE + UART_O_FBRD) = Divisor::FBRD;
+        HWREG(BASE + UART_O_LCRH) = config;
+        HWREG(BASE + UART_O_FR) = 0;
+        enable();
+    }
+
+    //------------enable------------
+    // UARTEnable: FIFOs, transmitter and receiver on
+    static inline void enable(void){
+        HWREG(BASE + UART_O_LCRH) |= UART_LCRH_FEN;
+        HWREG(BASE + UART_O_CTL) |= UART_CTL_UARTEN | UART_CTL_TXE |
+                                    UART_CTL_RXE;
+    }
+
+    //------------disable------------
+    // UARTDisable: wait for the line to go idle, then stop the UART
+    static inline void disable(void){
+        while(HWREG(BASE + UART_O_FR) & UART_FR_BUSY);
+        HWREG(BASE + UART_O_LCRH) &= ~UART_LCRH_FEN;
+        HWREG(BASE + UART_O_CTL) &= ~(UART_CTL_UARTEN | UART_CTL_TXE |
+                                      UART_CTL_RXE);
+    }
+
+    static inline void fifoLevelSet(uint32_t txLevel, uint32_t rxLevel){
+        HWREG(BASE + UART_O_IFLS) = txLevel | rxLevel;
+    }
+
+    static inline bool charsAvail(void){
+        return (HWREG(BASE + UART_O_FR) & UART_FR_RXFE) == 0;
+    }
+
+    static inline bool spaceAvail(void){
+        return (HWREG(BASE + UART_O_FR) & UART_FR_TXFF) == 0;
+    }
+
+    static inline bool busy(void){
+        return (HWREG(BASE + UART_O_FR) & UART_FR_BUSY) != 0;
+    }
+
+    //------------charGetNonBlocking------------
+    // Output: the DR word (data plus error bits), -1 if the FIFO is empty
+    static inline int32_t charGetNonBlocking(void){
+        if(HWREG(BASE + UART_O_FR) & UART_FR_RXFE){
+            return -1;
+        }
+        return (int32_t)HWREG(BASE + UART_O_DR);
+    }
+
+    static inline int32_t charGet(void){
+        while(HWREG(BASE + UART_O_FR) & UART_FR_RXFE);
+        return (int32_t)HWREG(BASE + UART_O_DR);
+    }
+
+    //------------charPutNonBlocking------------
+    // Output: false if the TX FIFO is full and the byte was not queued
+    static inline bool charPutNonBlocking(uint8_t data){
+        if(HWREG(BASE + UART_O_FR) & UART_FR_TXFF){
+            return false;
+        }
+        HWREG(BASE + UART_O_DR) = data;
+        return true;
+    }
+
+    static inline void charPut(uint8_t data){
+        while(HWREG(BASE + UART_O_FR) & UART_FR_TXFF);
+        HWREG(BASE + UART_O_DR) = data;
+    }
+
+    static inline void intEnable(uint32_t flags){
+        HWREG(BASE + UART_O_IM) |= flags;
+    }
+
+    static inline void intDisable(uint32_t flags){
+        HWREG(BASE + UART_O_IM) &= ~flags;
+    }
+
+    static inline uint32_t intStatus(bool masked){
+        return masked ? HWREG(BASE + UART_O_MIS) : HWREG(BASE + UART_O_RIS);
+    }
+
+    static inline void intClear(uint32_t flags){
+        HWREG(BASE + UART_O_ICR) = flags;
+    }
+
+    static inline uint32_t rxErrorGet(void){
+        return HWREG(BASE + UART_O_RSR) & 0x0000000F;
+    }
+
+    static inline void rxErrorClear(void){
+        HWREG(BASE + UART_O_ECR) = 0;
+    }
+
+    //------------nvicEnable------------
+    // IntEnable(INT_NUM) without the run time range checks: one store to
+    // the NVIC set-enable word holding this UART's bit
+    static inline void nvicEnable(void){
+        HWREG(NVIC_SET_ENABLE + NVIC_WORD) = NVIC_BIT;
+    }
+
+    static inline void nvicDisable(void){
+        HWREG(NVIC_CLEAR_ENABLE + NVIC_WORD) = NVIC_BIT;
+    }
+
+private:
+    // NVIC EN0/DIS0, kept local so this header mixes with tm4c123gh6pm.h
+    static const uint32_t NVIC_SET_ENABLE = 0xE000E100;
+    static const uint32_t NVIC_CLEAR_ENABLE = 0xE000E180;
+    static const uint32_t NVIC_WORD = ((INT_NUM - 16) / 32) * 4;
+    static const uint32_t NVIC_BIT = 1u << ((INT_NUM - 16) % 32);
+};
+
+#endif /* UARTREGS_H_ */
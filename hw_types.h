@@ -44,7 +44,13 @@
 //
 // Macros for hardware access, both direct and via the bit-band region.
 //
+// A HOST_SIM build redirects every access into the simulated register file
+// in sim_regs.h so the drivers can be exercised off target.
+//
 //*****************************************************************************
+#ifdef HOST_SIM
+#include "sim_regs.h"
+#else
 #define HWREG(x)                                                              \
         (*((volatile uint32_t *)(x)))
 #define HWREGH(x)                                                             \
@@ -60,6 +66,7 @@
 #define HWREGBITB(x, b)                                                       \
         HWREGB(((uint32_t)(x) & 0xF0000000) | 0x02000000 |                    \
                (((uint32_t)(x) & 0x000FFFFF) << 5) | ((b) << 2))
+#endif
 
 //*****************************************************************************
 //
@@ -176,6 +176,11 @@ static __no_init void (*g_pfnRAMVectors[NUM_INTERRUPTS])(void) @ "VTABLE";
 #elif defined(sourcerygxx)
 static __attribute__((section(".cs3.region-head.ram")))
 void (*g_pfnRAMVectors[NUM_INTERRUPTS])(void) __attribute__ ((aligned(1024)));
+#elif defined(HOST_SIM)
+//
+// The host simulator dispatches interrupts straight from this table.
+//
+void (*g_pfnRAMVectors[NUM_INTERRUPTS])(void);
 #elif defined(ccs) || defined(DOXYGEN)
 #pragma DATA_ALIGN(g_pfnRAMVectors, 1024)
 #pragma DATA_SECTION(g_pfnRAMVectors, ".vtable")
@@ -308,8 +313,6 @@ IntMasterDisable(void)
 void
 IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
 {
-    uint32_t ui32Idx, ui32Value;
-
     //
     // Check the arguments.
     //
@@ -320,11 +323,14 @@ IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
     //
     ASSERT(((uint32_t)g_pfnRAMVectors & 0x000003ff) == 0);
 
+#ifndef HOST_SIM
     //
     // See if the RAM vector table has been initialized.
     //
     if(HWREG(NVIC_VTABLE) != (uint32_t)g_pfnRAMVectors)
     {
+        uint32_t ui32Idx, ui32Value;
+
         //
         // Copy the vector table from the beginning of FLASH to the RAM vector
         // table.
@@ -341,6 +347,7 @@ IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
         //
         HWREG(NVIC_VTABLE) = (uint32_t)g_pfnRAMVectors;
     }
+#endif
 
     //
     // Save the interrupt handler.
@@ -5,12 +5,24 @@
  *      Author: travp
  */
 
-#include <iostream>
-#include <stdio.h>
-#include "UART.h"
-#include <string>
-
-using namespace std;
+#include <stdint.h>
+#include <stdbool.h>
+#include "interrupt.h"
+#include "BufferedUART.h"
+#include "Bridge.h"
+#include "Cobs.h"
+#include "Escape.h"
+#include "FrameLink.h"
+#include "HalfDuplex.h"
+#include "Idle.h"
+#include "Profile.h"
+#include "SelfTest.h"
+#include "Shell.h"
+#include "hw_memmap.h"
+#include "StreamPrint.h"
+#include "SysClock.h"
+#include "Timebase.h"
+#include "UART0.h"
 
 #define SYSCTL_RCGCGPIO_R (*((volatile unsigned long *) 0x400FE608))
 #define GPIO_PORTF_DEN_R (*((volatile unsigned long *) 0x4002551C))
@@ -23,17 +35,100 @@ using namespace std;
 #define LED_ON1 0x02
 #define LED_ON2 0x04
 #define LED_ON3 0x08
-#define DELAY_VALUE 4000000
+enum state_machine {PCmode, enable_PC_mode, disable_PC_mode, receive_mode, transmit_mode};
 
-const uint32_t UART0_BASE_ADDRESS = 0x16000000;
-const uint32_t UART1_BASE_ADDRESS = 0x17000000;
+// PC (UART0) <-> device (UART1) forwarding engine used in PCmode
+UARTBridge bridge(UART0_Buffered, UART1_Buffered);
+
+// "+++" between guard times from the PC leaves the bridge for the
+// framed device link; the PC link then takes Hayes style commands
+EscapeDetector pcEscape(UART0_Buffered);
+
+// Half-duplex device link on UART1, transceiver direction on PB2
+const HalfDuplexConfig deviceLinkConfig = {
+    GPIO_PORTB_BASE, 0x04, 0x02,        // PB2, port B clock
+    100,                                // quiet time before driving (us)
+    0,                                  // release on end of transmission
+    4,                                  // frames per turn
+    UART_TX_BUFFER_SIZE                 // bytes per turn
+};
+HalfDuplexLink deviceLink(UART1_Buffered, deviceLinkConfig);
+
+// Echo each COBS frame the device sends back to it on its next turn.
+// The half-duplex scheduler owns the transmitter, so replies are encoded
+// into its frame store rather than written with UART1_Frames.write().
+static void EchoDeviceFrames(void){
+    uint8_t frame[FRAME_MAX_PAYLOAD];
+    uint8_t encoded[Cobs_EncodedMax(FRAME_MAX_PAYLOAD) + 1];
+    uint32_t len;
+
+    while((len = UART1_Frames.read(frame, sizeof(frame))) != 0){
+        deviceLink.queueFrame(encoded, Cobs_Encode(frame, len, encoded));
+    }
+}
 
-void Delay(void);
+// Command line on the PC link while the bridge is off; "ato" goes back
+// online (the bridge)
+static bool online = false;                 // ATO seen, waiting for the link
 
-enum state_machine {PCmode, enable_PC_mode, disable_PC_mode, receive_mode, transmit_mode};
+static bool CmdHelp(ByteStream &out, uint32_t, char *[]);
+
+static bool CmdOnline(ByteStream &, uint32_t, char *[]){
+    online = true;
+    return true;
+}
+
+static bool CmdProfile(ByteStream &out, uint32_t, char *[]){
+    Profile_Report(out);
+    return true;
+}
+
+static bool CmdIdle(ByteStream &out, uint32_t, char *[]){
+    Idle_Report(out);
+    return true;
+}
+
+static bool CmdUart(ByteStream &out, uint32_t, char *[]){
+    UART_Report(out, "uart0", UART0_Buffered.stats());
+    UART_Report(out, "uart1", UART1_Buffered.stats());
+    return true;
+}
+
+static bool CmdBridge(ByteStream &out, uint32_t, char *[]){
+    bridge.report(out);
+    return true;
+}
+
+static bool CmdSelfTest(ByteStream &out, uint32_t, char *[]){
+    SelfTest_Report(out);
+    return true;
+}
+
+constexpr ShellCommand Commands[] = {
+    {"help",     CmdHelp,     "help         this list"},
+    {"ato",      CmdOnline,   "ato          back to the bridge"},
+    {"uart",     CmdUart,     "uart         port counters"},
+    {"bridge",   CmdBridge,   "bridge       bridge counters"},
+    {"prof",     CmdProfile,  "prof         profiled sections"},
+    {"idle",     CmdIdle,     "idle         sleep statistics"},
+    {"selftest", CmdSelfTest, "selftest     loopback results"}
+};
+constexpr ShellIndex CommandIndex = Shell_Index(Commands);
+static_assert(CommandIndex.perfect, "command names collide");
+
+Shell console(UART0_Buffered, Commands, CommandIndex);
+
+static bool CmdHelp(ByteStream &out, uint32_t, char *[]){
+    console.help(out);
+    return true;
+}
 
 int main(void) {
 
+    SysClock_Init();                        // 80 MHz before any peripheral setup
+    Timebase_Init();                        // 1 ms SysTick
+    Profile_Init();                         // DWT counter for PROFILE_SCOPE sites
+
     SYSCTL_RCGCGPIO_R |= GPIO_PORTF_CLK_EN; //enable clock for PORTF
     GPIO_PORTF_DEN_R |= GPIO_PORTF_PIN1_EN; //enable pins 1 on PORTF
     GPIO_PORTF_DIR_R |= GPIO_PORTF_PIN1_EN; //make pins 1 as output pins
@@ -42,73 +137,94 @@ int main(void) {
     GPIO_PORTF_DEN_R |= GPIO_PORTF_PIN3_EN; //enable pins 3 on PORTF
     GPIO_PORTF_DIR_R |= GPIO_PORTF_PIN3_EN; //make pins 3 as output pins
 
-    //UART0_Init();
-
-    state_machine state = PCmode;
+    UART0_Init();
+    UART1_Init();
+    UART0_Buffered.init(UART0_Handler);
+    UART1_Buffered.init(UART1_Handler);
+    UART0_Buffered.setRxAdaptive(true);     // RX trigger follows the traffic
+    UART1_Buffered.setRxAdaptive(true);
+#ifdef UART1_RTSCTS
+    UART1_InitFlowPins();                   // device wired for RTS/CTS
+    UART1_Buffered.setFlowControl(UART_FLOW_RTSCTS);
+#elif defined(UART1_XONXOFF)
+    UART1_Buffered.setFlowControl(UART_FLOW_XONXOFF);   // text only device
+#endif
+#ifdef UART0_XONXOFF
+    UART0_Buffered.setFlowControl(UART_FLOW_XONXOFF);   // terminal on the PC
+#endif
+    IntMasterEnable();
+#ifdef UART1_SELFTEST
+    // device link in loopback up to its fastest clean rate, before any
+    // traffic; the result goes out on the PC link
+    SelfTest_Run(UART1_Buffered, UART1_BASE, SELFTEST_IRQ, UART1_Handler);
+    SelfTest_Report(UART0_Buffered);
+#endif
+    Idle_Init(IDLE_DEEP_SLEEP);             // WFI unless built with UART_CLOCK_PIOSC
+    Idle_Watch(UART0_Buffered);
+    Idle_Watch(UART1_Buffered);
+    Idle_Watch(UART1_Frames);
+
+    bridge.setDeviceLink(&deviceLink);      // half-duplex device
+    state_machine state = enable_PC_mode;
     state_machine next_state;
 
-    char temp;
-    string str = "user input: ";
-
-    UARTEnable(UART0_BASE_ADDRESS);
-    temp = UARTCharGet(UART0_BASE_ADDRESS);
-    UARTCharPut(UART0_BASE_ADDRESS, '+');
-    UARTCharPut(UART0_BASE_ADDRESS, temp);
-
     while(1) {
-        /*
         switch (state) {
 
             case PCmode:
-                next_state = disable_PC_mode
+                // PC and device talk through the bridge; both directions
+                // run concurrently out of the UART ISRs
+                bridge.pump();
+                deviceLink.poll();      // driver release after bridge bytes
+                if(pcEscape.poll()){
+                    next_state = disable_PC_mode;
+                    break;
+                }
+                // wake for the escape's closing guard time, if one is due
+                if(deviceLink.idle()){
+                    Idle_Enter(pcEscape.wakeMs());
+                }
+                next_state = PCmode;
+                break;
             case enable_PC_mode:
-                // disable UART1
-                // enable UART0
+                UART1_Frames.stop();            // bridge forwards raw bytes
+                deviceLink.passThrough();       // and drives PB2 for them
+                bridge.start();
+                pcEscape.start();
                 next_state = PCmode;
+                break;
             case disable_PC_mode:
-                // disable UART0
-                // enable UART1
-                next_state = receive_mode
+                // stop forwarding, device link only, framed with COBS
+                pcEscape.stop();
+                StreamPrint(UART0_Buffered, "OK\r\n");
+                console.start();
+                UART1_Frames.start();
+                deviceLink.start();
+                next_state = receive_mode;
+                break;
             case receive_mode:
-                // enable Rx pin
-                // disable Tx pin
             case transmit_mode:
-                // disable Rx pin
-                // enable Tx pin
+                // the link scheduler owns the Rx/Tx pin and switches
+                // direction itself; the state just mirrors it
+                EchoDeviceFrames();
+                deviceLink.poll();
+                console.poll();         // takes only what has arrived
+                if(online && (deviceLink.state() == LINK_RX)){
+                    online = false;     // between turns, back to the bridge
+                    next_state = enable_PC_mode;
+                    break;
+                }
+                if(deviceLink.idle() && console.idle()){
+                    Idle_Enter(IDLE_FOREVER);
+                }
+                next_state = deviceLink.transmitting() ? transmit_mode : receive_mode;
+                break;
             default: // should never occur
-                state = PCmode;
-        }
-
-        state = next_state
-
-        */
-
-
-
-
-        /*GPIO_PORTF_DATA_R = 0x02; //Turn on RED LED
-        Delay(); //Delay almost 1 sec
-        GPIO_PORTF_DATA_R = 0x00; //Turn off LED
-        Delay(); //Delay almost 1 sec*/
-
-        //temp = UART0_InChar();
-        //str = "User inputted: ";
-        //UART0_OutString(str);
-        for(int i=0; i<str.length(); i++){
-            //UART0_OutChar(str[i]);
+                next_state = PCmode;
+                break;
         }
-        //printf("test\n");
-        //UART0_OutChar(temp);
-        //UART0_OutChar('\n');
 
+        state = next_state;
     }
 }
 
-void Delay(void) {
-
-volatile unsigned long i;
-
-for(i=0;i<DELAY_VALUE;i++);
-
-}
-
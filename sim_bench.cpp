@@ -0,0 +1,2134 @@
+/*
+ * sim_bench.cpp
+ *
+ *  Throughput and latency benchmarks for the UART stack, run on the host
+ *  simulator (sim_tm4c.h). Each of the polled (UARTCharGet/UARTCharPut),
+ *  interrupt driven (BufferedUART) and DMA (DMAUART) paths is run at
+ *  several baud rates; the interrupt path is also swept over the FIFO
+ *  trigger levels set with UARTFIFOLevelSet and the adaptive RX level
+ *  (BufferedUART::setRxAdaptive). The DMA path always runs at
+ *  the half-full level its burst size is matched to, and the polled path
+ *  does not use the trigger level at all.
+ *
+ *  Workloads, one key=value line per run on stdout:
+ *    bench=echo    the host streams BENCH_ECHO_BYTES into UART0 back to
+ *                  back and the firmware echoes them. Reports sustained
+ *                  bytes_per_s (first byte in to last byte out) and the
+ *                  share of the line rate (line_pct, in tenths of a
+ *                  percent), cpu_cycles not spent in WFI and the same per
+ *                  byte, UART0 RX interrupts per KiB received, UART0 ISR
+ *                  latency and lost bytes.
+ *    bench=bridge  single bytes forwarded UART0 -> UART1 with the line
+ *                  idle in between. lat_* is from the stop bit arriving
+ *                  on UART0 to the stop bit leaving UART1, so it includes
+ *                  one frame of transmit time.
+ *    bench=frames  COBS frames with line noise between them sent to
+ *                  UART1, decoded by FrameLink in the RX ISR and written
+ *                  back; counts frames that came back intact.
+ *    bench=hub     seven devices on UART1..7 fanned in to a framed PC link
+ *                  on UART0 (UARTHub), streaming up and down at once;
+ *                  every byte must reach the right end in order.
+ *    bench=rx_errors  bytes sent at the wrong baud and an RX FIFO overrun
+ *                  forced by masking interrupts; the driver's framing and
+ *                  overrun counters must agree with the line model.
+ *    bench=flow    a device on UART1 at 8x the PC's rate floods the bridge
+ *                  toward the slower PC link, then holds CTS off (or
+ *                  sends XOFF) while the PC sends. With RTS/CTS or
+ *                  XON/XOFF every byte must arrive; the mode=none run
+ *                  shows what is lost without it.
+ *    bench=flow_mutual  UART0 and UART1 wired together, both in
+ *                  XON/XOFF, both flooding the other while neither reads
+ *                  for a while, so each stops the other and must still
+ *                  get its XON out; every byte must arrive, in order.
+ *    bench=multidrop  a master on UART1 polls six slaves on UART2..7
+ *                  sharing one bus, with 9-bit hardware addressing and
+ *                  with a software address byte. slave_* is the load on
+ *                  one slave: ISR entries, ISR cycles and bytes its ISR
+ *                  handled.
+ *    bench=autobaud  UART1 negotiates its rate with a slave on UART0 over
+ *                  a line that only carries 1 Mbaud, then only 500 kbaud:
+ *                  both ends must settle on the fastest rate below the
+ *                  limit, with echoed application frames intact while
+ *                  the line is clean.
+ *    bench=selftest  UART1 in internal loopback up the AutoBaud ladder
+ *                  through each driver: every rate the clock can make
+ *                  must loop back clean, with the port's own settings
+ *                  put back afterwards. cyc_per_byte is the driver's CPU
+ *                  cost at the top rate.
+ *    bench=escape  "+++" escape sequences from the host on UART0 with the
+ *                  guard times met and broken in turn; latency_us is from
+ *                  the last '+' reaching the FIFO to poll() reporting it.
+ *                  Every byte must still reach the RX ring. The sim
+ *                  only charges register accesses, so the detector's
+ *                  cost per byte comes from UART0_BenchEscape().
+ *    bench=shell   keystrokes typed into a Shell on UART0, one line per
+ *                  editing case: the argv the command saw must match,
+ *                  and unknown commands and bad arguments must answer.
+ *                  A report longer than the TX ring must come out whole,
+ *                  over several polls: poll_max_cycles, the longest
+ *                  single poll(), must stay under BENCH_SHELL_POLL_MAX.
+ *    bench=uart_tmpl  the Uart<Base> template must leave every UART's
+ *                  registers and NVIC enables exactly as the uart.c calls
+ *                  it replaces do, and echo bytes on UART0. Instruction
+ *                  counts against driverlib come from UART0_BenchTmpl().
+ *    bench=ring    RingBuffer on its own: random put/get/write/read/
+ *                  discard/poke+commit against a reference queue, so the
+ *                  indices wrap the storage and hit full and empty many
+ *                  times; then a producer and a consumer thread stream
+ *                  BENCH_RING_BYTES through it in random sized chunks.
+ *                  full_hits/empty_hits count refused writes and reads.
+ *    bench=profile  the profiler's aggregation, with the cycle counter
+ *                  set directly around each ProfileScope: count, min,
+ *                  max, mean and the log2 bucket edges, the report line,
+ *                  Profile_Reset, a start that wraps the counter, and a
+ *                  site past PROFILE_MAX_SITES staying out of the table.
+ *    bench=cobs_fuzz  randomized encode/decode round trips, resync after
+ *                  noise and length limit checks on the COBS codec.
+ *    bench=cobs_encode/cobs_decode  host nanoseconds per byte; the
+ *                  cycle cost on target comes from UART0_BenchCOBS().
+ *    bench=crc_check  check values, and every CRC form agreeing over
+ *                  random lengths, alignments and split points.
+ *    bench=crc16_.../crc32_...  host nanoseconds per byte for the per-byte,
+ *                  bytewise table and slicing-by-4 forms; on target see
+ *                  UART0_BenchCRC().
+ *  Cycle counts are simulator cycles (see sim_tm4c.h): good for spotting
+ *  regressions between runs, not absolute silicon figures.
+ *
+ *  Host build and run, from the repository root; builds without warnings
+ *  and exits non-zero if any run lost or corrupted data:
+ *    g++ -std=c++14 -O2 -Wall -Wextra -pthread -DHOST_SIM -I. -x c++ \
+ *        sim_regs.c sim_tm4c.cpp interrupt.c uart.c uDMA.cpp BufferedUART.cpp \
+ *        DMAUART.cpp Bridge.cpp HalfDuplex.cpp StreamPrint.cpp \
+ *        SysClock.cpp Cobs.cpp FrameLink.cpp Crc.cpp Hub.cpp Multidrop.cpp \
+ *        AutoBaud.cpp PolledUART.cpp SelfTest.cpp Timebase.cpp Escape.cpp \
+ *        Shell.cpp Profile.cpp sim_bench.cpp -o bench
+ *    ./bench
+ */
+
+#ifdef HOST_SIM
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <thread>
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_nvic.h"
+#include "hw_types.h"
+#include "cpu.h"
+#include "interrupt.h"
+#include "uart.h"
+#include "AutoBaud.h"
+#include "BufferedUART.h"
+#include "Bridge.h"
+#include "Cobs.h"
+#include "Crc.h"
+#include "DMAUART.h"
+#include "Escape.h"
+#include "FrameLink.h"
+#include "Hub.h"
+#include "Multidrop.h"
+#include "PolledUART.h"
+#include "Profile.h"
+#include "RingBuffer.h"
+#include "SelfTest.h"
+#include "Shell.h"
+#include "SysClock.h"
+#include "Timebase.h"
+#include "UartRegs.h"
+#include "UARTPort.h"
+#include "sim_tm4c.h"
+
+#define BENCH_ECHO_BYTES    1024
+#define BENCH_BRIDGE_BYTES  32
+#define BENCH_GAP_FRAMES    4           // idle line between bridge samples
+#define BENCH_CHUNK         256
+#define BENCH_FRAMES        64          // frames per FrameLink run
+#define BENCH_FRAME_MAX     64          // payload bytes, at most
+#define BENCH_FUZZ_FRAMES   20000
+#define BENCH_FUZZ_MAX      (3 * COBS_BLOCK)
+#define BENCH_CODEC_ROUNDS  20000
+#define BENCH_CRC_TRIALS    5000
+#define BENCH_CRC_BYTES     1024
+#define BENCH_RING_SIZE     16          // small, so every op nears an edge
+#define BENCH_RING_OPS      200000      // random ops against the model
+#define BENCH_RING_BYTES    (1u << 20)  // through the two thread run
+#define BENCH_HUB_BYTES     200         // each way, per device
+#define BENCH_HUB_DOWN      32          // payload bytes per PC frame
+#define BENCH_HUB_PC_BAUD   921600
+#define BENCH_HUB_DEV_BAUD  115200
+#define BENCH_FLOW_BYTES    1024        // each way
+#define BENCH_FLOW_PC_BAUD  115200
+#define BENCH_FLOW_DEV_BAUD 921600
+#define BENCH_FLOW_HOLD     64          // PC frames the device holds CTS off
+                                        // (or stays in XOFF)
+#define BENCH_MUTUAL_BAUD   115200
+#define BENCH_MUTUAL_HOLD   1024        // frames both readers stay away
+#define BENCH_MUTUAL_READ   8           // bytes each reader takes per frame
+#define BENCH_DROP_BAUD     115200
+#define BENCH_DROP_SLAVES   6           // on UART2..7, addresses 1..6
+#define BENCH_DROP_ROUNDS   20          // polls per slave
+#define BENCH_DROP_PAYLOAD  16          // bytes each way per poll
+#define BENCH_AB_LIMIT      1000000     // line limit, then half of it
+#define BENCH_AB_CLEAN_MS   1000        // sim time at each limit
+#define BENCH_AB_DEGRADE_MS 2000
+#define BENCH_AB_APP_BYTES  48          // application frame payload
+#define BENCH_ESC_GUARD_MS  20
+#define BENCH_ESC_STEPS     3
+#define BENCH_SHELL_OUT     1024        // terminal output kept per case
+#define BENCH_SHELL_POLL_MAX 2000       // longest poll() allowed, cycles
+#define BENCH_UART_REGS     6           // registers compared per port
+#define BENCH_NVIC_WORDS    5
+
+enum BenchPath {
+    BENCH_POLLED,
+    BENCH_IRQ,
+    BENCH_DMA
+};
+
+struct BenchFifo {
+    uint32_t ui32Tx;
+    uint32_t ui32Rx;                    // starting level when adaptive
+    bool bAdaptive;
+    const char *pcName;
+};
+
+static const char *const g_ppcPathName[] = {"polled", "irq", "dma"};
+static const uint32_t g_pui32Baud[] = {115200, 921600, 3000000};
+static const BenchFifo g_psFifo[] = {
+    {UART_FIFO_TX1_8, UART_FIFO_RX1_8, false, "1/8"},
+    {UART_FIFO_TX4_8, UART_FIFO_RX4_8, false, "4/8"},
+    {UART_FIFO_TX7_8, UART_FIFO_RX7_8, false, "7/8"},
+    {UART_FIFO_TX4_8, UART_FIFO_RX1_8, true, "adaptive"},
+};
+#define BENCH_BAUDS (sizeof(g_pui32Baud) / sizeof(g_pui32Baud[0]))
+#define BENCH_FIFOS (sizeof(g_psFifo) / sizeof(g_psFifo[0]))
+
+// Bytes read from one stream and not yet accepted by the other
+static uint8_t g_pui8Pend[BENCH_CHUNK];
+static uint32_t g_ui32PendLen;
+static uint32_t g_ui32PendOff;
+
+// DMA sources must be static data (SimBusAddr window)
+static uint8_t g_pui8Pattern[BENCH_ECHO_BYTES];
+static uint8_t g_pui8Echo[BENCH_ECHO_BYTES];
+
+static uint32_t g_ui32Failures;
+
+static ByteStream &Stream(BenchPath ePath, uint32_t ui32Port){
+    if(ePath == BENCH_DMA){
+        return ui32Port ? (ByteStream &)UART1_DMA : (ByteStream &)UART0_DMA;
+    }
+    return ui32Port ? (ByteStream &)UART1_Buffered :
+                      (ByteStream &)UART0_Buffered;
+}
+
+static const UARTStats &Stats(BenchPath ePath, uint32_t ui32Port){
+    if(ePath == BENCH_DMA){
+        return ui32Port ? UART1_DMA.stats() : UART0_DMA.stats();
+    }
+    return ui32Port ? UART1_Buffered.stats() : UART0_Buffered.stats();
+}
+
+//------------BenchSetup------------
+// Start a fresh simulation with UART0 and UART1 at the given rate,
+// driven by the chosen path
+// Input: ePath, ui32Baud, psFifo trigger levels (interrupt path only)
+// Output: none
+static void BenchSetup(BenchPath ePath, uint32_t ui32Baud,
+                       const BenchFifo *psFifo){
+    static const uint32_t pui32Base[2] = {UART0_BASE, UART1_BASE};
+    uint8_t pui8Stale[BENCH_CHUNK];
+
+    SimInit(SYSCLOCK_HZ);
+    SysClock_Init();
+    for(uint32_t i = 0; i < 2; i++){
+        UARTConfigSetExpClk(pui32Base[i], SysClock_Get(), ui32Baud,
+                            UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                            UART_CONFIG_PAR_NONE);
+    }
+    if(ePath == BENCH_IRQ){
+        UART0_Buffered.init(UART0_Handler);
+        UART1_Buffered.init(UART1_Handler);
+        UARTFIFOLevelSet(UART0_BASE, psFifo->ui32Tx, psFifo->ui32Rx);
+        UARTFIFOLevelSet(UART1_BASE, psFifo->ui32Tx, psFifo->ui32Rx);
+        UART0_Buffered.setRxAdaptive(psFifo->bAdaptive);
+        UART1_Buffered.setRxAdaptive(psFifo->bAdaptive);
+    }else if(ePath == BENCH_DMA){
+        UART0_DMA.init(UART0_DMAHandler);
+        UART1_DMA.init(UART1_DMAHandler);
+    }
+    if(ePath != BENCH_POLLED){
+        // Anything a previous run left in the driver rings
+        for(uint32_t i = 0; i < 2; i++){
+            while(Stream(ePath, i).read(pui8Stale, sizeof(pui8Stale)));
+        }
+    }
+    g_ui32PendLen = 0;
+    g_ui32PendOff = 0;
+    IntMasterEnable();
+}
+
+//------------Forward------------
+// Move what sSrc has received into sDst, or sleep until an interrupt if
+// there is nothing to do
+// Input: sSrc, sDst streams, the same one for an echo
+// Output: false once the simulation has nothing left scheduled
+static bool Forward(ByteStream &sSrc, ByteStream &sDst){
+    if(g_ui32PendOff == g_ui32PendLen){
+        g_ui32PendLen = sSrc.read(g_pui8Pend, sizeof(g_pui8Pend));
+        g_ui32PendOff = 0;
+    }
+    if(g_ui32PendOff < g_ui32PendLen){
+        uint32_t ui32Sent = sDst.write(&g_pui8Pend[g_ui32PendOff],
+                                       g_ui32PendLen - g_ui32PendOff);
+        g_ui32PendOff += ui32Sent;
+        if(ui32Sent != 0){
+            return true;
+        }
+    }else if(sSrc.available() != 0){
+        return true;
+    }
+
+    // Blocked on the line: the same check-then-WFI pattern as Idle_Enter
+    uint64_t ui64Before = SimNow();
+    CPUcpsid();
+    if(sSrc.available() == 0){
+        CPUwfi();
+    }
+    CPUcpsie();
+    return SimNow() != ui64Before;
+}
+
+static void PollEcho(void){
+    if(UARTCharsAvail(UART0_BASE)){
+        UARTCharPut(UART0_BASE, (unsigned char)UARTCharGet(UART0_BASE));
+    }
+}
+
+static void PollBridge(void){
+    if(UARTCharsAvail(UART0_BASE)){
+        UARTCharPut(UART1_BASE, (unsigned char)UARTCharGet(UART0_BASE));
+    }
+}
+
+static uint64_t FrameCycles(uint32_t ui32Baud){
+    return ((uint64_t)SYSCLOCK_HZ * 10) / ui32Baud;
+}
+
+static void PrintIsr(void){
+    const SimIrqStats *psIrq = SimIrqGetStats(INT_UART0_TM4C123);
+    printf(" isr_n=%u isr_lat_mean=%llu isr_lat_max=%u", psIrq->ui32Count,
+           psIrq->ui32Count ?
+           (unsigned long long)(psIrq->ui64TotalLatency / psIrq->ui32Count) :
+           0ULL,
+           psIrq->ui32MaxLatency);
+}
+
+//------------BenchEcho------------
+// Stream BENCH_ECHO_BYTES through UART0 and back and print the result
+// Input: ePath, ui32Baud, psFifo as for BenchSetup
+// Output: none
+static void BenchEcho(BenchPath ePath, uint32_t ui32Baud,
+                      const BenchFifo *psFifo){
+    uint32_t ui32Got = 0;
+    bool bLive = true;
+
+    BenchSetup(ePath, ui32Baud, psFifo);
+    uint64_t ui64Deadline = SimNow() +
+                            FrameCycles(ui32Baud) * BENCH_ECHO_BYTES * 4;
+    uint64_t ui64Start = SimNow();
+    uint64_t ui64Slept = SimSleepCycles();
+    uint32_t ui32RxIrqs = Stats(ePath, 0).rxInterrupts;
+    SimUARTHostWrite(0, g_pui8Pattern, BENCH_ECHO_BYTES);
+
+    while(bLive && (ui32Got < BENCH_ECHO_BYTES) && (SimNow() < ui64Deadline)){
+        if(ePath == BENCH_POLLED){
+            PollEcho();
+        }else{
+            bLive = Forward(Stream(ePath, 0), Stream(ePath, 0));
+        }
+        ui32Got += SimUARTHostRead(0, &g_pui8Echo[ui32Got],
+                                   BENCH_ECHO_BYTES - ui32Got);
+    }
+
+    const SimUARTStats *psLine = SimUARTGetStats(0);
+    uint64_t ui64Elapsed = psLine->ui64LastTx - ui64Start;
+    uint64_t ui64Busy = (SimNow() - ui64Start) -
+                        (SimSleepCycles() - ui64Slept);
+    uint64_t ui64Rate = ui64Elapsed ?
+                        ((uint64_t)ui32Got * SYSCLOCK_HZ) / ui64Elapsed : 0;
+    ui32RxIrqs = Stats(ePath, 0).rxInterrupts - ui32RxIrqs;
+    uint32_t ui32Bad = BENCH_ECHO_BYTES - ui32Got;
+    for(uint32_t i = 0; i < ui32Got; i++){
+        if(g_pui8Echo[i] != g_pui8Pattern[i]){
+            ui32Bad++;
+        }
+    }
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+
+    printf("bench=echo path=%s baud=%u fifo=%s bytes=%u bytes_per_s=%llu"
+           " line_pct=%llu cpu_cycles=%llu cpu_cyc_per_byte=%llu",
+           g_ppcPathName[ePath], ui32Baud, psFifo->pcName, ui32Got,
+           (unsigned long long)ui64Rate,
+           (unsigned long long)(ui64Rate * 1000 / ui32Baud),
+           (unsigned long long)ui64Busy,
+           (unsigned long long)(ui32Got ? ui64Busy / ui32Got : 0));
+    printf(" rx_irq_per_kb=%u", ui32Got ? (ui32RxIrqs * 1024) / ui32Got : 0);
+    PrintIsr();
+    printf(" overruns=%u errors=%u\n", psLine->ui32Overruns, ui32Bad);
+}
+
+//------------BenchBridge------------
+// Forward single bytes UART0 -> UART1 and print the latency spread
+// Input: ePath, ui32Baud, psFifo as for BenchSetup
+// Output: none
+static void BenchBridge(BenchPath ePath, uint32_t ui32Baud,
+                        const BenchFifo *psFifo){
+    static UARTBridge sBridge(UART0_Buffered, UART1_Buffered);
+    uint64_t ui64Min = UINT64_MAX;
+    uint64_t ui64Max = 0;
+    uint64_t ui64Total = 0;
+    uint32_t ui32Samples = 0;
+    uint32_t ui32Bad = 0;
+
+    BenchSetup(ePath, ui32Baud, psFifo);
+    if(ePath == BENCH_IRQ){
+        sBridge.start();
+    }
+    for(uint32_t n = 0; n < BENCH_BRIDGE_BYTES; n++){
+        uint8_t ui8Byte = g_pui8Pattern[n];
+        uint8_t ui8Out = 0;
+        uint32_t ui32Sent = SimUARTGetStats(1)->ui32TxBytes;
+        uint64_t ui64Deadline = SimNow() + FrameCycles(ui32Baud) * 64;
+        bool bLive = true;
+
+        SimUARTHostWrite(0, &ui8Byte, 1);
+        while(bLive && (SimUARTGetStats(1)->ui32TxBytes == ui32Sent) &&
+              (SimNow() < ui64Deadline)){
+            if(ePath == BENCH_POLLED){
+                PollBridge();
+            }else if(ePath == BENCH_IRQ){
+                if(sBridge.pump() == 0){
+                    uint64_t ui64Before = SimNow();
+                    CPUcpsid();
+                    if(UART0_Buffered.available() == 0){
+                        CPUwfi();
+                    }
+                    CPUcpsie();
+                    bLive = SimNow() != ui64Before;
+                }
+            }else{
+                bLive = Forward(UART0_DMA, UART1_DMA);
+            }
+        }
+        if((SimUARTHostRead(1, &ui8Out, 1) != 1) || (ui8Out != ui8Byte)){
+            ui32Bad++;
+            continue;
+        }
+        uint64_t ui64Latency = SimUARTGetStats(1)->ui64LastTx -
+                               SimUARTGetStats(0)->ui64LastRx;
+        if(ui64Latency < ui64Min) ui64Min = ui64Latency;
+        if(ui64Latency > ui64Max) ui64Max = ui64Latency;
+        ui64Total += ui64Latency;
+        ui32Samples++;
+        SimAdvance(FrameCycles(ui32Baud) * BENCH_GAP_FRAMES);
+    }
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+
+    uint64_t ui64Mean = ui32Samples ? ui64Total / ui32Samples : 0;
+    printf("bench=bridge path=%s baud=%u fifo=%s samples=%u lat_min=%llu"
+           " lat_mean=%llu lat_max=%llu lat_us=%llu",
+           g_ppcPathName[ePath], ui32Baud, psFifo->pcName, ui32Samples,
+           (unsigned long long)(ui32Samples ? ui64Min : 0),
+           (unsigned long long)ui64Mean, (unsigned long long)ui64Max,
+           (unsigned long long)(ui64Mean / (SYSCLOCK_HZ / 1000000)));
+    PrintIsr();
+    printf(" errors=%u\n", ui32Bad);
+}
+
+// xorshift32, fixed seed so a failure reproduces
+static uint32_t g_ui32Seed = 0x2545F491;
+
+static uint32_t Random(void){
+    g_ui32Seed ^= g_ui32Seed << 13;
+    g_ui32Seed ^= g_ui32Seed >> 17;
+    g_ui32Seed ^= g_ui32Seed << 5;
+    return g_ui32Seed;
+}
+
+// Random payload; one in 2^ui32ZeroLog2 bytes is zero (0 = no zeros)
+static void RandomPayload(uint8_t *pui8Data, uint32_t ui32Len,
+                          uint32_t ui32ZeroLog2){
+    for(uint32_t i = 0; i < ui32Len; i++){
+        uint32_t ui32R = Random();
+        bool bZero = ui32ZeroLog2 &&
+                     ((ui32R >> 8) & ((1u << ui32ZeroLog2) - 1)) == 0;
+        pui8Data[i] = bZero ? 0 : (uint8_t)((ui32R % 255) + 1);
+    }
+}
+
+static uint64_t HostNs(void){
+    struct timespec sNow;
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return (uint64_t)sNow.tv_sec * 1000000000ULL + sNow.tv_nsec;
+}
+
+// xorshift32 on a caller's seed, for the ring threads
+static uint32_t RandomFrom(uint32_t &ui32Seed){
+    ui32Seed ^= ui32Seed << 13;
+    ui32Seed ^= ui32Seed >> 17;
+    ui32Seed ^= ui32Seed << 5;
+    return ui32Seed;
+}
+
+// Byte n of the stream the ring threads pass
+static uint8_t RingByte(uint32_t n){
+    return (uint8_t)(n * 31 + (n >> 8));
+}
+
+//------------BenchRing------------
+// Check RingBuffer against a reference queue op by op, then run it
+// between two threads as the ISR and the main loop would
+// Input: none
+// Output: none
+static void BenchRing(void){
+    static RingBuffer<BENCH_RING_SIZE> sRing;
+    uint8_t pui8Model[BENCH_RING_SIZE];    // oldest byte at ui32Head
+    uint32_t ui32Head = 0;
+    uint32_t ui32Used = 0;
+    uint8_t pui8Buf[BENCH_RING_SIZE + 4];
+    uint8_t ui8Next = 0;
+    uint32_t ui32Full = 0;
+    uint32_t ui32Empty = 0;
+    uint32_t ui32Errors = 0;
+
+    for(uint32_t n = 0; n < BENCH_RING_OPS; n++){
+        uint32_t ui32Len = Random() % (BENCH_RING_SIZE + 4);
+        uint32_t ui32Room = BENCH_RING_SIZE - ui32Used;
+        uint32_t ui32Got = 0;
+        bool bBad = false;
+        switch(Random() % 6){
+            case 0:                     // put
+                bBad |= sRing.put(ui8Next) != (ui32Room != 0);
+                ui32Got = ui32Room ? 1 : 0;
+                pui8Buf[0] = ui8Next;
+                break;
+            case 1:                     // write
+                for(uint32_t i = 0; i < ui32Len; i++){
+                    pui8Buf[i] = (uint8_t)(ui8Next + i);
+                }
+                ui32Got = sRing.write(pui8Buf, ui32Len);
+                bBad |= ui32Got != ((ui32Len < ui32Room) ? ui32Len : ui32Room);
+                break;
+            case 2:                     // poke in reverse, then commit
+                ui32Got = (ui32Len < ui32Room) ? ui32Len : ui32Room;
+                for(uint32_t i = ui32Got; i-- > 0;){
+                    pui8Buf[i] = (uint8_t)(ui8Next + i);
+                    sRing.poke(i, pui8Buf[i]);
+                }
+                sRing.commit(ui32Got);
+                break;
+            case 3:{                    // get
+                uint8_t ui8Data = 0;
+                bool bOk = sRing.get(ui8Data);
+                bBad |= bOk != (ui32Used != 0);
+                if(bOk){
+                    bBad |= ui8Data != pui8Model[ui32Head];
+                    ui32Head = (ui32Head + 1) % BENCH_RING_SIZE;
+                    ui32Used--;
+                }else{
+                    ui32Empty++;
+                }
+                break;
+            }
+            case 4:{                    // read
+                uint32_t ui32Read = sRing.read(pui8Buf, ui32Len);
+                bBad |= ui32Read != ((ui32Len < ui32Used) ? ui32Len : ui32Used);
+                for(uint32_t i = 0; i < ui32Read; i++){
+                    bBad |= pui8Buf[i] != pui8Model[ui32Head];
+                    ui32Head = (ui32Head + 1) % BENCH_RING_SIZE;
+                }
+                ui32Used -= ui32Read;
+                ui32Empty += (ui32Read == 0) && (ui32Len != 0);
+                break;
+            }
+            default:{                   // discard
+                uint32_t ui32Drop = sRing.discard(ui32Len);
+                bBad |= ui32Drop != ((ui32Len < ui32Used) ? ui32Len : ui32Used);
+                ui32Head = (ui32Head + ui32Drop) % BENCH_RING_SIZE;
+                ui32Used -= ui32Drop;
+                break;
+            }
+        }
+        for(uint32_t i = 0; i < ui32Got; i++){
+            pui8Model[(ui32Head + ui32Used) % BENCH_RING_SIZE] = pui8Buf[i];
+            ui32Used++;
+        }
+        ui8Next = (uint8_t)(ui8Next + ui32Got);
+        ui32Full += (ui32Room == 0);
+        bBad |= (sRing.count() != ui32Used) ||
+                (sRing.space() != BENCH_RING_SIZE - ui32Used) ||
+                (sRing.empty() != (ui32Used == 0)) ||
+                (sRing.full() != (ui32Used == BENCH_RING_SIZE));
+        if(bBad){
+            ui32Errors++;
+        }
+    }
+    if(ui32Errors || !ui32Full || !ui32Empty){
+        g_ui32Failures++;
+    }
+    printf("bench=ring mode=model size=%u ops=%u full_hits=%u empty_hits=%u"
+           " errors=%u\n", BENCH_RING_SIZE, BENCH_RING_OPS, ui32Full,
+           ui32Empty, ui32Errors);
+
+    // Producer and consumer on their own threads, chunks of 1..size+3
+    static RingBuffer<BENCH_RING_SIZE> sShared;
+    uint32_t ui32ProdFull = 0;
+    uint32_t ui32ConsEmpty = 0;
+    uint32_t ui32Bad = 0;
+    uint64_t ui64Start = HostNs();
+    std::thread sProducer([&ui32ProdFull](){
+        uint32_t ui32Seed = 0x1234567;
+        uint8_t pui8Out[BENCH_RING_SIZE + 4];
+        uint32_t ui32Sent = 0;
+        while(ui32Sent < BENCH_RING_BYTES){
+            uint32_t ui32Len = RandomFrom(ui32Seed) % (BENCH_RING_SIZE + 3) + 1;
+            if(ui32Len > BENCH_RING_BYTES - ui32Sent){
+                ui32Len = BENCH_RING_BYTES - ui32Sent;
+            }
+            for(uint32_t i = 0; i < ui32Len; i++){
+                pui8Out[i] = RingByte(ui32Sent + i);
+            }
+            uint32_t ui32Put = sShared.write(pui8Out, ui32Len);
+            if(ui32Put == 0){
+                ui32ProdFull++;
+                std::this_thread::yield();  // one core: let the reader run
+            }
+            ui32Sent += ui32Put;
+        }
+    });
+    uint32_t ui32Seed = 0x7654321;
+    uint32_t ui32Recv = 0;
+    while(ui32Recv < BENCH_RING_BYTES){
+        uint32_t ui32Len = RandomFrom(ui32Seed) % (BENCH_RING_SIZE + 3) + 1;
+        uint32_t ui32Read = sShared.read(pui8Buf, ui32Len);
+        if(ui32Read == 0){
+            ui32ConsEmpty++;
+            std::this_thread::yield();
+        }
+        for(uint32_t i = 0; i < ui32Read; i++){
+            ui32Bad += pui8Buf[i] != RingByte(ui32Recv + i);
+        }
+        ui32Recv += ui32Read;
+    }
+    sProducer.join();
+    uint64_t ui64Ns = HostNs() - ui64Start;
+    ui32Bad += !sShared.empty();
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=ring mode=threads size=%u bytes=%u full_hits=%u"
+           " empty_hits=%u ns_per_byte=%.2f errors=%u\n", BENCH_RING_SIZE,
+           BENCH_RING_BYTES, ui32ProdFull, ui32ConsEmpty,
+           (double)ui64Ns / BENCH_RING_BYTES, ui32Bad);
+}
+
+// Keeps what is written to it, for checking report lines
+class BenchCapture : public ByteStream {
+public:
+    BenchCapture() : m_ui32Len(0) { m_pcText[0] = 0; }
+    uint32_t read(uint8_t *pui8Data, uint32_t ui32Len){
+        (void)pui8Data;
+        (void)ui32Len;
+        return 0;
+    }
+    uint32_t available(void) const { return 0; }
+    uint32_t write(const uint8_t *pui8Data, uint32_t ui32Len){
+        if(ui32Len > sizeof(m_pcText) - 1 - m_ui32Len){
+            ui32Len = sizeof(m_pcText) - 1 - m_ui32Len;
+        }
+        memcpy(&m_pcText[m_ui32Len], pui8Data, ui32Len);
+        m_ui32Len += ui32Len;
+        m_pcText[m_ui32Len] = 0;
+        return ui32Len;
+    }
+    const char *text(void) const { return m_pcText; }
+private:
+    char m_pcText[1024];
+    uint32_t m_ui32Len;
+};
+
+// Time one scope of exactly ui32Cycles from CYCCNT = ui32Start. Each
+// counter access costs the sim ui32Access cycles, as Profile_Init saw.
+static void ProfileSample(ProfileSite &sSite, uint32_t ui32Start,
+                          uint32_t ui32Cycles, uint32_t ui32Access){
+    HWREG(DWT_BASE + DWT_O_CYCCNT) = ui32Start;
+    ProfileScope sScope(sSite);
+    HWREG(DWT_BASE + DWT_O_CYCCNT) = ui32Start + ui32Cycles + ui32Access;
+}
+
+//------------BenchProfile------------
+// Drive the profiler's sites through known samples and check what it
+// aggregates
+// Input: none
+// Output: none
+static void BenchProfile(void){
+    // one per log2 bucket edge, each side of it where there is one
+    static const uint32_t pui32Sample[] = {0, 15, 16, 31, 32, 1023, 1024,
+                                           100000};
+    static const uint32_t pui32Hist[PROFILE_HIST_BUCKETS] =
+        {2, 2, 1, 0, 0, 0, 1, 2};
+    static ProfileSite sSite;
+    static ProfileSite sWrap;
+    static ProfileSite psFill[PROFILE_MAX_SITES];
+    uint32_t ui32Samples = sizeof(pui32Sample) / sizeof(pui32Sample[0]);
+    uint64_t ui64Total = 0;
+    uint32_t ui32Bad = 0;
+
+    sSite.name = "bench_a";
+    sWrap.name = "bench_wrap";
+    SimInit(SYSCLOCK_HZ);
+    Profile_Init();
+    uint32_t ui32Start = CycleCounterGet();
+    uint32_t ui32Access = CycleCounterGet() - ui32Start;
+    for(uint32_t i = 0; i < ui32Samples; i++){
+        ProfileSample(sSite, 1000 * i, pui32Sample[i], ui32Access);
+        ui64Total += pui32Sample[i];
+    }
+    ui32Bad += (sSite.count != ui32Samples) || (sSite.min != 0) ||
+               (sSite.max != 100000) || (sSite.total != ui64Total);
+    for(uint32_t b = 0; b < PROFILE_HIST_BUCKETS; b++){
+        ui32Bad += sSite.hist[b] != pui32Hist[b];
+    }
+    ProfileSample(sWrap, 0xFFFFFF00, 500, ui32Access);
+    ui32Bad += (sWrap.count != 1) || (sWrap.max != 500) ||
+               (sWrap.hist[5] != 1);
+
+    BenchCapture sOut;
+    Profile_Report(sOut);
+    ui32Bad += strstr(sOut.text(), "prof site=bench_a n=8 min=0 max=100000"
+                      " mean=12767 hist=2/2/1/0/0/0/1/2\r\n") == 0;
+
+    Profile_Reset();
+    ui32Bad += (sSite.count != 0) || (sSite.max != 0) ||
+               (sSite.total != 0) || (sSite.hist[0] != 0) ||
+               (sWrap.count != 0);
+
+    // two sites are in; fill the table, then one more must stay out
+    uint32_t ui32Registered = 0;
+    for(uint32_t i = 0; i < PROFILE_MAX_SITES; i++){
+        psFill[i].name = "bench_fill";
+        Profile_Record(psFill[i], 100);
+        ui32Registered += psFill[i].registered;
+    }
+    ProfileSample(sSite, 0, 64, ui32Access);
+    ui32Bad += (ui32Registered != PROFILE_MAX_SITES - 2) ||
+               psFill[PROFILE_MAX_SITES - 1].registered ||
+               (psFill[PROFILE_MAX_SITES - 1].count != 0) ||
+               (psFill[0].count != 1) || (sSite.count != 1);
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=profile samples=%u access_cycles=%u sites=%u"
+           " errors=%u\n", ui32Samples + 1, ui32Access,
+           ui32Registered + 2, ui32Bad);
+}
+
+//------------BenchCobs------------
+// Fuzz the COBS codec, then time it on the host
+// Input: none
+// Output: none
+static void BenchCobs(void){
+    static uint8_t pui8Data[BENCH_FUZZ_MAX];
+    static uint8_t pui8Enc[Cobs_EncodedMax(BENCH_FUZZ_MAX) + 1];
+    static uint8_t pui8Dec[BENCH_FUZZ_MAX];
+    static const uint32_t pui32ZeroLog2[] = {0, 1, 4, 8};
+    uint32_t ui32Errors = 0;
+    CobsDecoder sDecoder;
+
+    for(uint32_t n = 0; n < BENCH_FUZZ_FRAMES; n++){
+        uint32_t ui32Len = Random() % (BENCH_FUZZ_MAX + 1);
+        bool bBad = false;
+        RandomPayload(pui8Data, ui32Len, pui32ZeroLog2[n % 4]);
+        if(n % 16 == 0){
+            memset(pui8Data, n % 32 ? 0 : 0x55, ui32Len);   // all one value
+        }
+
+        // Encoding: no zeros inside, one delimiter, within the bound
+        uint32_t ui32Enc = Cobs_Encode(pui8Data, ui32Len, pui8Enc);
+        bBad |= ui32Enc > Cobs_EncodedMax(ui32Len) + 1;
+        bBad |= memchr(pui8Enc, 0, ui32Enc - 1) != 0;
+        bBad |= pui8Enc[ui32Enc - 1] != 0;
+
+        // Buffer decode round trip, and one byte short of room
+        int32_t i32Dec = Cobs_Decode(pui8Enc, ui32Enc, pui8Dec, ui32Len);
+        bBad |= (i32Dec != (int32_t)ui32Len) ||
+                (memcmp(pui8Dec, pui8Data, ui32Len) != 0);
+        if(ui32Len){
+            bBad |= Cobs_Decode(pui8Enc, ui32Enc, pui8Dec, ui32Len - 1) != -1;
+        }
+
+        // Streaming decode behind random noise: the frame must come
+        // through intact once the delimiter ending the noise resyncs us
+        uint32_t ui32Noise = Random() % 48;
+        sDecoder.begin(pui8Dec, ui32Len);
+        for(uint32_t i = 0; i < ui32Noise; i++){
+            sDecoder.put((uint8_t)Random());
+        }
+        sDecoder.put(0);
+        sDecoder.begin(pui8Dec, ui32Len);
+        CobsStatus eStatus = COBS_MORE;
+        for(uint32_t i = 0; i < ui32Enc; i++){
+            eStatus = sDecoder.put(pui8Enc[i]);
+            if((eStatus != COBS_MORE) && (i != ui32Enc - 1)){
+                bBad = true;
+            }
+        }
+        bBad |= (eStatus != COBS_FRAME) || (sDecoder.length() != ui32Len) ||
+                (memcmp(pui8Dec, pui8Data, ui32Len) != 0);
+
+        // A delimiter landing inside a block is reported, never a frame
+        if(ui32Enc > 2){
+            sDecoder.begin(pui8Dec, ui32Len);
+            sDecoder.put(pui8Enc[0]);
+            if(pui8Enc[0] > 1){
+                bBad |= sDecoder.put(0) != COBS_CORRUPT;
+            }
+        }
+        if(bBad){
+            ui32Errors++;
+        }
+    }
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=cobs_fuzz frames=%u errors=%u\n", BENCH_FUZZ_FRAMES,
+           ui32Errors);
+
+    // Throughput on a typical binary payload, a zero every 16 bytes
+    for(uint32_t i = 0; i < COBS_BLOCK; i++){
+        pui8Data[i] = (i % 16) ? (uint8_t)i : 0;
+    }
+    uint32_t ui32Enc = 0;
+    uint64_t ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        pui8Data[0] = (uint8_t)n;       // keep the loop from folding
+        ui32Enc = Cobs_Encode(pui8Data, COBS_BLOCK, pui8Enc);
+    }
+    uint64_t ui64Encode = HostNs() - ui64Start;
+    uint32_t ui32Frames = 0;
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        sDecoder.begin(pui8Dec, COBS_BLOCK);
+        for(uint32_t i = 0; i < ui32Enc; i++){
+            ui32Frames += sDecoder.put(pui8Enc[i]) == COBS_FRAME;
+        }
+    }
+    uint64_t ui64Decode = HostNs() - ui64Start;
+    printf("bench=cobs_encode bytes=%u ns=%llu ns_per_byte=%.2f\n",
+           COBS_BLOCK * BENCH_CODEC_ROUNDS, (unsigned long long)ui64Encode,
+           (double)ui64Encode / (COBS_BLOCK * BENCH_CODEC_ROUNDS));
+    printf("bench=cobs_decode bytes=%u ns=%llu ns_per_byte=%.2f frames=%u\n",
+           ui32Enc * BENCH_CODEC_ROUNDS, (unsigned long long)ui64Decode,
+           (double)ui64Decode / (ui32Enc * BENCH_CODEC_ROUNDS), ui32Frames);
+}
+
+//------------BenchFrames------------
+// Send COBS frames with noise between them to UART1 on the interrupt
+// path; the firmware side echoes every frame FrameLink decodes
+// Input: ui32Baud
+// Output: none
+static void BenchFrames(uint32_t ui32Baud){
+    static uint8_t ppui8Sent[BENCH_FRAMES][BENCH_FRAME_MAX];
+    static uint32_t pui32SentLen[BENCH_FRAMES];
+    static uint8_t pui8Line[BENCH_FRAMES * (BENCH_FRAME_MAX + 24)];
+    static uint8_t pui8Back[sizeof(pui8Line) * 2];
+    uint8_t pui8Frame[FRAME_MAX_PAYLOAD];
+    uint32_t ui32LineLen = 0;
+    uint32_t ui32BackLen = 0;
+    uint32_t ui32Matched = 0;
+    uint32_t ui32Other = 0;
+    bool bLive = true;
+
+    // Frames 1..BENCH_FRAME_MAX bytes, every fourth behind a noise burst
+    for(uint32_t n = 0; n < BENCH_FRAMES; n++){
+        pui32SentLen[n] = 1 + Random() % BENCH_FRAME_MAX;
+        RandomPayload(ppui8Sent[n], pui32SentLen[n], 3);
+        if(n % 4 == 3){
+            uint32_t ui32Noise = 1 + Random() % 16;
+            for(uint32_t i = 0; i < ui32Noise; i++){
+                pui8Line[ui32LineLen++] = (uint8_t)Random();
+            }
+            pui8Line[ui32LineLen++] = 0;
+        }
+        ui32LineLen += Cobs_Encode(ppui8Sent[n], pui32SentLen[n],
+                                   &pui8Line[ui32LineLen]);
+    }
+
+    BenchSetup(BENCH_IRQ, ui32Baud, &g_psFifo[1]);
+    UART1_Frames.start();
+    FrameStats sBefore = UART1_Frames.stats();
+    uint64_t ui64Start = SimNow();
+    uint64_t ui64Deadline = ui64Start +
+                            FrameCycles(ui32Baud) * ui32LineLen * 4;
+    SimUARTHostWrite(1, pui8Line, ui32LineLen);
+    while(bLive && (SimNow() < ui64Deadline) &&
+          (SimUARTGetStats(1)->ui32RxBytes < ui32LineLen ||
+           !UART1_Buffered.txIdle() || g_ui32PendOff < g_ui32PendLen ||
+           UART1_Frames.pending())){
+        bLive = Forward(UART1_Frames, UART1_Frames);
+        ui32BackLen += SimUARTHostRead(1, &pui8Back[ui32BackLen],
+                                       sizeof(pui8Back) - ui32BackLen);
+    }
+    SimAdvance(FrameCycles(ui32Baud) * 20);     // last bytes off the FIFO
+    ui32BackLen += SimUARTHostRead(1, &pui8Back[ui32BackLen],
+                                   sizeof(pui8Back) - ui32BackLen);
+    uint64_t ui64Elapsed = SimUARTGetStats(1)->ui64LastTx - ui64Start;
+    UART1_Frames.stop();
+
+    // Walk the echoed frames; sent frames must come back in order, and
+    // anything else is noise that happened to decode as a frame
+    uint32_t ui32Start = 0;
+    for(uint32_t i = 0; i < ui32BackLen; i++){
+        if(pui8Back[i] != 0){
+            continue;
+        }
+        int32_t i32Len = Cobs_Decode(&pui8Back[ui32Start], i - ui32Start,
+                                     pui8Frame, sizeof(pui8Frame));
+        ui32Start = i + 1;
+        if((ui32Matched < BENCH_FRAMES) &&
+           (i32Len == (int32_t)pui32SentLen[ui32Matched]) &&
+           (memcmp(pui8Frame, ppui8Sent[ui32Matched], i32Len) == 0)){
+            ui32Matched++;
+        }else{
+            ui32Other++;
+        }
+    }
+    if(ui32Matched != BENCH_FRAMES){
+        g_ui32Failures++;
+    }
+
+    const FrameStats &sStats = UART1_Frames.stats();
+    printf("bench=frames path=irq baud=%u frames=%u ok=%u noise_frames=%u"
+           " corrupt=%u oversize=%u dropped=%u bytes_per_s=%llu\n",
+           ui32Baud, BENCH_FRAMES, ui32Matched, ui32Other,
+           sStats.corrupt - sBefore.corrupt,
+           sStats.oversize - sBefore.oversize,
+           sStats.dropped - sBefore.dropped,
+           (unsigned long long)(ui64Elapsed ?
+           ((uint64_t)ui32LineLen * SYSCLOCK_HZ) / ui64Elapsed : 0));
+}
+
+// Device ports beyond UART0/UART1, only brought up by BenchHub
+static UARTPort<UART2_BASE> g_sUART2;
+static UARTPort<UART3_BASE> g_sUART3;
+static UARTPort<UART4_BASE> g_sUART4;
+static UARTPort<UART5_BASE> g_sUART5;
+static UARTPort<UART6_BASE> g_sUART6;
+static UARTPort<UART7_BASE> g_sUART7;
+
+static uint8_t HubByte(uint32_t ui32Id, uint32_t ui32Pos, bool bUp){
+    return (uint8_t)(ui32Id * 37 + ui32Pos * (bUp ? 7 : 11) + (ui32Pos >> 8));
+}
+
+//------------BenchHub------------
+// Fan seven device ports in to a framed PC link and stream both ways
+// Input: none
+// Output: none
+static void BenchHub(void){
+    static FrameLink sPc(UART0_Buffered);
+    static UARTHub sHub(sPc);
+    static uint8_t pui8Down[HUB_MAX_DEVICES * (BENCH_HUB_BYTES + 16) * 2];
+    static uint8_t pui8PcIn[FRAME_MAX_PAYLOAD * 2];
+    static uint8_t ppui8Up[HUB_MAX_DEVICES][BENCH_HUB_BYTES];
+    static uint8_t ppui8Dev[HUB_MAX_DEVICES][BENCH_HUB_BYTES];
+    BufferedUART *ppsDev[HUB_MAX_DEVICES] = {
+        &UART1_Buffered, &g_sUART2, &g_sUART3, &g_sUART4, &g_sUART5,
+        &g_sUART6, &g_sUART7
+    };
+    uint32_t pui32Up[HUB_MAX_DEVICES] = {0};
+    uint32_t pui32Dev[HUB_MAX_DEVICES] = {0};
+    uint32_t ui32PcLen = 0;
+    uint32_t ui32DownLen = 0;
+    uint32_t ui32Bad = 0;
+    bool bLive = true;
+
+    BenchSetup(BENCH_IRQ, BENCH_HUB_DEV_BAUD, &g_psFifo[1]);
+    UARTConfigSetExpClk(UART0_BASE, SysClock_Get(), BENCH_HUB_PC_BAUD,
+                        UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                        UART_CONFIG_PAR_NONE);
+    g_sUART2.open(BENCH_HUB_DEV_BAUD);
+    g_sUART3.open(BENCH_HUB_DEV_BAUD);
+    g_sUART4.open(BENCH_HUB_DEV_BAUD);
+    g_sUART5.open(BENCH_HUB_DEV_BAUD);
+    g_sUART6.open(BENCH_HUB_DEV_BAUD);
+    g_sUART7.open(BENCH_HUB_DEV_BAUD);
+    if(sHub.devices() == 0){
+        for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+            sHub.attach(*ppsDev[i]);
+        }
+    }
+    sHub.start();
+
+    // Downstream: frames for every device, interleaved
+    for(uint32_t ui32Pos = 0; ui32Pos < BENCH_HUB_BYTES;
+        ui32Pos += BENCH_HUB_DOWN){
+        uint32_t ui32Len = BENCH_HUB_BYTES - ui32Pos;
+        if(ui32Len > BENCH_HUB_DOWN){
+            ui32Len = BENCH_HUB_DOWN;
+        }
+        for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+            uint8_t pui8Frame[BENCH_HUB_DOWN + 1];
+            pui8Frame[0] = (uint8_t)i;
+            for(uint32_t k = 0; k < ui32Len; k++){
+                pui8Frame[k + 1] = HubByte(i, ui32Pos + k, false);
+            }
+            ui32DownLen += Cobs_Encode(pui8Frame, ui32Len + 1,
+                                       &pui8Down[ui32DownLen]);
+        }
+    }
+    uint64_t ui64Start = SimNow();
+    uint64_t ui64Deadline = ui64Start + FrameCycles(BENCH_HUB_DEV_BAUD) *
+                                        BENCH_HUB_BYTES * 8;
+    SimUARTHostWrite(0, pui8Down, ui32DownLen);
+    for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+        uint8_t pui8Data[BENCH_HUB_BYTES];
+        for(uint32_t k = 0; k < BENCH_HUB_BYTES; k++){
+            pui8Data[k] = HubByte(i, k, true);
+        }
+        SimUARTHostWrite(i + 1, pui8Data, BENCH_HUB_BYTES);
+    }
+
+    for(;;){
+        bool bDone = true;
+        for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+            pui32Dev[i] += SimUARTHostRead(i + 1, &ppui8Dev[i][pui32Dev[i]],
+                                           BENCH_HUB_BYTES - pui32Dev[i]);
+            bDone &= (pui32Up[i] == BENCH_HUB_BYTES) &&
+                     (pui32Dev[i] == BENCH_HUB_BYTES);
+        }
+        // Split what the PC received into frames, payload by port id
+        ui32PcLen += SimUARTHostRead(0, &pui8PcIn[ui32PcLen],
+                                     sizeof(pui8PcIn) - ui32PcLen);
+        uint32_t ui32Start = 0;
+        for(uint32_t i = 0; i < ui32PcLen; i++){
+            if(pui8PcIn[i] != 0){
+                continue;
+            }
+            uint8_t pui8Frame[FRAME_MAX_PAYLOAD];
+            int32_t i32Len = Cobs_Decode(&pui8PcIn[ui32Start], i - ui32Start,
+                                         pui8Frame, sizeof(pui8Frame));
+            uint32_t ui32Id = (i32Len >= 1) ? pui8Frame[0] : HUB_MAX_DEVICES;
+            ui32Start = i + 1;
+            if((ui32Id >= HUB_MAX_DEVICES) ||
+               (pui32Up[ui32Id] + i32Len - 1 > BENCH_HUB_BYTES)){
+                ui32Bad++;
+                continue;
+            }
+            memcpy(&ppui8Up[ui32Id][pui32Up[ui32Id]], &pui8Frame[1],
+                   i32Len - 1);
+            pui32Up[ui32Id] += i32Len - 1;
+        }
+        ui32PcLen -= ui32Start;
+        memmove(pui8PcIn, &pui8PcIn[ui32Start], ui32PcLen);
+        if(bDone || !bLive || (SimNow() >= ui64Deadline)){
+            break;
+        }
+        if(sHub.pump() == 0){
+            uint64_t ui64Before = SimNow();
+            CPUcpsid();
+            CPUwfi();
+            CPUcpsie();
+            bLive = SimNow() != ui64Before;
+        }
+    }
+    uint64_t ui64Elapsed = SimNow() - ui64Start;
+    sPc.stop();
+
+    uint32_t ui32Up = 0;
+    uint32_t ui32Down = 0;
+    uint32_t ui32Frames = 0;
+    uint32_t ui32Drops = 0;
+    for(uint32_t i = 0; i < HUB_MAX_DEVICES; i++){
+        for(uint32_t k = 0; k < BENCH_HUB_BYTES; k++){
+            ui32Bad += (k >= pui32Up[i]) ||
+                       (ppui8Up[i][k] != HubByte(i, k, true));
+            ui32Bad += (k >= pui32Dev[i]) ||
+                       (ppui8Dev[i][k] != HubByte(i, k, false));
+        }
+        ui32Up += sHub.stats(i).bytesUp;
+        ui32Down += sHub.stats(i).bytesDown;
+        ui32Frames += sHub.stats(i).framesUp;
+        ui32Drops += sHub.stats(i).drops;
+    }
+    ui32Bad += sHub.badFrames();
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=hub devices=%u pc_baud=%u dev_baud=%u up_bytes=%u"
+           " up_frames=%u down_bytes=%u bytes_per_s=%llu drops=%u"
+           " errors=%u\n", HUB_MAX_DEVICES, BENCH_HUB_PC_BAUD,
+           BENCH_HUB_DEV_BAUD, ui32Up, ui32Frames, ui32Down,
+           (unsigned long long)(ui64Elapsed ?
+           ((uint64_t)(ui32Up + ui32Down) * SYSCLOCK_HZ) / ui64Elapsed : 0),
+           ui32Drops, ui32Bad);
+}
+
+static void PrintNs(const char *pcName, uint64_t ui64Ns, uint32_t ui32Bytes,
+                    uint32_t ui32Crc){
+    printf("bench=%s bytes=%u ns=%llu ns_per_byte=%.2f crc=0x%08X\n", pcName,
+           ui32Bytes, (unsigned long long)ui64Ns, (double)ui64Ns / ui32Bytes,
+           ui32Crc);
+}
+
+//------------BenchCrc------------
+// Check the CRC forms against the standard check values and each other,
+// then time them on the host
+// Input: none
+// Output: none
+static void BenchCrc(void){
+    static uint8_t pui8Data[BENCH_CRC_BYTES + 3];
+    static const uint8_t pui8Check[] = "123456789";
+    uint32_t ui32Errors = 0;
+
+    ui32Errors += Crc16(pui8Check, 9) != CRC16_CHECK;
+    ui32Errors += Crc32(pui8Check, 9) != CRC32_CHECK;
+
+    // Random length, start alignment and split point; the per-byte,
+    // bytewise and sliced forms and a two piece feed must all agree
+    for(uint32_t n = 0; n < BENCH_CRC_TRIALS; n++){
+        uint32_t ui32Len = Random() % (BENCH_CRC_BYTES / 4);
+        uint32_t ui32Align = Random() % 4;
+        uint32_t ui32Split = ui32Len ? Random() % ui32Len : 0;
+        const uint8_t *pui8Buf = &pui8Data[ui32Align];
+        RandomPayload(&pui8Data[ui32Align], ui32Len, 0);
+
+        uint16_t ui16Byte = CRC16_INIT;
+        uint32_t ui32Byte = CRC32_INIT;
+        for(uint32_t i = 0; i < ui32Len; i++){
+            ui16Byte = Crc16_Update(ui16Byte, pui8Buf[i]);
+            ui32Byte = Crc32_Update(ui32Byte, pui8Buf[i]);
+        }
+        uint16_t ui16Split = Crc16_Block4(Crc16_Block4(CRC16_INIT, pui8Buf,
+                             ui32Split), &pui8Buf[ui32Split],
+                             ui32Len - ui32Split);
+        uint32_t ui32Split4 = Crc32_Block4(Crc32_Block4(CRC32_INIT, pui8Buf,
+                              ui32Split), &pui8Buf[ui32Split],
+                              ui32Len - ui32Split);
+        bool bBad = (Crc16_Block(CRC16_INIT, pui8Buf, ui32Len) != ui16Byte) ||
+                    (Crc16_Block4(CRC16_INIT, pui8Buf, ui32Len) != ui16Byte) ||
+                    (ui16Split != ui16Byte) ||
+                    (Crc32_Block(CRC32_INIT, pui8Buf, ui32Len) != ui32Byte) ||
+                    (Crc32_Block4(CRC32_INIT, pui8Buf, ui32Len) != ui32Byte) ||
+                    (ui32Split4 != ui32Byte);
+        ui32Errors += bBad;
+    }
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=crc_check trials=%u errors=%u\n", BENCH_CRC_TRIALS,
+           ui32Errors);
+
+    // Throughput; the running crc is carried across rounds so no round
+    // can be skipped
+    uint32_t ui32Bytes = BENCH_CRC_BYTES * BENCH_CODEC_ROUNDS;
+    uint16_t ui16Crc = CRC16_INIT;
+    uint32_t ui32Crc = CRC32_INIT;
+    RandomPayload(pui8Data, BENCH_CRC_BYTES, 0);
+
+    uint64_t ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        for(uint32_t i = 0; i < BENCH_CRC_BYTES; i++){
+            ui16Crc = Crc16_Update(ui16Crc, pui8Data[i]);
+        }
+    }
+    PrintNs("crc16_update", HostNs() - ui64Start, ui32Bytes, ui16Crc);
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        ui16Crc = Crc16_Block(ui16Crc, pui8Data, BENCH_CRC_BYTES);
+    }
+    PrintNs("crc16_table", HostNs() - ui64Start, ui32Bytes, ui16Crc);
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        ui16Crc = Crc16_Block4(ui16Crc, pui8Data, BENCH_CRC_BYTES);
+    }
+    PrintNs("crc16_slice4", HostNs() - ui64Start, ui32Bytes, ui16Crc);
+
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        for(uint32_t i = 0; i < BENCH_CRC_BYTES; i++){
+            ui32Crc = Crc32_Update(ui32Crc, pui8Data[i]);
+        }
+    }
+    PrintNs("crc32_update", HostNs() - ui64Start, ui32Bytes, ui32Crc);
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        ui32Crc = Crc32_Block(ui32Crc, pui8Data, BENCH_CRC_BYTES);
+    }
+    PrintNs("crc32_table", HostNs() - ui64Start, ui32Bytes, ui32Crc);
+    ui64Start = HostNs();
+    for(uint32_t n = 0; n < BENCH_CODEC_ROUNDS; n++){
+        ui32Crc = Crc32_Block4(ui32Crc, pui8Data, BENCH_CRC_BYTES);
+    }
+    PrintNs("crc32_slice4", HostNs() - ui64Start, ui32Bytes, ui32Crc);
+}
+
+// Let ui32Frames character times pass one at a time, so interrupts are
+// taken as they come due (SimAdvance() only takes them at the end)
+static void RunFrames(uint32_t ui32Baud, uint32_t ui32Frames){
+    for(uint32_t i = 0; i < ui32Frames; i++){
+        SimAdvance(FrameCycles(ui32Baud));
+    }
+}
+
+//------------BenchRxErrors------------
+// Feed UART0 bytes at the wrong baud, then overrun its RX FIFO with
+// interrupts masked, and compare the driver's error counters with the
+// line model's
+// Input: ePath (interrupt or DMA), ui32Baud
+// Output: none
+static void BenchRxErrors(BenchPath ePath, uint32_t ui32Baud){
+    uint8_t pui8Drain[BENCH_CHUNK];
+
+    BenchSetup(ePath, ui32Baud, &g_psFifo[1]);
+    UARTStats sBefore = Stats(ePath, 0);
+
+    SimUARTHostBaud(0, ui32Baud + ui32Baud / 10);
+    SimUARTHostWrite(0, g_pui8Pattern, 32);
+    RunFrames(ui32Baud, 64);
+    SimUARTHostBaud(0, 0);
+#ifdef UART_RX_ERROR_TAGS
+    uint8_t pui8Tags[BENCH_CHUNK];
+    uint32_t ui32Tagged = 0;
+    if(ePath == BENCH_IRQ){
+        uint32_t n = UART0_Buffered.readTagged(pui8Drain, pui8Tags,
+                                               sizeof(pui8Drain));
+        for(uint32_t i = 0; i < n; i++){
+            ui32Tagged += (pui8Tags[i] & UART_RXERROR_FRAMING) != 0;
+        }
+    }
+#endif
+    while(Stream(ePath, 0).read(pui8Drain, sizeof(pui8Drain)));
+    uint32_t ui32LineFraming = SimUARTGetStats(0)->ui32FramingErrors;
+
+    IntMasterDisable();
+    SimUARTHostWrite(0, g_pui8Pattern, 48);
+    RunFrames(ui32Baud, 64);
+    IntMasterEnable();
+    RunFrames(ui32Baud, 16);
+    while(Stream(ePath, 0).read(pui8Drain, sizeof(pui8Drain)));
+    uint32_t ui32LineOverruns = SimUARTGetStats(0)->ui32Overruns;
+
+    const UARTStats &sStats = Stats(ePath, 0);
+    uint32_t ui32Framing = sStats.rxFraming - sBefore.rxFraming;
+    uint32_t ui32Overrun = sStats.rxOverrun - sBefore.rxOverrun;
+
+    // Every bad byte is counted on both paths, DMA moving each DR entry
+    // with its error bits. Overruns are events, not bytes. DMA keeps
+    // draining the FIFO with interrupts masked, so it should not overrun.
+    bool bBad = (ui32LineFraming == 0) || (ui32Framing != ui32LineFraming) ||
+                ((ui32Overrun == 0) != (ui32LineOverruns == 0)) ||
+                ((ePath == BENCH_IRQ) && (ui32LineOverruns == 0));
+#ifdef UART_RX_ERROR_TAGS
+    bBad |= (ePath == BENCH_IRQ) && (ui32Tagged != ui32LineFraming);
+#endif
+    if(bBad){
+        g_ui32Failures++;
+    }
+    printf("bench=rx_errors path=%s baud=%u framing=%u line_framing=%u"
+           " overrun=%u line_overruns=%u errors=%u\n", g_ppcPathName[ePath],
+           ui32Baud, ui32Framing, ui32LineFraming, ui32Overrun,
+           ui32LineOverruns, bBad ? 1 : 0);
+}
+
+// Run the bridge until the host has read ui32Want bytes from ui32Port or
+// the line goes quiet
+// Output: bytes read into pui8Data
+static uint32_t FlowPump(UARTBridge &sBridge, uint32_t ui32Port,
+                         uint8_t *pui8Data, uint32_t ui32Want){
+    uint32_t ui32Got = 0;
+    uint64_t ui64Quiet = FrameCycles(BENCH_FLOW_PC_BAUD) * 64;
+    uint64_t ui64Last = SimNow();
+
+    while((ui32Got < ui32Want) && (SimNow() - ui64Last < ui64Quiet)){
+        if(sBridge.pump() == 0){
+            SimAdvance(FrameCycles(BENCH_FLOW_DEV_BAUD));
+        }
+        uint32_t n = SimUARTHostRead(ui32Port, &pui8Data[ui32Got],
+                                     ui32Want - ui32Got);
+        if(n != 0){
+            ui32Got += n;
+            ui64Last = SimNow();
+        }
+    }
+    return ui32Got;
+}
+
+static const char *const g_ppcFlowName[] = {"none", "rtscts", "xonxoff"};
+
+// Printable payload for XON/XOFF, which cannot carry 0x11/0x13 as data
+static uint8_t g_pui8Text[BENCH_FLOW_BYTES];
+
+//------------BenchFlow------------
+// Device to PC flood through the bridge with the device 8x faster, then
+// PC to device with the device holding CTS off (or sending XOFF) for a
+// while
+// Input: eMode is the flow control on UART1
+// Output: none
+static void BenchFlow(UARTFlowControl eMode){
+    static UARTBridge sBridge(UART0_Buffered, UART1_Buffered);
+    static uint8_t pui8Got[BENCH_FLOW_BYTES];
+    static const uint8_t ui8Xoff = UART_XOFF, ui8Xon = UART_XON;
+    bool bFlow = (eMode != UART_FLOW_NONE);
+    bool bXon = (eMode == UART_FLOW_XONXOFF);
+    const uint8_t *pui8Data = bXon ? g_pui8Text : g_pui8Pattern;
+    uint32_t ui32Bad = 0;
+
+    for(uint32_t i = 0; i < BENCH_FLOW_BYTES; i++){
+        g_pui8Text[i] = (uint8_t)(' ' + (i * 7) % 95);
+    }
+
+    BenchSetup(BENCH_IRQ, BENCH_FLOW_PC_BAUD, &g_psFifo[1]);
+    UARTConfigSetExpClk(UART1_BASE, SysClock_Get(), BENCH_FLOW_DEV_BAUD,
+                        UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE |
+                        UART_CONFIG_PAR_NONE);
+    UART1_Buffered.setFlowControl(eMode);
+    SimUARTHostFlow(1, eMode == UART_FLOW_RTSCTS);
+    SimUARTHostXonXoff(1, bXon);
+    UARTStats sBefore = UART1_Buffered.stats();
+    sBridge.start();
+
+    SimUARTHostWrite(1, pui8Data, BENCH_FLOW_BYTES);
+    uint32_t ui32Up = FlowPump(sBridge, 0, pui8Got, BENCH_FLOW_BYTES);
+    uint32_t ui32Lost = BENCH_FLOW_BYTES - ui32Up;
+    for(uint32_t i = 0; bFlow && (i < ui32Up); i++){
+        ui32Bad += pui8Got[i] != pui8Data[i];
+    }
+
+    // PC to device with CTS held off or after XOFF: nothing may leave
+    // UART1 until the device lets go
+    if(bXon){
+        SimUARTHostWrite(1, &ui8Xoff, 1);
+    }else{
+        SimUARTHostCts(1, false);
+    }
+    SimUARTHostWrite(0, pui8Data, BENCH_FLOW_BYTES / 4);
+    uint64_t ui64Until = SimNow() +
+                         FrameCycles(BENCH_FLOW_PC_BAUD) * BENCH_FLOW_HOLD;
+    while(SimNow() < ui64Until){
+        if(sBridge.pump() == 0){
+            SimAdvance(FrameCycles(BENCH_FLOW_DEV_BAUD));
+        }
+    }
+    uint32_t ui32Early = SimUARTHostRead(1, pui8Got, BENCH_FLOW_BYTES / 4);
+    if(bXon){
+        SimUARTHostWrite(1, &ui8Xon, 1);
+    }else{
+        SimUARTHostCts(1, true);
+    }
+    uint32_t ui32Down = ui32Early + FlowPump(sBridge, 1, &pui8Got[ui32Early],
+                                  BENCH_FLOW_BYTES / 4 - ui32Early);
+    ui32Bad += (ui32Down != BENCH_FLOW_BYTES / 4) ||
+               (memcmp(pui8Got, pui8Data, ui32Down) != 0);
+    if(bFlow){
+        ui32Bad += ui32Lost + (ui32Early != 0);
+    }
+
+    const UARTStats &sStats = UART1_Buffered.stats();
+    uint32_t ui32RxThrottles = sStats.rxThrottles - sBefore.rxThrottles;
+    uint32_t ui32TxThrottles = sStats.txThrottles - sBefore.txThrottles;
+    if(bFlow){
+        ui32Bad += (ui32RxThrottles == 0) || (ui32TxThrottles == 0);
+    }
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=flow mode=%s dev_baud=%u pc_baud=%u up_bytes=%u lost=%u"
+           " down_bytes=%u rx_throttles=%u rx_throttled_us=%u"
+           " tx_throttles=%u tx_throttled_us=%u errors=%u\n",
+           g_ppcFlowName[eMode], BENCH_FLOW_DEV_BAUD,
+           BENCH_FLOW_PC_BAUD, ui32Up, ui32Lost, ui32Down, ui32RxThrottles,
+           sStats.rxThrottledUs - sBefore.rxThrottledUs, ui32TxThrottles,
+           sStats.txThrottledUs - sBefore.txThrottledUs, ui32Bad);
+
+    UART1_Buffered.setFlowControl(UART_FLOW_NONE);
+    SimUARTHostFlow(1, false);
+    SimUARTHostXonXoff(1, false);
+}
+
+//------------BenchFlowMutual------------
+// UART0 and UART1 send BENCH_FLOW_BYTES to each other at once with
+// XON/XOFF on both, and both readers stay away at first, so each end
+// pauses the other while it has data queued
+// Input: none
+// Output: none
+static void BenchFlowMutual(void){
+    static uint8_t ppui8Got[2][BENCH_FLOW_BYTES];
+    BufferedUART *ppsPort[2] = {&UART0_Buffered, &UART1_Buffered};
+    uint32_t pui32Sent[2] = {0, 0};
+    uint32_t pui32Got[2] = {0, 0};
+    UARTStats psBefore[2];
+    uint32_t ui32Bad = 0;
+
+    for(uint32_t i = 0; i < BENCH_FLOW_BYTES; i++){
+        g_pui8Text[i] = (uint8_t)(' ' + (i * 7) % 95);
+    }
+    BenchSetup(BENCH_IRQ, BENCH_MUTUAL_BAUD, &g_psFifo[1]);
+    SimUARTConnect(0, 1);
+    for(uint32_t p = 0; p < 2; p++){
+        ppsPort[p]->setFlowControl(UART_FLOW_XONXOFF);
+        psBefore[p] = ppsPort[p]->stats();
+    }
+
+    uint64_t ui64Frame = FrameCycles(BENCH_MUTUAL_BAUD);
+    uint64_t ui64Start = SimNow();
+    // each side's bytes take BENCH_FLOW_BYTES frames; four times that
+    // plus the hold is a lock up
+    uint64_t ui64Deadline = ui64Start +
+        ui64Frame * (BENCH_MUTUAL_HOLD + 4 * BENCH_FLOW_BYTES);
+    while(((pui32Got[0] < BENCH_FLOW_BYTES) ||
+           (pui32Got[1] < BENCH_FLOW_BYTES)) && (SimNow() < ui64Deadline)){
+        bool bRead = (SimNow() - ui64Start) >= ui64Frame * BENCH_MUTUAL_HOLD;
+        for(uint32_t p = 0; p < 2; p++){
+            pui32Sent[p] += ppsPort[p]->write(&g_pui8Text[pui32Sent[p]],
+                                              BENCH_FLOW_BYTES - pui32Sent[p]);
+            uint32_t ui32Want = BENCH_FLOW_BYTES - pui32Got[p];
+            if(ui32Want > BENCH_MUTUAL_READ){
+                ui32Want = BENCH_MUTUAL_READ;
+            }
+            if(bRead){
+                pui32Got[p] += ppsPort[p]->read(&ppui8Got[p][pui32Got[p]],
+                                                ui32Want);
+            }
+        }
+        SimAdvance((uint32_t)ui64Frame);
+    }
+
+    uint32_t pui32Throttles[2][2];
+    for(uint32_t p = 0; p < 2; p++){
+        const UARTStats &sStats = ppsPort[p]->stats();
+        pui32Throttles[p][0] = sStats.rxThrottles - psBefore[p].rxThrottles;
+        pui32Throttles[p][1] = sStats.txThrottles - psBefore[p].txThrottles;
+        ui32Bad += (pui32Got[p] != BENCH_FLOW_BYTES) ||
+                   (memcmp(ppui8Got[p], g_pui8Text, pui32Got[p]) != 0) ||
+                   (sStats.rxOverflow != psBefore[p].rxOverflow) ||
+                   (pui32Throttles[p][0] == 0) || (pui32Throttles[p][1] == 0);
+        ppsPort[p]->setFlowControl(UART_FLOW_NONE);
+    }
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=flow_mutual baud=%u bytes=%u got0=%u got1=%u"
+           " rx_throttles0=%u tx_throttles0=%u rx_throttles1=%u"
+           " tx_throttles1=%u ms=%llu errors=%u\n", BENCH_MUTUAL_BAUD,
+           BENCH_FLOW_BYTES, pui32Got[0], pui32Got[1], pui32Throttles[0][0],
+           pui32Throttles[0][1], pui32Throttles[1][0], pui32Throttles[1][1],
+           (unsigned long long)((SimNow() - ui64Start) / (SYSCLOCK_HZ / 1000)),
+           ui32Bad);
+}
+
+static uint8_t DropByte(uint32_t ui32Addr, uint32_t ui32Round, uint32_t k){
+    return (uint8_t)(ui32Addr * 29 + ui32Round * 13 + k * 5);
+}
+
+// Slaves answer with the request xor their address
+static uint32_t DropRequest(void *pvContext, const uint8_t *pui8Data,
+                            uint32_t ui32Len, uint8_t *pui8Reply){
+    MultidropSlave *psSlave = (MultidropSlave *)pvContext;
+    for(uint32_t k = 0; k < ui32Len; k++){
+        pui8Reply[k] = pui8Data[k] ^ psSlave->address();
+    }
+    return ui32Len;
+}
+
+struct DropCheck {
+    MultidropMaster *psMaster;
+    uint32_t pui32Round[BENCH_DROP_SLAVES + 1];  // replies per address
+    uint32_t ui32Replies;
+    uint32_t ui32Bad;
+};
+
+// Check a reply against what was asked, then queue the next request
+static void DropReply(void *pvContext, uint8_t ui8Addr,
+                      const uint8_t *pui8Data, uint32_t ui32Len){
+    DropCheck *psCheck = (DropCheck *)pvContext;
+    uint32_t ui32Round = psCheck->pui32Round[ui8Addr];
+    uint8_t pui8Next[BENCH_DROP_PAYLOAD];
+
+    psCheck->ui32Bad += (ui32Len != BENCH_DROP_PAYLOAD);
+    for(uint32_t k = 0; (k < ui32Len) && (k < BENCH_DROP_PAYLOAD); k++){
+        psCheck->ui32Bad += (pui8Data[k] !=
+                             (uint8_t)(DropByte(ui8Addr, ui32Round, k) ^
+                                       ui8Addr));
+    }
+    psCheck->ui32Replies++;
+    psCheck->pui32Round[ui8Addr] = ++ui32Round;
+    for(uint32_t k = 0; k < BENCH_DROP_PAYLOAD; k++){
+        pui8Next[k] = DropByte(ui8Addr, ui32Round, k);
+    }
+    psCheck->psMaster->queue(ui8Addr, pui8Next, BENCH_DROP_PAYLOAD);
+}
+
+//------------BenchMultidrop------------
+// Master on UART1 polling BENCH_DROP_SLAVES slaves on one bus; reports
+// the ISR load of the slave at address 1 (UART2), which is addressed by
+// one poll in BENCH_DROP_SLAVES
+// Input: eMode is hardware (9-bit) or software addressing
+// Output: none
+static void BenchMultidrop(MultidropAddressing eMode){
+    BufferedUART *ppsPort[BENCH_DROP_SLAVES] = {
+        &g_sUART2, &g_sUART3, &g_sUART4, &g_sUART5, &g_sUART6, &g_sUART7
+    };
+    MultidropMaster sMaster(UART1_Buffered, eMode);
+    MultidropSlave *ppsSlave[BENCH_DROP_SLAVES];
+    DropCheck sCheck;
+    uint32_t ui32Bad = 0;
+
+    BenchSetup(BENCH_IRQ, BENCH_DROP_BAUD, &g_psFifo[1]);
+    g_sUART2.open(BENCH_DROP_BAUD);
+    g_sUART3.open(BENCH_DROP_BAUD);
+    g_sUART4.open(BENCH_DROP_BAUD);
+    g_sUART5.open(BENCH_DROP_BAUD);
+    g_sUART6.open(BENCH_DROP_BAUD);
+    g_sUART7.open(BENCH_DROP_BAUD);
+    for(uint32_t i = 1; i <= BENCH_DROP_SLAVES + 1; i++){
+        SimUARTBusJoin(i);
+    }
+
+    memset(&sCheck, 0, sizeof(sCheck));
+    sCheck.psMaster = &sMaster;
+    sMaster.setReplyHandler(DropReply, &sCheck);
+    // a poll and its reply on the line, twice over
+    sMaster.setTimeout((uint32_t)((2ull * 2 * (BENCH_DROP_PAYLOAD +
+                                   MULTIDROP_OVERHEAD) * 12 * 1000000) /
+                                  BENCH_DROP_BAUD));
+    for(uint32_t i = 0; i < BENCH_DROP_SLAVES; i++){
+        uint8_t ui8Addr = (uint8_t)(i + 1);
+        uint8_t pui8Req[BENCH_DROP_PAYLOAD];
+        ppsSlave[i] = new MultidropSlave(*ppsPort[i], ui8Addr, eMode);
+        ppsSlave[i]->setRequestHandler(DropRequest, ppsSlave[i]);
+        ppsSlave[i]->start();
+        sMaster.attach(ui8Addr);
+        for(uint32_t k = 0; k < BENCH_DROP_PAYLOAD; k++){
+            pui8Req[k] = DropByte(ui8Addr, 0, k);
+        }
+        sMaster.queue(ui8Addr, pui8Req, BENCH_DROP_PAYLOAD);
+    }
+    sMaster.start();
+
+    const SimIrqStats *psIrq = SimIrqGetStats(INT_UART2_TM4C123);
+    SimIrqStats sIrqBefore = *psIrq;
+    UARTStats sPortBefore = g_sUART2.stats();
+    uint32_t ui32Polls = BENCH_DROP_ROUNDS * BENCH_DROP_SLAVES;
+    uint64_t ui64Deadline = SimNow() + FrameCycles(BENCH_DROP_BAUD) *
+                            ui32Polls * (BENCH_DROP_PAYLOAD + 8) * 4;
+    while((sCheck.ui32Replies < ui32Polls) && (SimNow() < ui64Deadline)){
+        sMaster.poll();
+        for(uint32_t i = 0; i < BENCH_DROP_SLAVES; i++){
+            ppsSlave[i]->service();
+        }
+        SimAdvance(FrameCycles(BENCH_DROP_BAUD) / 2);
+    }
+    uint32_t ui32Irqs = psIrq->ui32Count - sIrqBefore.ui32Count;
+    uint64_t ui64IsrCycles = psIrq->ui64HandlerCycles -
+                             sIrqBefore.ui64HandlerCycles;
+    uint32_t ui32RxBytes = g_sUART2.stats().rxBytes - sPortBefore.rxBytes;
+
+    uint32_t ui32CrcErrors = sMaster.stats().crcErrors;
+    for(uint32_t i = 0; i < BENCH_DROP_SLAVES; i++){
+        ui32CrcErrors += ppsSlave[i]->stats().crcErrors;
+    }
+    ui32Bad += sCheck.ui32Bad + ui32CrcErrors + sMaster.stats().timeouts +
+               (sCheck.ui32Replies != ui32Polls);
+    if(eMode == MULTIDROP_9BIT){
+        // a slave's ISR must never see another slave's frames
+        ui32Bad += (ppsSlave[0]->stats().foreign != 0);
+    }
+    if(ui32Bad){
+        g_ui32Failures++;
+    }
+    printf("bench=multidrop mode=%s slaves=%u polls=%u replies=%u"
+           " timeouts=%u slave_irqs=%u slave_isr_cycles=%llu"
+           " slave_rx_bytes=%u slave_foreign_frames=%u line_filtered=%u"
+           " errors=%u\n", (eMode == MULTIDROP_9BIT) ? "9bit" : "software",
+           BENCH_DROP_SLAVES, ui32Polls, sCheck.ui32Replies,
+           sMaster.stats().timeouts, ui32Irqs,
+           (unsigned long long)ui64IsrCycles, ui32RxBytes,
+           ppsSlave[0]->stats().foreign, SimUARTGetStats(2)->ui32Filtered,
+           ui32Bad);
+
+    // The last poll and its reply would otherwise be stranded in the TX
+    // rings by the next SimInit
+    uint64_t ui64Drain = SimNow() + FrameCycles(BENCH_DROP_BAUD) * 4 *
+                                    (BENCH_DROP_PAYLOAD + MULTIDROP_OVERHEAD);
+    while(SimNow() < ui64Drain){
+        for(uint32_t i = 0; i < BENCH_DROP_SLAVES; i++){
+            ppsSlave[i]->service();
+        }
+        SimAdvance(FrameCycles(BENCH_DROP_BAUD));
+    }
+    sMaster.stop();
+    for(uint32_t i = 0; i < BENCH_DROP_SLAVES; i++){
+        ppsSlave[i]->stop();
+        delete ppsSlave[i];
+    }
+}
+
+// Slave end of the negotiated link
+static FrameLink g_sUART0Frames(UART0_Buffered);
+
+struct AutoBaudCheck {
+    uint32_t ui32Sent;                  // application frames sent
+    uint32_t ui32Echoed;                // ... and back intact
+    uint32_t ui32Lost;                  // back with a bad check, or never
+};
+
+//------------AutoBaudRun------------
+// Run both ends for a while: the master sends an application frame
+// whenever its line is idle and the slave echoes what it gets
+// Input: sMaster, sSlave negotiating ends, ui32Ms of sim time, psCheck
+//        application frame counters
+// Output: none
+static void AutoBaudRun(AutoBaud &sMaster, AutoBaud &sSlave, uint32_t ui32Ms,
+                        AutoBaudCheck *psCheck){
+    uint8_t pui8Frame[FRAME_MAX_PAYLOAD];
+    uint64_t ui64End = SimNow() + (uint64_t)ui32Ms * (SYSCLOCK_HZ / 1000);
+    while(SimNow() < ui64End){
+        uint32_t ui32Len;
+        sMaster.poll();
+        sSlave.poll();
+        while((ui32Len = g_sUART0Frames.read(pui8Frame,
+                                              sizeof(pui8Frame))) != 0){
+            if(!sSlave.handle(pui8Frame, ui32Len) && sSlave.ready()){
+                g_sUART0Frames.write(pui8Frame, ui32Len);
+            }
+        }
+        while((ui32Len = UART1_Frames.read(pui8Frame,
+                                            sizeof(pui8Frame))) != 0){
+            if(sMaster.handle(pui8Frame, ui32Len)){
+                continue;
+            }
+            if((ui32Len == BENCH_AB_APP_BYTES + 2) &&
+               (Crc16(pui8Frame, ui32Len) == 0)){
+                psCheck->ui32Echoed++;
+            }
+        }
+        if(sMaster.ready() && UART1_Buffered.txIdle()){
+            // sequence byte, pattern and a CRC-16 the receiver checks
+            // whole; never the control frame tag up front
+            pui8Frame[0] = (uint8_t)(psCheck->ui32Sent & 0x7F);
+            for(uint32_t i = 1; i < BENCH_AB_APP_BYTES; i++){
+                pui8Frame[i] = (uint8_t)(psCheck->ui32Sent * 13 + i * 7);
+            }
+            uint16_t ui16Crc = Crc16(pui8Frame, BENCH_AB_APP_BYTES);
+            pui8Frame[BENCH_AB_APP_BYTES] = (uint8_t)(ui16Crc >> 8);
+            pui8Frame[BENCH_AB_APP_BYTES + 1] = (uint8_t)ui16Crc;
+            if(UART1_Frames.write(pui8Frame, BENCH_AB_APP_BYTES + 2)){
+                psCheck->ui32Sent++;
+            }
+        }
+        SimAdvance(2000);
+    }
+    psCheck->ui32Lost = psCheck->ui32Sent - psCheck->ui32Echoed;
+}
+
+//------------BenchAutoBaud------------
+// Negotiate UART1 (master) against UART0 (slave) over a rate limited
+// line, then halve the limit and expect a downshift
+// Input: none
+// Output: none
+static void BenchAutoBaud(void){
+    AutoBaudCheck sClean;
+    AutoBaudCheck sDegraded;
+    uint32_t ui32Errors = 0;
+
+    memset(&sClean, 0, sizeof(sClean));
+    memset(&sDegraded, 0, sizeof(sDegraded));
+    BenchSetup(BENCH_IRQ, AUTOBAUD_SAFE_BAUD, &g_psFifo[1]);
+    SimUARTConnect(0, 1);
+    SimUARTLineLimit(0, BENCH_AB_LIMIT);
+    SimUARTLineLimit(1, BENCH_AB_LIMIT);
+    g_sUART0Frames.start();
+    UART1_Frames.start();
+    AutoBaud sMaster(UART1_Frames, UART1_Buffered, AUTOBAUD_MASTER);
+    AutoBaud sSlave(g_sUART0Frames, UART0_Buffered, AUTOBAUD_SLAVE);
+    sSlave.start();
+    sMaster.start();
+
+    AutoBaudRun(sMaster, sSlave, BENCH_AB_CLEAN_MS, &sClean);
+    uint32_t ui32CleanBaud = sMaster.baud();
+    // fastest ladder rate under the limit. A frame can only be lost in
+    // flight when a rate change starts, or at the end of the run.
+    const AutoBaudStats &sStats = sMaster.stats();
+    ui32Errors += (ui32CleanBaud != 921600) ||
+                  (sSlave.baud() != ui32CleanBaud) ||
+                  (sClean.ui32Lost > sStats.upshifts +
+                                     sStats.failedProbes + 1) ||
+                  (sClean.ui32Echoed == 0);
+
+    SimUARTLineLimit(0, BENCH_AB_LIMIT / 2);
+    SimUARTLineLimit(1, BENCH_AB_LIMIT / 2);
+    AutoBaudRun(sMaster, sSlave, BENCH_AB_DEGRADE_MS, &sDegraded);
+    uint32_t ui32Baud = sMaster.baud();
+    ui32Errors += (ui32Baud != 460800) || (sSlave.baud() != ui32Baud) ||
+                  !sMaster.ready() || !sSlave.ready();
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=autobaud limit=%u clean_baud=%u app_frames=%u app_lost=%u"
+           " limit=%u baud=%u upshifts=%u downshifts=%u failed_probes=%u"
+           " link_lost=%u slave_link_lost=%u errors=%u\n", BENCH_AB_LIMIT,
+           ui32CleanBaud, sClean.ui32Echoed, sClean.ui32Lost,
+           BENCH_AB_LIMIT / 2, ui32Baud, sStats.upshifts, sStats.downshifts,
+           sStats.failedProbes, sStats.linkLost, sSlave.stats().linkLost,
+           ui32Errors);
+
+    // Let both rings drain before the next SimInit strands them
+    while(!UART0_Buffered.txIdle() || !UART1_Buffered.txIdle()){
+        SimAdvance(2000);
+    }
+    g_sUART0Frames.stop();
+    UART1_Frames.stop();
+}
+
+//------------BenchSelfTest------------
+// Loopback self-test of UART1 through one driver
+// Input: ePath selects the driver
+// Output: none
+static void BenchSelfTest(BenchPath ePath){
+    static PolledUART sPolled(UART1_BASE);
+    static const SelfTestMode peMode[] = {
+        SELFTEST_POLLED, SELFTEST_IRQ, SELFTEST_DMA
+    };
+    uint32_t ui32Errors = 0;
+    uint32_t ui32Rates = 0;
+
+    BenchSetup(ePath, 115200, &g_psFifo[1]);
+    // rates the clock can make, so all of them should pass
+    while((ui32Rates < AUTOBAUD_RATES) &&
+          (AutoBaud_Ladder[ui32Rates] <= BaudCalc::maxBaud(SYSCLOCK_HZ)) &&
+          (BaudCalc::errorPpm(SYSCLOCK_HZ, AutoBaud_Ladder[ui32Rates]) <=
+           BAUD_MAX_ERROR_PPM)){
+        ui32Rates++;
+    }
+    uint32_t ui32IBRD = HWREG(UART1_BASE + UART_O_IBRD);
+    uint32_t ui32CTL = HWREG(UART1_BASE + UART_O_CTL);
+    const SelfTestResult *psResult;
+    if(ePath == BENCH_POLLED){
+        psResult = SelfTest_Run(sPolled, UART1_BASE, SELFTEST_POLLED, 0);
+    }else{
+        psResult = SelfTest_Run(Stream(ePath, 1), UART1_BASE, peMode[ePath],
+                                (ePath == BENCH_IRQ) ? UART1_Handler :
+                                                       UART1_DMAHandler);
+    }
+    uint32_t ui32Restored = (HWREG(UART1_BASE + UART_O_IBRD) == ui32IBRD) &&
+                            (HWREG(UART1_BASE + UART_O_CTL) == ui32CTL);
+    ui32Errors = psResult->errors + (psResult->rates != ui32Rates) +
+                 (psResult->maxBaud != AutoBaud_Ladder[ui32Rates - 1]) +
+                 !ui32Restored + (SelfTest_Best(UART1_BASE) == 0);
+
+    // The port must still carry traffic through its driver afterwards
+    if(ePath != BENCH_POLLED){
+        uint8_t pui8Back[BENCH_CHUNK];
+        uint32_t ui32Got = 0;
+        SimUARTHostWrite(1, g_pui8Pattern, BENCH_CHUNK);
+        uint64_t ui64Deadline = SimNow() + FrameCycles(115200) *
+                                           BENCH_CHUNK * 2;
+        while((ui32Got < BENCH_CHUNK) && (SimNow() < ui64Deadline)){
+            ui32Got += Stream(ePath, 1).read(&pui8Back[ui32Got],
+                                             BENCH_CHUNK - ui32Got);
+            SimAdvance(FrameCycles(115200));
+        }
+        ui32Errors += (ui32Got != BENCH_CHUNK) ||
+                      (memcmp(pui8Back, g_pui8Pattern, BENCH_CHUNK) != 0);
+    }
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=selftest port=1 mode=%s max_baud=%u cyc_per_byte=%u"
+           " rates=%u fail_baud=%u restored=%u errors=%u\n",
+           g_ppcPathName[ePath], psResult->maxBaud, psResult->cycPerByte,
+           psResult->rates, psResult->failBaud, ui32Restored, ui32Errors);
+}
+
+// Host input for one escape case: each text is sent, then the line is
+// left idle for the wait
+struct EscStep {
+    const char *pcText;
+    uint32_t ui32WaitMs;
+};
+
+struct EscCase {
+    const char *pcName;
+    EscStep psStep[BENCH_ESC_STEPS];
+    bool bEscape;                       // expected to be reported
+};
+
+#define ESC_G   BENCH_ESC_GUARD_MS
+static const EscCase g_psEscCase[] = {
+    {"clean", {{"+++", 3 * ESC_G}}, true},
+    {"slow", {{"+", ESC_G / 2}, {"+", ESC_G / 2}, {"+", 3 * ESC_G}}, true},
+    {"no_lead_guard", {{"x+++", 3 * ESC_G}}, false},
+    {"no_trail_guard", {{"+++x", 3 * ESC_G}}, false},
+    {"gap_too_long", {{"++", 2 * ESC_G}, {"+", 3 * ESC_G}}, false},
+    {"four", {{"++++", 3 * ESC_G}}, false},
+    {"in_data", {{"ab+++cd", 3 * ESC_G}}, false},
+};
+#define BENCH_ESC_CASES (sizeof(g_psEscCase) / sizeof(g_psEscCase[0]))
+
+// Let ui32Ms of sim time pass, polling the detector every quarter ms
+// Output: escapes reported; the first one's time in *pui64At
+static uint32_t EscWait(EscapeDetector &sEsc, uint32_t ui32Ms,
+                        uint64_t *pui64At){
+    uint32_t ui32Seen = 0;
+    for(uint32_t i = 0; i < ui32Ms * 4; i++){
+        SimAdvance(SYSCLOCK_HZ / 4000);
+        if(sEsc.poll()){
+            if(ui32Seen++ == 0){
+                *pui64At = SimNow();
+            }
+        }
+    }
+    return ui32Seen;
+}
+
+//------------BenchEscape------------
+// Run each escape case against UART0
+// Input: none
+// Output: none
+static void BenchEscape(void){
+    uint8_t pui8Back[BENCH_CHUNK];
+    uint64_t ui64At = 0;
+
+    BenchSetup(BENCH_IRQ, 115200, &g_psFifo[1]);
+    IntRegister(FAULT_SYSTICK, SysTick_Handler);
+    Timebase_Init();
+    EscapeDetector sEsc(UART0_Buffered, BENCH_ESC_GUARD_MS);
+    sEsc.start();
+
+    for(uint32_t c = 0; c < BENCH_ESC_CASES; c++){
+        const EscCase &sCase = g_psEscCase[c];
+        uint32_t ui32Sent = 0;
+        uint32_t ui32Got = 0;
+        uint32_t ui32Seen = EscWait(sEsc, 2 * BENCH_ESC_GUARD_MS, &ui64At);
+        uint64_t ui64LastRx = 0;
+        ui32Seen = 0;
+        while(UART0_Buffered.read(pui8Back, sizeof(pui8Back)));
+        for(uint32_t i = 0; (i < BENCH_ESC_STEPS) && sCase.psStep[i].pcText;
+            i++){
+            uint32_t ui32Len = (uint32_t)strlen(sCase.psStep[i].pcText);
+            SimUARTHostWrite(0, (const uint8_t *)sCase.psStep[i].pcText,
+                             ui32Len);
+            ui32Sent += ui32Len;
+            // the bytes first, so the wait is idle line
+            SimAdvance((uint32_t)FrameCycles(115200) * (ui32Len + 1));
+            ui64LastRx = SimUARTGetStats(0)->ui64LastRx;
+            ui32Seen += EscWait(sEsc, sCase.psStep[i].ui32WaitMs, &ui64At);
+            ui32Got += UART0_Buffered.read(pui8Back, sizeof(pui8Back));
+        }
+        uint64_t ui64LatencyUs = (ui32Seen != 0) ?
+            (ui64At - ui64LastRx) / (SYSCLOCK_HZ / 1000000) : 0;
+        // reported once, no sooner than the guard time and within a tick
+        // and a poll after it
+        uint32_t ui32Errors = (ui32Seen != (sCase.bEscape ? 1u : 0u)) +
+            (ui32Got != ui32Sent) +
+            ((ui32Seen != 0) &&
+             ((ui64LatencyUs <= BENCH_ESC_GUARD_MS * 1000ull) ||
+              (ui64LatencyUs > BENCH_ESC_GUARD_MS * 1000ull + 1500)));
+        if(ui32Errors){
+            g_ui32Failures++;
+        }
+        printf("bench=escape case=%s guard_ms=%u detected=%u latency_us=%llu"
+               " bytes=%u delivered=%u errors=%u\n", sCase.pcName,
+               BENCH_ESC_GUARD_MS, ui32Seen,
+               (unsigned long long)ui64LatencyUs, ui32Sent, ui32Got,
+               ui32Errors);
+    }
+
+    sEsc.stop();
+}
+
+// The shell's one command: records its argv joined with spaces
+static char g_pcShellArgs[SHELL_LINE_MAX + 1];
+static uint32_t g_ui32ShellRuns;
+
+static bool ShellEcho(ByteStream &sOut, uint32_t ui32Argc, char *ppcArgv[]){
+    (void)sOut;
+    g_pcShellArgs[0] = 0;
+    for(uint32_t i = 0; i < ui32Argc; i++){
+        if(i){
+            strcat(g_pcShellArgs, " ");
+        }
+        strcat(g_pcShellArgs, ppcArgv[i]);
+    }
+    g_ui32ShellRuns++;
+    return ui32Argc > 1;
+}
+
+static bool ShellNop(ByteStream &sOut, uint32_t ui32Argc, char *ppcArgv[]){
+    (void)sOut;
+    (void)ui32Argc;
+    (void)ppcArgv;
+    return true;
+}
+
+// Two port reports, as the target's "uart" command prints: more than the
+// TX ring holds
+static bool ShellStats(ByteStream &sOut, uint32_t ui32Argc, char *ppcArgv[]){
+    (void)ui32Argc;
+    (void)ppcArgv;
+    UART_Report(sOut, "uart0", UART0_Buffered.stats());
+    UART_Report(sOut, "uart1", UART1_Buffered.stats());
+    return true;
+}
+
+static constexpr ShellCommand g_psShellCmd[] = {
+    {"echo", ShellEcho, "echo <args>"},
+    {"stats", ShellStats, "stats"},
+    {"help", ShellNop, "help"},
+    {"ato", ShellNop, "ato"},
+};
+static constexpr ShellIndex g_sShellIndex = Shell_Index(g_psShellCmd);
+static_assert(g_sShellIndex.perfect, "bench shell commands collide");
+
+struct ShellCase {
+    const char *pcName;
+    const char *pcKeys;
+    uint32_t ui32Runs;                  // echo runs expected
+    const char *pcArgs;                 // what the last one saw
+    const char *pcReply;                // expected in the output, or 0
+};
+
+// In order: the history cases recall lines typed by the ones before
+static const ShellCase g_psShellCase[] = {
+    {"plain", "echo a b\r", 1, "echo a b", 0},
+    {"spaces", "  echo   sp  \r", 1, "echo sp", 0},
+    {"backspace", "echx\bo bs\r", 1, "echo bs", 0},
+    {"del", "echo dell\x7F\r", 1, "echo del", 0},
+    {"cursor_insert", "eco ins\x1B[D\x1B[D\x1B[D\x1B[D\x1B[Dh\r", 1,
+     "echo ins", 0},
+    {"delete_key", "echoo dk\x1B[D\x1B[D\x1B[D\x1B[D\x1B[3~\r", 1,
+     "echo dk", 0},
+    {"history_up", "\x1B[A\x1B[A\r", 1, "echo ins", 0},
+    {"history_down", "\x1B[A\x1B[A\x1B[B\r", 1, "echo ins", 0},
+    {"history_edit", "\x1B[A\b\bup\r", 1, "echo iup", 0},
+    {"uppercase", "ECHO Up\r", 1, "echo Up", 0},
+    {"two_lines", "echo one\recho two\r", 2, "echo two", 0},
+    {"unknown", "nope\r", 0, 0, "ERROR"},
+    {"usage", "echo\r", 1, "echo", "usage: echo <args>"},
+    {"empty", "\r\n\r", 0, 0, 0},
+    {"long_output", "stats\r", 0, 0, "port=uart1"},
+};
+#define BENCH_SHELL_CASES (sizeof(g_psShellCase) / sizeof(g_psShellCase[0]))
+
+//------------BenchShell------------
+// Type each case into a shell on UART0, polling it as the main loop would
+// Input: none
+// Output: none
+static void BenchShell(void){
+    char pcOut[BENCH_SHELL_OUT + 1];
+    uint32_t ui32PollMax = 0;
+
+    BenchSetup(BENCH_IRQ, 115200, &g_psFifo[1]);
+    Shell sShell(UART0_Buffered, g_psShellCmd, g_sShellIndex);
+    sShell.start();
+    SimAdvance(FrameCycles(115200) * 4);
+    while(SimUARTHostRead(0, (uint8_t *)pcOut, BENCH_SHELL_OUT));
+
+    for(uint32_t c = 0; c < BENCH_SHELL_CASES; c++){
+        const ShellCase &sCase = g_psShellCase[c];
+        uint32_t ui32Len = (uint32_t)strlen(sCase.pcKeys);
+        uint32_t ui32Runs = g_ui32ShellRuns;
+        g_pcShellArgs[0] = 0;
+        SimUARTHostWrite(0, (const uint8_t *)sCase.pcKeys, ui32Len);
+        // one poll per frame time, as the main loop would between other
+        // work; the ISR refills the TX FIFO between steps and poll()
+        // hands the ring whatever output it is still holding
+        uint32_t ui32Out = 0;
+        for(uint32_t i = 0; i < ui32Len + BENCH_SHELL_OUT; i++){
+            SimAdvance(FrameCycles(115200));
+            uint64_t ui64Start = SimNow();
+            sShell.poll();
+            uint64_t ui64Cycles = SimNow() - ui64Start;
+            if(ui64Cycles > ui32PollMax){
+                ui32PollMax = (uint32_t)ui64Cycles;
+            }
+            ui32Out += SimUARTHostRead(0, (uint8_t *)&pcOut[ui32Out],
+                                       BENCH_SHELL_OUT - ui32Out);
+        }
+        pcOut[ui32Out] = 0;
+        ui32Runs = g_ui32ShellRuns - ui32Runs;
+        uint32_t ui32Errors = (ui32Runs != sCase.ui32Runs) +
+            ((sCase.pcArgs != 0) && (strcmp(g_pcShellArgs, sCase.pcArgs) != 0)) +
+            ((sCase.pcReply != 0) && (strstr(pcOut, sCase.pcReply) == 0));
+        if(ui32Errors){
+            g_ui32Failures++;
+        }
+        printf("bench=shell case=%s keys=%u runs=%u args=\"%s\" out_bytes=%u"
+               " errors=%u\n", sCase.pcName, ui32Len, ui32Runs,
+               g_pcShellArgs, ui32Out, ui32Errors);
+    }
+    uint32_t ui32Errors = (sShell.find("stats") != &g_psShellCmd[1]) +
+                          (sShell.find("stat") != 0) +
+                          (sShell.find("statss") != 0) +
+                          (sShell.dropped() != 0) +
+                          (ui32PollMax > BENCH_SHELL_POLL_MAX);
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=shell case=index commands=%u seed=%u poll_max_cycles=%u"
+           " dropped=%u errors=%u\n", g_sShellIndex.count,
+           g_sShellIndex.seed, ui32PollMax, sShell.dropped(), ui32Errors);
+}
+
+static const uint32_t g_pui32UartReg[BENCH_UART_REGS] = {
+    UART_O_CTL, UART_O_IBRD, UART_O_FBRD, UART_O_LCRH, UART_O_IFLS, UART_O_IM
+};
+
+// UART and NVIC registers a port's setup leaves behind
+static void UartSnapshot(uint32_t ui32Base, uint32_t *pui32Regs){
+    for(uint32_t i = 0; i < BENCH_UART_REGS; i++){
+        pui32Regs[i] = HWREG(ui32Base + g_pui32UartReg[i]);
+    }
+    for(uint32_t i = 0; i < BENCH_NVIC_WORDS; i++){
+        pui32Regs[BENCH_UART_REGS + i] = HWREG(NVIC_EN0 + 4 * i);
+    }
+}
+
+//------------CheckUart------------
+// Set a port up with uart.c calls and again with Uart<BASE>, each from a
+// fresh simulation, then tear it down both ways
+// Input: none
+// Output: number of registers that differ
+template <uint32_t BASE>
+static uint32_t CheckUart(void){
+    typedef Uart<BASE> U;
+    uint32_t pui32Lib[BENCH_UART_REGS + BENCH_NVIC_WORDS];
+    uint32_t pui32Tmpl[BENCH_UART_REGS + BENCH_NVIC_WORDS];
+    uint32_t ui32Errors = 0;
+
+    SimInit(SYSCLOCK_HZ);
+    UARTConfigSetExpClk(BASE, SYSCLOCK_HZ, 115200, UART_CONFIG_WLEN_8 |
+                        UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE);
+    UARTFIFOLevelSet(BASE, UART_FIFO_TX2_8, UART_FIFO_RX6_8);
+    UARTIntEnable(BASE, UART_INT_RX | UART_INT_RT | UART_INT_OE);
+    IntEnable(U::INT_NUM);
+    UartSnapshot(BASE, pui32Lib);
+
+    SimInit(SYSCLOCK_HZ);
+    U::template configure<SYSCLOCK_HZ, 115200>(UART_LCRH_WLEN_8);
+    U::fifoLevelSet(UART_FIFO_TX2_8, UART_FIFO_RX6_8);
+    U::intEnable(UART_INT_RX | UART_INT_RT | UART_INT_OE);
+    U::nvicEnable();
+    UartSnapshot(BASE, pui32Tmpl);
+    for(uint32_t i = 0; i < BENCH_UART_REGS + BENCH_NVIC_WORDS; i++){
+        ui32Errors += pui32Lib[i] != pui32Tmpl[i];
+    }
+
+    IntDisable(U::INT_NUM);
+    UARTIntDisable(BASE, UART_INT_RT);
+    UARTDisable(BASE);
+    UartSnapshot(BASE, pui32Lib);
+    U::nvicEnable();
+    U::intEnable(UART_INT_RT);
+    U::enable();
+    U::nvicDisable();
+    U::intDisable(UART_INT_RT);
+    U::disable();
+    UartSnapshot(BASE, pui32Tmpl);
+    for(uint32_t i = 0; i < BENCH_UART_REGS + BENCH_NVIC_WORDS; i++){
+        ui32Errors += pui32Lib[i] != pui32Tmpl[i];
+    }
+    return ui32Errors;
+}
+
+//------------BenchUartTmpl------------
+// Check Uart<BASE> against uart.c on all eight ports, then echo a
+// pattern through UART0 with the template's polled calls
+// Input: none
+// Output: none
+static void BenchUartTmpl(void){
+    typedef Uart<UART0_BASE> U0;
+    uint8_t pui8Echo[BENCH_CHUNK];
+    uint32_t ui32Errors = CheckUart<UART0_BASE>() + CheckUart<UART1_BASE>() +
+                          CheckUart<UART2_BASE>() + CheckUart<UART3_BASE>() +
+                          CheckUart<UART4_BASE>() + CheckUart<UART5_BASE>() +
+                          CheckUart<UART6_BASE>() + CheckUart<UART7_BASE>();
+
+    SimInit(SYSCLOCK_HZ);
+    U0::configure<SYSCLOCK_HZ, 115200>(UART_LCRH_WLEN_8);
+    SimUARTHostWrite(0, g_pui8Pattern, BENCH_CHUNK);
+    uint32_t ui32Echoed = 0;
+    while(ui32Echoed < BENCH_CHUNK){
+        int32_t i32Data = U0::charGetNonBlocking();
+        if(i32Data < 0){
+            SimAdvance(FrameCycles(115200));
+            continue;
+        }
+        U0::charPut((uint8_t)i32Data);
+        ui32Echoed++;
+    }
+    while(U0::busy() || !(HWREG(UART0_BASE + UART_O_FR) & UART_FR_TXFE)){
+        SimAdvance(FrameCycles(115200));
+    }
+    SimAdvance(FrameCycles(115200));
+    uint32_t ui32Got = SimUARTHostRead(0, pui8Echo, sizeof(pui8Echo));
+    ui32Errors += (ui32Got != BENCH_CHUNK) ||
+                  (memcmp(pui8Echo, g_pui8Pattern, BENCH_CHUNK) != 0);
+    if(ui32Errors){
+        g_ui32Failures++;
+    }
+    printf("bench=uart_tmpl ports=%u echo_bytes=%u errors=%u\n", UART_PORTS,
+           ui32Got, ui32Errors);
+}
+
+int main(void){
+    static const BenchFifo sPolledFifo = {0, 0, false, "none"};
+    const BenchFifo *psDMAFifo = &g_psFifo[1];  // matches DMAUART bursts
+
+    for(uint32_t i = 0; i < BENCH_ECHO_BYTES; i++){
+        g_pui8Pattern[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    for(uint32_t b = 0; b < BENCH_BAUDS; b++){
+        uint32_t ui32Baud = g_pui32Baud[b];
+        BenchEcho(BENCH_POLLED, ui32Baud, &sPolledFifo);
+        BenchBridge(BENCH_POLLED, ui32Baud, &sPolledFifo);
+        for(uint32_t f = 0; f < BENCH_FIFOS; f++){
+            BenchEcho(BENCH_IRQ, ui32Baud, &g_psFifo[f]);
+            BenchBridge(BENCH_IRQ, ui32Baud, &g_psFifo[f]);
+        }
+        BenchEcho(BENCH_DMA, ui32Baud, psDMAFifo);
+        BenchBridge(BENCH_DMA, ui32Baud, psDMAFifo);
+        BenchFrames(ui32Baud);
+    }
+    BenchHub();
+    BenchRxErrors(BENCH_IRQ, 115200);
+    BenchRxErrors(BENCH_DMA, 115200);
+    BenchFlow(UART_FLOW_NONE);
+    BenchFlow(UART_FLOW_RTSCTS);
+    BenchFlow(UART_FLOW_XONXOFF);
+    BenchFlowMutual();
+    BenchMultidrop(MULTIDROP_SOFTWARE);
+    BenchMultidrop(MULTIDROP_9BIT);
+    BenchAutoBaud();
+    BenchSelfTest(BENCH_POLLED);
+    BenchSelfTest(BENCH_IRQ);
+    BenchSelfTest(BENCH_DMA);
+    BenchEscape();
+    BenchShell();
+    BenchUartTmpl();
+    BenchRing();
+    BenchProfile();
+    BenchCobs();
+    BenchCrc();
+    return g_ui32Failures ? 1 : 0;
+}
+
+#endif // HOST_SIM
@@ -0,0 +1,69 @@
+/*
+ * sim_regs.c
+ *
+ *  Open addressed register file used by HOST_SIM builds. Registers spring
+ *  into existence (reading as zero) the first time they are touched.
+ */
+
+#ifdef HOST_SIM
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_regs.h"
+
+#define SIM_REG_SLOTS 4096              // must be a power of two
+#define SIM_SRAM_BASE 0x20000000u       // bus window for host memory
+#define SIM_SRAM_SIZE 0x20000000u
+
+static uint32_t g_pui32SimAddr[SIM_REG_SLOTS];
+static volatile uint32_t g_pui32SimValue[SIM_REG_SLOTS];
+static uint8_t g_pui8SimUsed[SIM_REG_SLOTS];
+static uintptr_t g_uiSimSramAnchor;     // host address of SIM_SRAM_BASE
+
+volatile uint32_t *SimRegAddr(uint32_t ui32Addr){
+    uint32_t ui32Idx = (ui32Addr >> 2) * 2654435761u;
+    uint32_t ui32Probe;
+
+    ui32Addr &= ~3u;
+    for(ui32Probe = 0; ui32Probe < SIM_REG_SLOTS; ui32Probe++){
+        ui32Idx &= (SIM_REG_SLOTS - 1);
+        if(!g_pui8SimUsed[ui32Idx]){
+            g_pui8SimUsed[ui32Idx] = 1;
+            g_pui32SimAddr[ui32Idx] = ui32Addr;
+            g_pui32SimValue[ui32Idx] = 0;
+            return(&g_pui32SimValue[ui32Idx]);
+        }
+        if(g_pui32SimAddr[ui32Idx] == ui32Addr){
+            return(&g_pui32SimValue[ui32Idx]);
+        }
+        ui32Idx++;
+    }
+    abort();                            // register file exhausted
+}
+
+void SimRegReset(void){
+    memset(g_pui8SimUsed, 0, sizeof(g_pui8SimUsed));
+}
+
+uint32_t SimBusAddr(const volatile void *pvHost){
+    uintptr_t uiHost = (uintptr_t)pvHost;
+
+    if(g_uiSimSramAnchor == 0){
+        // Centre the window on the first address seen
+        g_uiSimSramAnchor = uiHost - (SIM_SRAM_SIZE / 2);
+    }
+    if((uiHost - g_uiSimSramAnchor) >= SIM_SRAM_SIZE){
+        abort();                        // outside the mapped window
+    }
+    return(SIM_SRAM_BASE + (uint32_t)(uiHost - g_uiSimSramAnchor));
+}
+
+void *SimHostPtr(uint32_t ui32Bus){
+    if((ui32Bus - SIM_SRAM_BASE) >= SIM_SRAM_SIZE){
+        abort();                        // not an SRAM address
+    }
+    return((void *)(g_uiSimSramAnchor + (ui32Bus - SIM_SRAM_BASE)));
+}
+
+#endif // HOST_SIM
@@ -0,0 +1,93 @@
+/*
+ * sim_regs.h
+ *
+ *  Host-side stand-in for the memory mapped peripheral space. Only used
+ *  when building with HOST_SIM defined; hw_types.h pulls this in instead
+ *  of the raw pointer casts. From C++, HWREG() goes through the simulated
+ *  peripherals in sim_tm4c.cpp; from C, and for HWREGH/HWREGB, it lands
+ *  in an ordinary register file with no side effects.
+ */
+
+#ifndef SIM_REGS_H_
+#define SIM_REGS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//------------SimRegAddr------------
+// Look up (allocating on first use) the storage backing a register
+// Input: ui32Addr is the 32-bit aligned peripheral address
+// Output: pointer to the simulated register word
+extern volatile uint32_t *SimRegAddr(uint32_t ui32Addr);
+
+//------------SimRegReset------------
+// Return every simulated register to zero
+// Input: none
+// Output: none
+extern void SimRegReset(void);
+
+//------------SimBusAddr/SimHostPtr------------
+// Map host memory into a 512 MB window at the SRAM base (0x20000000) so
+// structures that hold 32-bit bus addresses, like the uDMA control table,
+// can point at host data. The window is anchored on the first address
+// mapped, so it covers the program's static data but not its stack.
+// Input: pvHost is a host pointer, ui32Bus a bus address in the window
+// Output: the matching bus address or host pointer
+extern uint32_t SimBusAddr(const volatile void *pvHost);
+extern void *SimHostPtr(uint32_t ui32Bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+//------------SimRegRead/SimRegWrite------------
+// Register access with peripheral side effects (FIFO pops, write-one-to
+// clear, time advancing), implemented by the simulator in sim_tm4c.cpp
+extern "C" uint32_t SimRegRead(uint32_t ui32Addr);
+extern "C" void SimRegWrite(uint32_t ui32Addr, uint32_t ui32Value);
+
+// Stand-in for a volatile register lvalue. Every read and write goes
+// through the simulator, so HWREG(x) |= y is a read followed by a write
+// exactly as on the bus.
+class SimReg {
+public:
+    explicit SimReg(uint32_t ui32Addr) : m_ui32Addr(ui32Addr) {}
+    operator uint32_t() const { return SimRegRead(m_ui32Addr); }
+    SimReg &operator=(uint32_t ui32Value){
+        SimRegWrite(m_ui32Addr, ui32Value);
+        return *this;
+    }
+    SimReg &operator=(const SimReg &sReg){ return *this = (uint32_t)sReg; }
+    SimReg &operator|=(uint32_t ui32Value){ return *this = *this | ui32Value; }
+    SimReg &operator&=(uint32_t ui32Value){ return *this = *this & ui32Value; }
+    SimReg &operator^=(uint32_t ui32Value){ return *this = *this ^ ui32Value; }
+    SimReg &operator+=(uint32_t ui32Value){ return *this = *this + ui32Value; }
+    SimReg &operator-=(uint32_t ui32Value){ return *this = *this - ui32Value; }
+
+private:
+    uint32_t m_ui32Addr;
+};
+
+#define HWREG(x)                                                              \
+        SimReg((uint32_t)(x))
+
+#else
+
+#define HWREG(x)                                                              \
+        (*SimRegAddr((uint32_t)(x)))
+
+#endif
+#define HWREGH(x)                                                             \
+        (*((volatile uint16_t *)SimRegAddr((uint32_t)(x) & ~3u) +             \
+           (((uint32_t)(x) >> 1) & 1)))
+#define HWREGB(x)                                                             \
+        (*((volatile uint8_t *)SimRegAddr((uint32_t)(x) & ~3u) +              \
+           ((uint32_t)(x) & 3)))
+
+#endif /* SIM_REGS_H_ */
@@ -0,0 +1,1324 @@
+/*
+ * sim_tm4c.cpp
+ *
+ *  Event driven models behind the HOST_SIM register proxy: UART0-7,
+ *  micro-DMA, NVIC, SysTick and the DWT cycle counter. See sim_tm4c.h.
+ */
+
+#ifdef HOST_SIM
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_nvic.h"
+#include "hw_sysctl.h"
+#include "hw_uart.h"
+#include "cpu.h"
+#include "uart.h"
+#include "uDMA.h"
+#include "sim_regs.h"
+#include "sim_tm4c.h"
+
+#define SIM_FIFO_DEPTH      16
+#define SIM_LINE_SIZE       4096        // host side bytes per direction
+#define SIM_RT_BITS         32          // receive timeout, in bit periods
+#define SIM_PIOSC_HZ        16000000
+#define SIM_VECTORS         155         // NUM_INTERRUPTS in interrupt.c
+#define SIM_IRQ_WORDS       5           // NVIC EN0-EN4
+#define SIM_DISPATCH_LIMIT  100000      // handlers per dispatch pass
+#define SIM_DMA_PASS_LIMIT  1024        // arbitration rounds per service
+#define SIM_NEVER           UINT64_MAX
+#define SIM_XON             0x11
+#define SIM_XOFF            0x13
+#define SIM_ADDR_CHAR       0x8000      // line frame carries a set 9th bit
+
+// RAM vector table in interrupt.c (HOST_SIM branch)
+extern void (*g_pfnRAMVectors[SIM_VECTORS])(void);
+
+struct SimFifo {
+    uint16_t pui16Data[SIM_FIFO_DEPTH]; // data plus DR error bits
+    uint32_t ui32Head;
+    uint32_t ui32Count;
+};
+
+struct SimLine {
+    uint8_t pui8Data[SIM_LINE_SIZE];
+    uint32_t ui32Head;
+    uint32_t ui32Count;
+};
+
+struct SimUART {
+    uint32_t ui32Base;
+    uint32_t ui32Vector;
+    uint32_t ui32IBRD, ui32FBRD, ui32LCRH, ui32CTL, ui32IFLS;
+    uint32_t ui32IM, ui32RIS, ui32RSR, ui32CC, ui32DMACTL;
+    uint32_t ui329BitAddr, ui329BitMask;
+    SimFifo sRx;
+    SimFifo sTx;
+    bool bShifting;                     // frame on the TX line
+    uint16_t ui16Shift;
+    uint64_t ui64ShiftDone;
+    uint64_t ui64ShiftFrame;            // frame time of the byte on the line
+    uint64_t ui64LastRx;                // last frame into the RX FIFO
+    bool bTimeoutDone;                  // RT raised since ui64LastRx
+    int32_t i32Peer;                    // connected port, -1 = host
+    bool bBus;                          // on the shared multidrop bus
+    bool b9BitMatch;                    // last address character was ours
+    uint32_t ui32LineLimit;             // fastest clean rate to the peer
+    uint32_t ui32LineFrames;            // frames sent above the limit
+    SimLine sIn;                        // host -> RX line
+    SimLine sOut;                       // TX line -> host
+    uint64_t ui64InNext;                // next host frame completes
+    uint32_t ui32HostBaud;
+    bool bHostFlow;                     // host only sends while RTS is asserted
+    bool bHostCts;                      // CTS the host drives, if no peer
+    bool bHostXonXoff;                  // host obeys XON/XOFF from the port
+    bool bHostXoff;                     // ... and has been sent XOFF
+    bool bInHeld;                       // host data waiting on RTS or XON
+    bool bRts;                          // RTS output as last seen by the peer
+    SimUARTStats sStats;
+};
+
+static const uint32_t g_pui32UARTBase[SIM_UARTS] = {
+    UART0_BASE, UART1_BASE, UART2_BASE, UART3_BASE,
+    UART4_BASE, UART5_BASE, UART6_BASE, UART7_BASE
+};
+static const uint32_t g_pui32UARTVector[SIM_UARTS] = {
+    INT_UART0_TM4C123, INT_UART1_TM4C123, INT_UART2_TM4C123,
+    INT_UART3_TM4C123, INT_UART4_TM4C123, INT_UART5_TM4C123,
+    INT_UART6_TM4C123, INT_UART7_TM4C123
+};
+// FIFO trigger levels for IFLS selections 1/8, 1/4, 1/2, 3/4, 7/8
+static const uint32_t g_pui32Level[8] = {2, 4, 8, 12, 14, 14, 14, 14};
+
+// UART request lines in the uDMA channel map (datasheet table 9-1)
+struct SimDMAMap {
+    uint8_t ui8Channel;
+    uint8_t ui8Encoding;
+    uint8_t ui8Port;
+    bool bTx;
+};
+static const SimDMAMap g_psDMAMap[] = {
+    {0, 1, 2, false}, {1, 1, 2, true},
+    {8, 0, 0, false}, {9, 0, 0, true},
+    {8, 1, 1, false}, {9, 1, 1, true},
+    {12, 1, 2, false}, {13, 1, 2, true},
+    {22, 0, 1, false}, {23, 0, 1, true},
+};
+#define SIM_DMA_MAPS (sizeof(g_psDMAMap) / sizeof(g_psDMAMap[0]))
+
+static uint32_t g_ui32ClockHz;
+static uint64_t g_ui64Now;
+static uint64_t g_ui64Sleep;
+static bool g_bDeepSleep;               // inside a WFI with SLEEPDEEP set
+static SimUART g_psUART[SIM_UARTS];
+
+static uint32_t g_pui32En[SIM_IRQ_WORDS];
+static uint32_t g_pui32Pend[SIM_IRQ_WORDS];     // software pended
+static uint32_t g_pui32Active[SIM_IRQ_WORDS];
+static bool g_bPrimask;
+static uint32_t g_ui32Basepri;
+static bool g_bInHandler;
+
+static uint32_t g_ui32StCtrl;
+static uint32_t g_ui32StReload;
+static bool g_bStRunning;
+static uint64_t g_ui64StLoadAt;         // counter held g_ui32StLoadVal here
+static uint32_t g_ui32StLoadVal;
+static bool g_bStZeroDone;              // zero of this count already seen
+static bool g_bStCount;                 // COUNTFLAG
+static bool g_bStPending;
+
+static uint64_t g_ui64CycBase;          // DWT CYCCNT = now - base
+
+static uint32_t g_ui32DMACfg;
+static uint32_t g_ui32DMACtlBase;
+static uint32_t g_ui32DMAEna;
+static uint32_t g_ui32DMAAlt;
+static uint32_t g_ui32DMABurst;         // USEBURST
+static uint32_t g_ui32DMAMask;          // REQMASK
+static uint32_t g_ui32DMAPrio;
+static uint32_t g_ui32DMAChis;
+static uint32_t g_pui32DMAChMap[4];
+
+static uint64_t g_pui64Asserted[SIM_VECTORS];   // line asserted since
+static SimIrqStats g_psIrqStats[SIM_VECTORS];
+
+//*****************************************************************************
+//
+// FIFOs and host lines
+//
+//*****************************************************************************
+static void FifoPush(SimFifo &sFifo, uint16_t ui16Value){
+    sFifo.pui16Data[(sFifo.ui32Head + sFifo.ui32Count) % SIM_FIFO_DEPTH] =
+        ui16Value;
+    sFifo.ui32Count++;
+}
+
+static uint16_t FifoPop(SimFifo &sFifo){
+    uint16_t ui16Value = sFifo.pui16Data[sFifo.ui32Head];
+    sFifo.ui32Head = (sFifo.ui32Head + 1) % SIM_FIFO_DEPTH;
+    sFifo.ui32Count--;
+    return ui16Value;
+}
+
+static bool LinePush(SimLine &sLine, uint8_t ui8Data){
+    if(sLine.ui32Count == SIM_LINE_SIZE){
+        return false;
+    }
+    sLine.pui8Data[(sLine.ui32Head + sLine.ui32Count) % SIM_LINE_SIZE] =
+        ui8Data;
+    sLine.ui32Count++;
+    return true;
+}
+
+static uint8_t LinePop(SimLine &sLine){
+    uint8_t ui8Data = sLine.pui8Data[sLine.ui32Head];
+    sLine.ui32Head = (sLine.ui32Head + 1) % SIM_LINE_SIZE;
+    sLine.ui32Count--;
+    return ui8Data;
+}
+
+//*****************************************************************************
+//
+// UART model
+//
+//*****************************************************************************
+static uint32_t FrameBits(const SimUART &sUART){
+    return 1 + 5 + ((sUART.ui32LCRH & UART_LCRH_WLEN_M) >> 5) +
+           ((sUART.ui32LCRH & UART_LCRH_PEN) ? 1 : 0) +
+           ((sUART.ui32LCRH & UART_LCRH_STP2) ? 2 : 1);
+}
+
+// System clock cycles per bit at the programmed divisor
+static uint64_t BitCycles64(const SimUART &sUART){
+    uint64_t ui64Div64 = sUART.ui32IBRD * 64 + sUART.ui32FBRD;
+    uint64_t ui64Clock = ((sUART.ui32CC & 0xF) == UART_CC_CS_PIOSC) ?
+                         SIM_PIOSC_HZ : g_ui32ClockHz;
+    if(ui64Div64 == 0){
+        ui64Div64 = 64;
+    }
+    // cycles * 64 to keep the fractional divisor
+    return ((sUART.ui32CTL & UART_CTL_HSE) ? 8 : 16) * ui64Div64 *
+           g_ui32ClockHz / ui64Clock;
+}
+
+static uint64_t FrameCycles(const SimUART &sUART){
+    return (BitCycles64(sUART) * FrameBits(sUART)) / 64;
+}
+
+static uint32_t FifoDepth(const SimUART &sUART){
+    return (sUART.ui32LCRH & UART_LCRH_FEN) ? SIM_FIFO_DEPTH : 1;
+}
+
+static uint32_t RxLevel(const SimUART &sUART){
+    return (sUART.ui32LCRH & UART_LCRH_FEN) ?
+           g_pui32Level[(sUART.ui32IFLS & UART_IFLS_RX_M) >> 3] : 1;
+}
+
+static uint32_t TxLevel(const SimUART &sUART){
+    return (sUART.ui32LCRH & UART_LCRH_FEN) ?
+           g_pui32Level[sUART.ui32IFLS & UART_IFLS_TX_M] : 0;
+}
+
+static bool Enabled(const SimUART &sUART, uint32_t ui32Dir){
+    return (sUART.ui32CTL & UART_CTL_UARTEN) && (sUART.ui32CTL & ui32Dir);
+}
+
+// RTS output: with RTSEN the hardware drops it once the RX FIFO reaches
+// its trigger level, otherwise it follows the RTS bit in CTL
+static bool RtsOut(const SimUART &sUART){
+    if(sUART.ui32CTL & UART_CTL_RTSEN){
+        return sUART.sRx.ui32Count < RxLevel(sUART);
+    }
+    return (sUART.ui32CTL & UART_CTL_RTS) != 0;
+}
+
+// CTS input, null modem wired to the peer's RTS
+static bool CtsIn(const SimUART &sUART){
+    return (sUART.i32Peer >= 0) ? g_psUART[sUART.i32Peer].bRts :
+                                  sUART.bHostCts;
+}
+
+static void TxStart(SimUART &sUART);
+static uint64_t HostFrame(const SimUART &sUART);
+
+// The host looks at RTS and at the last XON/XOFF before starting a frame
+static bool HostHeld(const SimUART &sUART){
+    return (sUART.bHostFlow && !sUART.bRts) || sUART.bHostXoff;
+}
+
+static void HostResume(SimUART &sUART){
+    if(sUART.bInHeld && !HostHeld(sUART)){
+        sUART.bInHeld = false;
+        sUART.ui64InNext = g_ui64Now + HostFrame(sUART);
+    }
+}
+
+// A change on a port's CTS input raises the CTS modem interrupt and may
+// let a held transmitter go again
+static void CtsChanged(SimUART &sUART){
+    sUART.ui32RIS |= UART_INT_CTS;
+    TxStart(sUART);
+}
+
+// Propagate a port's RTS output to whoever is listening: the peer's CTS
+// or the host, which starts any data it was holding back
+static void RtsUpdate(SimUART &sUART){
+    bool bRts = RtsOut(sUART);
+    if(bRts == sUART.bRts){
+        return;
+    }
+    sUART.bRts = bRts;
+    if(sUART.i32Peer >= 0){
+        CtsChanged(g_psUART[sUART.i32Peer]);
+    }else{
+        HostResume(sUART);
+    }
+}
+
+static void RxReceive(SimUART &sUART, uint16_t ui16Data, uint64_t ui64Frame){
+    uint64_t ui64Own = FrameCycles(sUART);
+    bool bAddr = (ui16Data & SIM_ADDR_CHAR) != 0;
+    ui16Data &= ~SIM_ADDR_CHAR;
+    if(!Enabled(sUART, UART_CTL_RXE)){
+        return;
+    }
+    // 9-bit mode: a matching address character is received and raises
+    // 9BITRIS, the data after it too; anything else never reaches the FIFO
+    if(sUART.ui329BitAddr & UART_9BITADDR_9BITEN){
+        if(bAddr){
+            sUART.b9BitMatch = (((ui16Data ^ sUART.ui329BitAddr) &
+                                 sUART.ui329BitMask & 0xFF) == 0);
+        }
+        if(!sUART.b9BitMatch){
+            sUART.sStats.ui32Filtered++;
+            return;
+        }
+        if(bAddr){
+            sUART.ui32RIS |= UART_INT_9BIT;
+        }
+    }
+    // A frame more than 5% off our own bit time samples as garbage
+    if((ui64Frame * 20 < ui64Own * 19) || (ui64Frame * 20 > ui64Own * 21)){
+        ui16Data |= UART_DR_FE;
+        sUART.ui32RIS |= UART_INT_FE;
+        sUART.sStats.ui32FramingErrors++;
+    }
+    if(sUART.sRx.ui32Count >= FifoDepth(sUART)){
+        sUART.ui32RSR |= UART_RSR_OE;
+        sUART.ui32RIS |= UART_INT_OE;
+        sUART.sStats.ui32Overruns++;
+        return;
+    }
+    FifoPush(sUART.sRx, ui16Data);
+    sUART.sStats.ui32RxBytes++;
+    sUART.sStats.ui64LastRx = g_ui64Now;
+    sUART.ui64LastRx = g_ui64Now;
+    sUART.bTimeoutDone = false;
+    if(sUART.sRx.ui32Count >= RxLevel(sUART)){
+        sUART.ui32RIS |= UART_INT_RX;
+    }
+}
+
+static void TxStart(SimUART &sUART){
+    if(sUART.bShifting || (sUART.sTx.ui32Count == 0) ||
+       !Enabled(sUART, UART_CTL_TXE)){
+        return;
+    }
+    if((sUART.ui32CTL & UART_CTL_CTSEN) && !CtsIn(sUART)){
+        return;                         // held off by the receiver
+    }
+    uint32_t ui32Before = sUART.sTx.ui32Count;
+    sUART.ui16Shift = FifoPop(sUART.sTx);
+    // Stick parity with EPS clear sends a 1 ninth bit: an address
+    if((sUART.ui32LCRH & (UART_LCRH_PEN | UART_LCRH_SPS | UART_LCRH_EPS)) ==
+       (UART_LCRH_PEN | UART_LCRH_SPS)){
+        sUART.ui16Shift |= SIM_ADDR_CHAR;
+    }
+    sUART.bShifting = true;
+    sUART.ui64ShiftFrame = FrameCycles(sUART);
+    sUART.ui64ShiftDone = g_ui64Now + sUART.ui64ShiftFrame;
+    if(!(sUART.ui32CTL & UART_CTL_EOT) && (ui32Before > TxLevel(sUART)) &&
+       (sUART.sTx.ui32Count <= TxLevel(sUART))){
+        sUART.ui32RIS |= UART_INT_TX;
+    }
+}
+
+static void TxDone(SimUART &sUART){
+    uint8_t ui8Data = (uint8_t)sUART.ui16Shift;
+    sUART.bShifting = false;
+    sUART.sStats.ui32TxBytes++;
+    sUART.sStats.ui64LastTx = g_ui64Now;
+    if(sUART.ui32CTL & UART_CTL_LBE){
+        RxReceive(sUART, sUART.ui16Shift, sUART.ui64ShiftFrame);
+        RtsUpdate(sUART);
+    }else if(sUART.bBus){
+        for(uint32_t i = 0; i < SIM_UARTS; i++){
+            if(g_psUART[i].bBus && (&g_psUART[i] != &sUART)){
+                RxReceive(g_psUART[i], sUART.ui16Shift, sUART.ui64ShiftFrame);
+            }
+        }
+    }else if(sUART.i32Peer >= 0){
+        uint64_t ui64Frame = sUART.ui64ShiftFrame;
+        uint16_t ui16Data = sUART.ui16Shift;
+        // Too fast for the cable: every fourth frame arrives mangled
+        if(sUART.ui32LineLimit &&
+           ((uint64_t)sUART.ui32LineLimit * BitCycles64(sUART) <
+            (uint64_t)g_ui32ClockHz * 64) &&
+           ((++sUART.ui32LineFrames & 3) == 0)){
+            ui16Data ^= 0x10;
+            ui64Frame *= 2;             // samples as a framing error
+        }
+        RxReceive(g_psUART[sUART.i32Peer], ui16Data, ui64Frame);
+        RtsUpdate(g_psUART[sUART.i32Peer]);
+    }else if(sUART.bHostXonXoff &&
+             ((ui8Data == SIM_XON) || (ui8Data == SIM_XOFF))){
+        sUART.bHostXoff = (ui8Data == SIM_XOFF);
+        HostResume(sUART);
+    }else{
+        LinePush(sUART.sOut, ui8Data);
+    }
+    TxStart(sUART);
+    if((sUART.ui32CTL & UART_CTL_EOT) && !sUART.bShifting){
+        sUART.ui32RIS |= UART_INT_TX;   // last stop bit is out
+    }
+}
+
+static uint64_t HostFrame(const SimUART &sUART){
+    if(sUART.ui32HostBaud == 0){
+        return FrameCycles(sUART);
+    }
+    return ((uint64_t)FrameBits(sUART) * g_ui32ClockHz) / sUART.ui32HostBaud;
+}
+
+static uint64_t TimeoutAt(const SimUART &sUART){
+    if((sUART.sRx.ui32Count == 0) || sUART.bTimeoutDone ||
+       !Enabled(sUART, UART_CTL_RXE)){
+        return SIM_NEVER;
+    }
+    return sUART.ui64LastRx + (BitCycles64(sUART) * SIM_RT_BITS) / 64;
+}
+
+static uint32_t UARTRead(SimUART &sUART, uint32_t ui32Offset){
+    switch(ui32Offset){
+        case UART_O_DR: {
+            if(sUART.sRx.ui32Count == 0){
+                return 0;
+            }
+            uint16_t ui16Data = FifoPop(sUART.sRx);
+            sUART.ui32RSR = (sUART.ui32RSR & UART_RSR_OE) |
+                            ((ui16Data >> 8) & 0x7);
+            if(sUART.sRx.ui32Count < RxLevel(sUART)){
+                sUART.ui32RIS &= ~UART_INT_RX;
+            }
+            if(sUART.sRx.ui32Count == 0){
+                sUART.ui32RIS &= ~UART_INT_RT;
+            }
+            RtsUpdate(sUART);
+            return ui16Data;
+        }
+        case UART_O_RSR:
+            return sUART.ui32RSR;
+        case UART_O_FR: {
+            uint32_t ui32FR = 0;
+            if(sUART.bShifting || sUART.sTx.ui32Count) ui32FR |= UART_FR_BUSY;
+            if(sUART.sRx.ui32Count == 0) ui32FR |= UART_FR_RXFE;
+            if(CtsIn(sUART)) ui32FR |= UART_FR_CTS;
+            if(sUART.sTx.ui32Count >= FifoDepth(sUART)) ui32FR |= UART_FR_TXFF;
+            if(sUART.sRx.ui32Count >= FifoDepth(sUART)) ui32FR |= UART_FR_RXFF;
+            if(sUART.sTx.ui32Count == 0) ui32FR |= UART_FR_TXFE;
+            return ui32FR;
+        }
+        case UART_O_IBRD: return sUART.ui32IBRD;
+        case UART_O_FBRD: return sUART.ui32FBRD;
+        case UART_O_LCRH: return sUART.ui32LCRH;
+        case UART_O_CTL:  return sUART.ui32CTL;
+        case UART_O_IFLS: return sUART.ui32IFLS;
+        case UART_O_IM:   return sUART.ui32IM;
+        case UART_O_RIS:  return sUART.ui32RIS;
+        case UART_O_MIS:  return sUART.ui32RIS & sUART.ui32IM;
+        case UART_O_CC:   return sUART.ui32CC;
+        case UART_O_DMACTL: return sUART.ui32DMACTL;
+        case UART_O_9BITADDR: return sUART.ui329BitAddr;
+        case UART_O_9BITAMASK: return sUART.ui329BitMask;
+    }
+    return *SimRegAddr(sUART.ui32Base + ui32Offset);
+}
+
+static void UARTWrite(SimUART &sUART, uint32_t ui32Offset, uint32_t ui32Value){
+    switch(ui32Offset){
+        case UART_O_DR:
+            if(sUART.sTx.ui32Count < FifoDepth(sUART)){
+                FifoPush(sUART.sTx, (uint16_t)(ui32Value & 0xFF));
+            }
+            if((sUART.ui32CTL & UART_CTL_EOT) ||
+               (sUART.sTx.ui32Count > TxLevel(sUART))){
+                sUART.ui32RIS &= ~UART_INT_TX;
+            }
+            TxStart(sUART);
+            return;
+        case UART_O_ECR:
+            sUART.ui32RSR = 0;
+            return;
+        case UART_O_IBRD: sUART.ui32IBRD = ui32Value & 0xFFFF; return;
+        case UART_O_FBRD: sUART.ui32FBRD = ui32Value & 0x3F; return;
+        case UART_O_LCRH: sUART.ui32LCRH = ui32Value & 0xFF; return;
+        case UART_O_CTL:
+            sUART.ui32CTL = ui32Value;
+            RtsUpdate(sUART);
+            TxStart(sUART);
+            return;
+        case UART_O_IFLS: sUART.ui32IFLS = ui32Value & 0x3F; return;
+        case UART_O_IM:   sUART.ui32IM = ui32Value & 0x17F2; return;
+        case UART_O_ICR:  sUART.ui32RIS &= ~ui32Value; return;
+        case UART_O_CC:   sUART.ui32CC = ui32Value & 0xF; return;
+        case UART_O_DMACTL: sUART.ui32DMACTL = ui32Value & 0x7; return;
+        case UART_O_9BITADDR:
+            sUART.ui329BitAddr = ui32Value &
+                                 (UART_9BITADDR_9BITEN | UART_9BITADDR_ADDR_M);
+            return;
+        case UART_O_9BITAMASK:
+            sUART.ui329BitMask = ui32Value & UART_9BITAMASK_MASK_M;
+            return;
+    }
+    *SimRegAddr(sUART.ui32Base + ui32Offset) = ui32Value;
+}
+
+static SimUART *UARTAt(uint32_t ui32Addr){
+    uint32_t ui32Base = ui32Addr & ~0xFFFu;
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        if(g_pui32UARTBase[i] == ui32Base){
+            return &g_psUART[i];
+        }
+    }
+    return 0;
+}
+
+//*****************************************************************************
+//
+// uDMA model. Channels are served lowest number first whenever their
+// peripheral requests, and each arbitration moves its items at once:
+// transfers take no simulated time. Control structures live in host
+// memory at the bus addresses SimBusAddr() handed out.
+//
+//*****************************************************************************
+static const SimDMAMap *DMAMapFor(uint32_t ui32Channel){
+    uint32_t ui32Enc = (g_pui32DMAChMap[ui32Channel / 8] >>
+                        ((ui32Channel % 8) * 4)) & 0xF;
+    for(uint32_t i = 0; i < SIM_DMA_MAPS; i++){
+        if((g_psDMAMap[i].ui8Channel == ui32Channel) &&
+           (g_psDMAMap[i].ui8Encoding == ui32Enc)){
+            return &g_psDMAMap[i];
+        }
+    }
+    return 0;
+}
+
+// Request a UART is raising on a channel: 0 none, 1 single, 2 burst.
+// RX asks for a burst at the FIFO trigger level, TX once the FIFO has
+// drained to it.
+static uint32_t DMARequest(uint32_t ui32Channel){
+    const SimDMAMap *psMap = DMAMapFor(ui32Channel);
+    if(psMap == 0){
+        return 0;
+    }
+    const SimUART &sUART = g_psUART[psMap->ui8Port];
+    if(!psMap->bTx){
+        if(!(sUART.ui32DMACTL & UART_DMACTL_RXDMAE) ||
+           (sUART.sRx.ui32Count == 0)){
+            return 0;
+        }
+        return (sUART.sRx.ui32Count >= RxLevel(sUART)) ? 2 : 1;
+    }
+    if(!(sUART.ui32DMACTL & UART_DMACTL_TXDMAE) ||
+       (sUART.sTx.ui32Count >= FifoDepth(sUART))){
+        return 0;
+    }
+    return (sUART.sTx.ui32Count <= TxLevel(sUART)) ? 2 : 1;
+}
+
+// Bus accesses made by the controller; peripheral space goes straight to
+// the UART models without charging CPU time
+static uint32_t DMARead(uint32_t ui32Addr, uint32_t ui32Size){
+    if(ui32Addr >= 0x40000000){
+        SimUART *psUART = UARTAt(ui32Addr);
+        return psUART ? UARTRead(*psUART, ui32Addr & 0xFFF) :
+                        *SimRegAddr(ui32Addr & ~3u);
+    }
+    const void *pvHost = SimHostPtr(ui32Addr);
+    return (ui32Size == 4) ? *(const uint32_t *)pvHost :
+           (ui32Size == 2) ? *(const uint16_t *)pvHost :
+                             *(const uint8_t *)pvHost;
+}
+
+static void DMAWrite(uint32_t ui32Addr, uint32_t ui32Size, uint32_t ui32Value){
+    if(ui32Addr >= 0x40000000){
+        SimUART *psUART = UARTAt(ui32Addr);
+        if(psUART){
+            UARTWrite(*psUART, ui32Addr & 0xFFF, ui32Value);
+        }else{
+            *SimRegAddr(ui32Addr & ~3u) = ui32Value;
+        }
+        return;
+    }
+    void *pvHost = SimHostPtr(ui32Addr);
+    if(ui32Size == 4){
+        *(uint32_t *)pvHost = ui32Value;
+    }else if(ui32Size == 2){
+        *(uint16_t *)pvHost = (uint16_t)ui32Value;
+    }else{
+        *(uint8_t *)pvHost = (uint8_t)ui32Value;
+    }
+}
+
+static uDMAControl *DMAControl(uint32_t ui32Channel, bool bAlt){
+    return (uDMAControl *)SimHostPtr(g_ui32DMACtlBase +
+                                     (bAlt ? 0x200 : 0) + ui32Channel * 16);
+}
+
+// Address step for an increment field: 8-bit, 16-bit, 32-bit or none
+static uint32_t DMAStep(uint32_t ui32Inc){
+    static const uint32_t pui32Step[4] = {1, 2, 4, 0};
+    return pui32Step[ui32Inc & 3];
+}
+
+// A control structure ran to completion
+static void DMADone(uint32_t ui32Channel, uint32_t ui32Mode, bool bAlt){
+    uint32_t ui32Bit = 1u << ui32Channel;
+    switch(ui32Mode){
+        case UDMA_MODE_PINGPONG:
+            // Carry on in the other structure unless it was never re-armed
+            g_ui32DMAChis |= ui32Bit;
+            g_ui32DMAAlt ^= ui32Bit;
+            if(uDMA_Mode(DMAControl(ui32Channel, !bAlt)) == UDMA_MODE_STOP){
+                g_ui32DMAEna &= ~ui32Bit;
+            }
+            return;
+        case UDMA_MODE_MEM_SG_ALT:
+        case UDMA_MODE_PER_SG_ALT:
+            g_ui32DMAAlt &= ~ui32Bit;   // back to the task list
+            if(uDMA_Mode(DMAControl(ui32Channel, false)) != UDMA_MODE_STOP){
+                return;
+            }
+            break;
+    }
+    g_ui32DMAEna &= ~ui32Bit;
+    g_ui32DMAChis |= ui32Bit;
+}
+
+// One arbitration on a channel. In scatter-gather mode the primary
+// structure copies the next four-word task into the alternate structure
+// and hands over to it.
+static void DMAArbitrate(uint32_t ui32Channel, bool bBurst){
+    uint32_t ui32Bit = 1u << ui32Channel;
+    bool bAlt = (g_ui32DMAAlt & ui32Bit) != 0;
+    uDMAControl *psCtl = DMAControl(ui32Channel, bAlt);
+    uint32_t ui32Control = psCtl->control;
+    uint32_t ui32Mode = ui32Control & UDMA_CTL_MODE_M;
+    bool bTaskCopy = !bAlt && ((ui32Mode == UDMA_MODE_MEM_SG) ||
+                               (ui32Mode == UDMA_MODE_PER_SG));
+
+    if(ui32Mode == UDMA_MODE_STOP){
+        g_ui32DMAEna &= ~ui32Bit;
+        return;
+    }
+    uint32_t ui32Left = uDMA_Remaining(psCtl);
+    uint32_t ui32Items = (bBurst || bTaskCopy) ?
+                         1u << ((ui32Control >> 14) & 0xF) : 1;
+    uint32_t ui32SrcStep = DMAStep(ui32Control >> 26);
+    uint32_t ui32DstStep = DMAStep(ui32Control >> 30);
+    uint32_t ui32SrcSize = 1u << ((ui32Control >> 24) & 3);
+    uint32_t ui32DstSize = 1u << ((ui32Control >> 28) & 3);
+    if(ui32Items > ui32Left){
+        ui32Items = ui32Left;
+    }
+    for(uint32_t i = 0; i < ui32Items; i++){
+        uint32_t ui32Value = DMARead(psCtl->srcEnd - (ui32Left - 1) *
+                                     ui32SrcStep, ui32SrcSize);
+        DMAWrite(psCtl->dstEnd - (ui32Left - 1) * ui32DstStep, ui32DstSize,
+                 ui32Value);
+        ui32Left--;
+    }
+    if(ui32Left != 0){
+        psCtl->control = (ui32Control & ~UDMA_CTL_XFERSIZE_M) |
+                         ((ui32Left - 1) << UDMA_CTL_XFERSIZE_S);
+    }else{
+        psCtl->control = ui32Control & ~(UDMA_CTL_XFERSIZE_M |
+                                         UDMA_CTL_MODE_M);
+    }
+    if(bTaskCopy){
+        g_ui32DMAAlt |= ui32Bit;
+    }else if(ui32Left == 0){
+        DMADone(ui32Channel, ui32Mode, bAlt);
+    }
+}
+
+// Serve requests until every enabled channel is idle or blocked
+static void DMAService(void){
+    if(!(g_ui32DMACfg & UDMA_CFG_MASTEN)){
+        return;
+    }
+    for(uint32_t n = 0; (n < SIM_DMA_PASS_LIMIT) && g_ui32DMAEna; n++){
+        uint32_t ui32Ready = 0;
+        for(uint32_t ui32Channel = 0; ui32Channel < UDMA_NUM_CHANNELS;
+            ui32Channel++){
+            uint32_t ui32Bit = 1u << ui32Channel;
+            if(!(g_ui32DMAEna & ui32Bit) || (g_ui32DMAMask & ui32Bit)){
+                continue;
+            }
+            uint32_t ui32Req = DMARequest(ui32Channel);
+            if((ui32Req == 0) ||
+               ((ui32Req == 1) && (g_ui32DMABurst & ui32Bit))){
+                continue;
+            }
+            DMAArbitrate(ui32Channel, ui32Req == 2);
+            ui32Ready++;
+            break;                      // re-arbitrate from channel 0
+        }
+        if(ui32Ready == 0){
+            return;
+        }
+    }
+}
+
+// Completed channels signal on their peripheral's interrupt line
+static bool DMALine(uint32_t ui32Port){
+    if(g_ui32DMAChis == 0){
+        return false;
+    }
+    for(uint32_t i = 0; i < SIM_DMA_MAPS; i++){
+        const SimDMAMap &sMap = g_psDMAMap[i];
+        if((sMap.ui8Port == ui32Port) &&
+           (g_ui32DMAChis & (1u << sMap.ui8Channel)) &&
+           (DMAMapFor(sMap.ui8Channel) == &sMap)){
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool UARTLine(uint32_t ui32Port){
+    return (g_psUART[ui32Port].ui32RIS & g_psUART[ui32Port].ui32IM) ||
+           DMALine(ui32Port);
+}
+
+//*****************************************************************************
+//
+// Interrupt latency bookkeeping. A vector's clock starts when its line
+// asserts (or is pended), or when its previous handler returns with the
+// line still asserted.
+//
+//*****************************************************************************
+static void StampVector(uint32_t ui32Vector){
+    if(g_pui64Asserted[ui32Vector] == SIM_NEVER){
+        g_pui64Asserted[ui32Vector] = g_ui64Now;
+    }
+}
+
+static void StampLines(void){
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        if(UARTLine(i)){
+            StampVector(g_psUART[i].ui32Vector);
+        }else{
+            g_pui64Asserted[g_psUART[i].ui32Vector] = SIM_NEVER;
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// SysTick model. The counter holds g_ui32StLoadVal at g_ui64StLoadAt and
+// counts down one per StRate() cycles; reaching zero sets COUNTFLAG and
+// pends the exception, and the next count reloads from RELOAD.
+//
+//*****************************************************************************
+static uint64_t StRate(void){
+    uint64_t ui64Hz = g_bDeepSleep ? SIM_PIOSC_HZ : g_ui32ClockHz;
+    if(!(g_ui32StCtrl & NVIC_ST_CTRL_CLK_SRC)){
+        return g_ui32ClockHz / (SIM_PIOSC_HZ / 4);      // PIOSC / 4
+    }
+    return g_ui32ClockHz / ui64Hz;
+}
+
+static uint32_t StCurrent(void){
+    if(!g_bStRunning){
+        return g_ui32StLoadVal;
+    }
+    uint64_t ui64Counts = (g_ui64Now - g_ui64StLoadAt) / StRate();
+    return (ui64Counts >= g_ui32StLoadVal) ? 0 :
+           g_ui32StLoadVal - (uint32_t)ui64Counts;
+}
+
+static uint64_t StZeroAt(void){
+    if(!g_bStRunning || g_bStZeroDone){
+        return SIM_NEVER;
+    }
+    return g_ui64StLoadAt + (uint64_t)g_ui32StLoadVal * StRate();
+}
+
+static uint64_t StReloadAt(void){
+    if(!g_bStRunning){
+        return SIM_NEVER;
+    }
+    return g_ui64StLoadAt + ((uint64_t)g_ui32StLoadVal + 1) * StRate();
+}
+
+// Re-base the counter at the current time, e.g. before the rate changes
+static void StRebase(void){
+    if(g_bStRunning){
+        g_ui32StLoadVal = StCurrent();
+        g_ui64StLoadAt = g_ui64Now;
+        g_bStZeroDone = (g_ui32StLoadVal == 0);
+    }
+}
+
+static void StLoad(uint32_t ui32Value){
+    g_ui32StLoadVal = ui32Value;
+    g_ui64StLoadAt = g_ui64Now;
+    g_bStZeroDone = (ui32Value == 0);
+}
+
+//*****************************************************************************
+//
+// Time
+//
+//*****************************************************************************
+static uint64_t NextEvent(void){
+    uint64_t ui64Next = SIM_NEVER;
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        SimUART &sUART = g_psUART[i];
+        if(sUART.bShifting && (sUART.ui64ShiftDone < ui64Next)){
+            ui64Next = sUART.ui64ShiftDone;
+        }
+        if(sUART.ui64InNext < ui64Next){
+            ui64Next = sUART.ui64InNext;
+        }
+        uint64_t ui64Timeout = TimeoutAt(sUART);
+        if(ui64Timeout < ui64Next){
+            ui64Next = ui64Timeout;
+        }
+    }
+    if(StZeroAt() < ui64Next){
+        ui64Next = StZeroAt();
+    }
+    if((g_ui32StReload != 0) && (StReloadAt() < ui64Next)){
+        ui64Next = StReloadAt();
+    }
+    return ui64Next;
+}
+
+static void ProcessEvents(void){
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        SimUART &sUART = g_psUART[i];
+        if(sUART.bShifting && (sUART.ui64ShiftDone <= g_ui64Now)){
+            TxDone(sUART);
+        }
+        if(sUART.ui64InNext <= g_ui64Now){
+            uint64_t ui64Frame = HostFrame(sUART);
+            RxReceive(sUART, LinePop(sUART.sIn), ui64Frame);
+            RtsUpdate(sUART);
+            sUART.ui64InNext = SIM_NEVER;
+            if(sUART.sIn.ui32Count){
+                if(HostHeld(sUART)){
+                    sUART.bInHeld = true;
+                }else{
+                    sUART.ui64InNext = g_ui64Now + ui64Frame;
+                }
+            }
+        }
+        if(TimeoutAt(sUART) <= g_ui64Now){
+            sUART.ui32RIS |= UART_INT_RT;
+            sUART.bTimeoutDone = true;
+        }
+    }
+    if(StZeroAt() <= g_ui64Now){
+        g_bStZeroDone = true;
+        g_bStCount = true;
+        if(g_ui32StCtrl & NVIC_ST_CTRL_INTEN){
+            g_bStPending = true;
+            StampVector(FAULT_SYSTICK);
+        }
+    }
+    if((g_ui32StReload != 0) && (StReloadAt() <= g_ui64Now)){
+        StLoad(g_ui32StReload);
+    }
+}
+
+static void RunUntil(uint64_t ui64Until){
+    for(;;){
+        uint64_t ui64Next = NextEvent();
+        if(ui64Next > ui64Until){
+            break;
+        }
+        if(ui64Next > g_ui64Now){
+            g_ui64Now = ui64Next;
+        }
+        ProcessEvents();
+        DMAService();
+        StampLines();
+    }
+    if(ui64Until > g_ui64Now){
+        g_ui64Now = ui64Until;
+    }
+}
+
+//*****************************************************************************
+//
+// NVIC
+//
+//*****************************************************************************
+static bool IrqMasked(uint32_t ui32Vector){
+    if(g_ui32Basepri == 0){
+        return false;
+    }
+    uint32_t ui32Pri = HWREGB(NVIC_PRI0 + ui32Vector - 16) & 0xE0;
+    return ui32Pri >= (g_ui32Basepri & 0xE0);
+}
+
+// Highest priority vector that wants service, 0 if none. Peripheral
+// lines are level sensitive: a UART asserts its line while RIS & IM.
+static uint32_t PendingVector(void){
+    uint32_t pui32Want[SIM_IRQ_WORDS];
+
+    if(g_bStPending){
+        return FAULT_SYSTICK;
+    }
+    memcpy(pui32Want, g_pui32Pend, sizeof(pui32Want));
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        if(UARTLine(i)){
+            uint32_t ui32Irq = g_psUART[i].ui32Vector - 16;
+            pui32Want[ui32Irq / 32] |= 1u << (ui32Irq % 32);
+        }
+    }
+    for(uint32_t w = 0; w < SIM_IRQ_WORDS; w++){
+        uint32_t ui32Bits = pui32Want[w] & g_pui32En[w];
+        while(ui32Bits){
+            uint32_t ui32Vector = 16 + w * 32 + __builtin_ctz(ui32Bits);
+            if((ui32Vector < SIM_VECTORS) && !IrqMasked(ui32Vector)){
+                return ui32Vector;
+            }
+            ui32Bits &= ui32Bits - 1;
+        }
+    }
+    return 0;
+}
+
+static void Dispatch(void){
+    if(g_bInHandler || g_bPrimask){
+        return;
+    }
+    for(uint32_t n = 0; n < SIM_DISPATCH_LIMIT; n++){
+        uint32_t ui32Vector = PendingVector();
+        if(ui32Vector == 0){
+            return;
+        }
+        uint32_t ui32Irq = ui32Vector - 16;
+        if(ui32Vector == FAULT_SYSTICK){
+            g_bStPending = false;
+        }else{
+            g_pui32Pend[ui32Irq / 32] &= ~(1u << (ui32Irq % 32));
+            g_pui32Active[ui32Irq / 32] |= 1u << (ui32Irq % 32);
+        }
+        g_bInHandler = true;
+        RunUntil(g_ui64Now + SIM_IRQ_ENTRY_CYCLES);
+        uint64_t ui64Entered = g_ui64Now;
+        SimIrqStats &sStats = g_psIrqStats[ui32Vector];
+        if(g_pui64Asserted[ui32Vector] != SIM_NEVER){
+            uint64_t ui64Latency = ui64Entered - g_pui64Asserted[ui32Vector];
+            sStats.ui32Count++;
+            sStats.ui64TotalLatency += ui64Latency;
+            if(ui64Latency > sStats.ui32MaxLatency){
+                sStats.ui32MaxLatency = (uint32_t)ui64Latency;
+            }
+        }
+        if(g_pfnRAMVectors[ui32Vector]){
+            g_pfnRAMVectors[ui32Vector]();
+        }else if(ui32Vector != FAULT_SYSTICK){
+            g_pui32En[ui32Irq / 32] &= ~(1u << (ui32Irq % 32));  // no handler
+        }
+        RunUntil(g_ui64Now + SIM_IRQ_EXIT_CYCLES);
+        sStats.ui64HandlerCycles += g_ui64Now - ui64Entered;
+        g_bInHandler = false;
+        if(ui32Vector != FAULT_SYSTICK){
+            g_pui32Active[ui32Irq / 32] &= ~(1u << (ui32Irq % 32));
+        }
+        g_pui64Asserted[ui32Vector] = SIM_NEVER;
+        if(g_bStPending){
+            StampVector(FAULT_SYSTICK);
+        }
+        StampLines();
+    }
+}
+
+//*****************************************************************************
+//
+// Register access entry points used by the HWREG() proxy
+//
+//*****************************************************************************
+static uint32_t Read(uint32_t ui32Addr){
+    SimUART *psUART = UARTAt(ui32Addr);
+    if(psUART){
+        return UARTRead(*psUART, ui32Addr & 0xFFF);
+    }
+    if((ui32Addr >= NVIC_EN0) && (ui32Addr < NVIC_EN0 + 4 * SIM_IRQ_WORDS)){
+        return g_pui32En[(ui32Addr - NVIC_EN0) / 4];
+    }
+    if((ui32Addr >= NVIC_DIS0) && (ui32Addr < NVIC_DIS0 + 4 * SIM_IRQ_WORDS)){
+        return g_pui32En[(ui32Addr - NVIC_DIS0) / 4];
+    }
+    if((ui32Addr >= NVIC_PEND0) && (ui32Addr < NVIC_PEND0 + 4 * SIM_IRQ_WORDS)){
+        return g_pui32Pend[(ui32Addr - NVIC_PEND0) / 4];
+    }
+    if((ui32Addr >= NVIC_UNPEND0) &&
+       (ui32Addr < NVIC_UNPEND0 + 4 * SIM_IRQ_WORDS)){
+        return g_pui32Pend[(ui32Addr - NVIC_UNPEND0) / 4];
+    }
+    if((ui32Addr >= NVIC_ACTIVE0) &&
+       (ui32Addr < NVIC_ACTIVE0 + 4 * SIM_IRQ_WORDS)){
+        return g_pui32Active[(ui32Addr - NVIC_ACTIVE0) / 4];
+    }
+    switch(ui32Addr){
+        case NVIC_ST_CTRL: {
+            uint32_t ui32Value = g_ui32StCtrl |
+                                 (g_bStCount ? NVIC_ST_CTRL_COUNT : 0);
+            g_bStCount = false;
+            return ui32Value;
+        }
+        case NVIC_ST_RELOAD:
+            return g_ui32StReload;
+        case NVIC_ST_CURRENT:
+            return StCurrent();
+        case NVIC_INT_CTRL:
+            return *SimRegAddr(ui32Addr) |
+                   (g_bStPending ? NVIC_INT_CTRL_PENDSTSET : 0);
+        case DWT_BASE + 0x4:            // CYCCNT
+            return (uint32_t)(g_ui64Now - g_ui64CycBase);
+        case SYSCTL_RIS:
+            return *SimRegAddr(ui32Addr) | SYSCTL_RIS_PLLLRIS;
+        case SYSCTL_PRUART:
+        case SYSCTL_PRGPIO:
+        case SYSCTL_PRDMA:
+            return 0xFFFFFFFF;          // every module ready immediately
+        case UDMA_BASE + UDMA_O_STAT:
+            return ((UDMA_NUM_CHANNELS - 1) << 16) |
+                   (g_ui32DMACfg & UDMA_CFG_MASTEN);
+        case UDMA_BASE + UDMA_O_CFG:     return g_ui32DMACfg;
+        case UDMA_BASE + UDMA_O_CTLBASE: return g_ui32DMACtlBase;
+        case UDMA_BASE + UDMA_O_ALTBASE: return g_ui32DMACtlBase + 0x200;
+        case UDMA_BASE + UDMA_O_USEBURSTSET: return g_ui32DMABurst;
+        case UDMA_BASE + UDMA_O_REQMASKSET:  return g_ui32DMAMask;
+        case UDMA_BASE + UDMA_O_ENASET:      return g_ui32DMAEna;
+        case UDMA_BASE + UDMA_O_ALTSET:      return g_ui32DMAAlt;
+        case UDMA_BASE + UDMA_O_PRIOSET:     return g_ui32DMAPrio;
+        case UDMA_BASE + UDMA_O_CHIS:        return g_ui32DMAChis;
+    }
+    if((ui32Addr >= UDMA_BASE + UDMA_O_CHMAP0) &&
+       (ui32Addr < UDMA_BASE + UDMA_O_CHMAP0 + 16)){
+        return g_pui32DMAChMap[(ui32Addr - UDMA_BASE - UDMA_O_CHMAP0) / 4];
+    }
+    return *SimRegAddr(ui32Addr);
+}
+
+static void Write(uint32_t ui32Addr, uint32_t ui32Value){
+    SimUART *psUART = UARTAt(ui32Addr);
+    if(psUART){
+        UARTWrite(*psUART, ui32Addr & 0xFFF, ui32Value);
+        return;
+    }
+    if((ui32Addr >= NVIC_EN0) && (ui32Addr < NVIC_EN0 + 4 * SIM_IRQ_WORDS)){
+        g_pui32En[(ui32Addr - NVIC_EN0) / 4] |= ui32Value;
+        return;
+    }
+    if((ui32Addr >= NVIC_DIS0) && (ui32Addr < NVIC_DIS0 + 4 * SIM_IRQ_WORDS)){
+        g_pui32En[(ui32Addr - NVIC_DIS0) / 4] &= ~ui32Value;
+        return;
+    }
+    if((ui32Addr >= NVIC_PEND0) && (ui32Addr < NVIC_PEND0 + 4 * SIM_IRQ_WORDS)){
+        g_pui32Pend[(ui32Addr - NVIC_PEND0) / 4] |= ui32Value;
+        for(uint32_t ui32Bits = ui32Value; ui32Bits; ui32Bits &= ui32Bits - 1){
+            uint32_t ui32Vector = 16 + (ui32Addr - NVIC_PEND0) * 8 +
+                                  __builtin_ctz(ui32Bits);
+            if(ui32Vector < SIM_VECTORS){
+                StampVector(ui32Vector);
+            }
+        }
+        return;
+    }
+    if((ui32Addr >= NVIC_UNPEND0) &&
+       (ui32Addr < NVIC_UNPEND0 + 4 * SIM_IRQ_WORDS)){
+        g_pui32Pend[(ui32Addr - NVIC_UNPEND0) / 4] &= ~ui32Value;
+        return;
+    }
+    if((ui32Addr >= UDMA_BASE + UDMA_O_CHMAP0) &&
+       (ui32Addr < UDMA_BASE + UDMA_O_CHMAP0 + 16)){
+        g_pui32DMAChMap[(ui32Addr - UDMA_BASE - UDMA_O_CHMAP0) / 4] = ui32Value;
+        return;
+    }
+    switch(ui32Addr){
+        case NVIC_ST_CTRL: {
+            bool bRun = (ui32Value & NVIC_ST_CTRL_ENABLE) != 0;
+            StRebase();
+            g_ui32StCtrl = ui32Value & (NVIC_ST_CTRL_CLK_SRC |
+                                        NVIC_ST_CTRL_INTEN |
+                                        NVIC_ST_CTRL_ENABLE);
+            if(bRun && !g_bStRunning){
+                g_bStRunning = true;
+                StLoad(g_ui32StLoadVal);
+            }
+            g_bStRunning = bRun;
+            return;
+        }
+        case NVIC_ST_RELOAD:
+            g_ui32StReload = ui32Value & NVIC_ST_RELOAD_M;
+            return;
+        case NVIC_ST_CURRENT:
+            StLoad(0);                  // clears; reloads on the next count
+            g_bStCount = false;
+            return;
+        case NVIC_INT_CTRL:
+            if(ui32Value & NVIC_INT_CTRL_PENDSTSET){
+                g_bStPending = true;
+                StampVector(FAULT_SYSTICK);
+            }
+            if(ui32Value & NVIC_INT_CTRL_PENDSTCLR) g_bStPending = false;
+            return;
+        case DWT_BASE + 0x4:            // CYCCNT
+            g_ui64CycBase = g_ui64Now - ui32Value;
+            return;
+        case UDMA_BASE + UDMA_O_CFG:     g_ui32DMACfg = ui32Value; return;
+        case UDMA_BASE + UDMA_O_CTLBASE: g_ui32DMACtlBase = ui32Value; return;
+        case UDMA_BASE + UDMA_O_USEBURSTSET: g_ui32DMABurst |= ui32Value; return;
+        case UDMA_BASE + UDMA_O_USEBURSTCLR: g_ui32DMABurst &= ~ui32Value; return;
+        case UDMA_BASE + UDMA_O_REQMASKSET:  g_ui32DMAMask |= ui32Value; return;
+        case UDMA_BASE + UDMA_O_REQMASKCLR:  g_ui32DMAMask &= ~ui32Value; return;
+        case UDMA_BASE + UDMA_O_ENASET:      g_ui32DMAEna |= ui32Value; return;
+        case UDMA_BASE + UDMA_O_ENACLR:      g_ui32DMAEna &= ~ui32Value; return;
+        case UDMA_BASE + UDMA_O_ALTSET:      g_ui32DMAAlt |= ui32Value; return;
+        case UDMA_BASE + UDMA_O_ALTCLR:      g_ui32DMAAlt &= ~ui32Value; return;
+        case UDMA_BASE + UDMA_O_PRIOSET:     g_ui32DMAPrio |= ui32Value; return;
+        case UDMA_BASE + UDMA_O_PRIOCLR:     g_ui32DMAPrio &= ~ui32Value; return;
+        case UDMA_BASE + UDMA_O_CHIS:        g_ui32DMAChis &= ~ui32Value; return;
+    }
+    *SimRegAddr(ui32Addr) = ui32Value;
+}
+
+uint32_t SimRegRead(uint32_t ui32Addr){
+    RunUntil(g_ui64Now + SIM_ACCESS_CYCLES);
+    Dispatch();
+    uint32_t ui32Value = Read(ui32Addr & ~3u);
+    DMAService();
+    StampLines();
+    return ui32Value;
+}
+
+void SimRegWrite(uint32_t ui32Addr, uint32_t ui32Value){
+    RunUntil(g_ui64Now + SIM_ACCESS_CYCLES);
+    Dispatch();
+    Write(ui32Addr & ~3u, ui32Value);
+    DMAService();
+    StampLines();
+}
+
+//*****************************************************************************
+//
+// Processor primitives normally provided by cpu.c
+//
+//*****************************************************************************
+uint32_t CPUcpsid(void){
+    uint32_t ui32Ret = g_bPrimask;
+    g_bPrimask = true;
+    return ui32Ret;
+}
+
+uint32_t CPUcpsie(void){
+    uint32_t ui32Ret = g_bPrimask;
+    g_bPrimask = false;
+    Dispatch();
+    return ui32Ret;
+}
+
+uint32_t CPUprimask(void){
+    return g_bPrimask;
+}
+
+void CPUwfi(void){
+    uint64_t ui64Start = g_ui64Now;
+    bool bDeep = (*SimRegAddr(NVIC_SYS_CTRL) & NVIC_SYS_CTRL_SLEEPDEEP) != 0;
+    if(bDeep){
+        StRebase();
+        g_bDeepSleep = true;
+    }
+    // Sleep until an enabled interrupt is pending, whatever PRIMASK says.
+    // With nothing scheduled nothing can ever wake us; return rather
+    // than hang the host.
+    while(PendingVector() == 0){
+        uint64_t ui64Next = NextEvent();
+        if(ui64Next == SIM_NEVER){
+            break;
+        }
+        RunUntil(ui64Next);
+    }
+    if(bDeep){
+        StRebase();
+        g_bDeepSleep = false;
+    }
+    g_ui64Sleep += g_ui64Now - ui64Start;
+    Dispatch();
+}
+
+uint32_t CPUbasepriGet(void){
+    return g_ui32Basepri;
+}
+
+void CPUbasepriSet(uint32_t ui32NewBasepri){
+    g_ui32Basepri = ui32NewBasepri & 0xFF;
+    Dispatch();
+}
+
+//*****************************************************************************
+//
+// Host API
+//
+//*****************************************************************************
+void SimInit(uint32_t ui32ClockHz){
+    SimRegReset();
+    g_ui32ClockHz = ui32ClockHz;
+    g_ui64Now = 0;
+    g_ui64Sleep = 0;
+    g_bDeepSleep = false;
+    for(uint32_t i = 0; i < SIM_UARTS; i++){
+        SimUART &sUART = g_psUART[i];
+        memset(&sUART, 0, sizeof(sUART));
+        sUART.ui32Base = g_pui32UARTBase[i];
+        sUART.ui32Vector = g_pui32UARTVector[i];
+        sUART.ui32CTL = UART_CTL_RXE | UART_CTL_TXE;    // reset value
+        sUART.ui32IFLS = 0x12;                          // 1/2, 1/2
+        sUART.ui329BitMask = 0xFF;
+        sUART.i32Peer = -1;
+        sUART.ui64InNext = SIM_NEVER;
+        sUART.bHostCts = true;
+    }
+    memset(g_pui32En, 0, sizeof(g_pui32En));
+    memset(g_pui32Pend, 0, sizeof(g_pui32Pend));
+    memset(g_pui32Active, 0, sizeof(g_pui32Active));
+    memset(g_pfnRAMVectors, 0, sizeof(void (*)(void)) * SIM_VECTORS);
+    g_bPrimask = false;
+    g_ui32Basepri = 0;
+    g_bInHandler = false;
+    g_ui32StCtrl = NVIC_ST_CTRL_CLK_SRC;
+    g_ui32StReload = 0;
+    g_bStRunning = false;
+    g_ui32StLoadVal = 0;
+    g_ui64StLoadAt = 0;
+    g_bStZeroDone = true;
+    g_bStCount = false;
+    g_bStPending = false;
+    g_ui64CycBase = 0;
+    g_ui32DMACfg = 0;
+    g_ui32DMACtlBase = 0;
+    g_ui32DMAEna = 0;
+    g_ui32DMAAlt = 0;
+    g_ui32DMABurst = 0;
+    g_ui32DMAMask = 0;
+    g_ui32DMAPrio = 0;
+    g_ui32DMAChis = 0;
+    memset(g_pui32DMAChMap, 0, sizeof(g_pui32DMAChMap));
+    for(uint32_t i = 0; i < SIM_VECTORS; i++){
+        g_pui64Asserted[i] = SIM_NEVER;
+    }
+    memset(g_psIrqStats, 0, sizeof(g_psIrqStats));
+}
+
+uint64_t SimNow(void){
+    return g_ui64Now;
+}
+
+void SimAdvance(uint32_t ui32Cycles){
+    RunUntil(g_ui64Now + ui32Cycles);
+    Dispatch();
+}
+
+uint64_t SimSleepCycles(void){
+    return g_ui64Sleep;
+}
+
+void SimUARTConnect(uint32_t ui32PortA, uint32_t ui32PortB){
+    g_psUART[ui32PortA].i32Peer = (int32_t)ui32PortB;
+    g_psUART[ui32PortB].i32Peer = (int32_t)ui32PortA;
+}
+
+void SimUARTBusJoin(uint32_t ui32Port){
+    g_psUART[ui32Port].bBus = true;
+}
+
+void SimUARTLineLimit(uint32_t ui32Port, uint32_t ui32Baud){
+    g_psUART[ui32Port].ui32LineLimit = ui32Baud;
+}
+
+uint32_t SimUARTHostWrite(uint32_t ui32Port, const uint8_t *pui8Data,
+                          uint32_t ui32Len){
+    SimUART &sUART = g_psUART[ui32Port];
+    uint32_t ui32Count = 0;
+    while((ui32Count < ui32Len) && LinePush(sUART.sIn, pui8Data[ui32Count])){
+        ui32Count++;
+    }
+    if((ui32Count != 0) && (sUART.ui64InNext == SIM_NEVER) &&
+       !sUART.bInHeld){
+        if(HostHeld(sUART)){
+            sUART.bInHeld = true;
+        }else{
+            sUART.ui64InNext = g_ui64Now + HostFrame(sUART);
+        }
+    }
+    return ui32Count;
+}
+
+uint32_t SimUARTHostRead(uint32_t ui32Port, uint8_t *pui8Data,
+                         uint32_t ui32Len){
+    SimUART &sUART = g_psUART[ui32Port];
+    uint32_t ui32Count = 0;
+    while((ui32Count < ui32Len) && sUART.sOut.ui32Count){
+        pui8Data[ui32Count++] = LinePop(sUART.sOut);
+    }
+    return ui32Count;
+}
+
+void SimUARTHostBaud(uint32_t ui32Port, uint32_t ui32Baud){
+    g_psUART[ui32Port].ui32HostBaud = ui32Baud;
+}
+
+void SimUARTHostFlow(uint32_t ui32Port, bool bEnable){
+    SimUART &sUART = g_psUART[ui32Port];
+    sUART.bHostFlow = bEnable;
+    HostResume(sUART);
+}
+
+void SimUARTHostXonXoff(uint32_t ui32Port, bool bEnable){
+    SimUART &sUART = g_psUART[ui32Port];
+    sUART.bHostXonXoff = bEnable;
+    sUART.bHostXoff = false;
+    HostResume(sUART);
+}
+
+void SimUARTHostCts(uint32_t ui32Port, bool bAssert){
+    SimUART &sUART = g_psUART[ui32Port];
+    if(sUART.bHostCts != bAssert){
+        sUART.bHostCts = bAssert;
+        if(sUART.i32Peer < 0){
+            CtsChanged(sUART);
+        }
+    }
+}
+
+const SimUARTStats *SimUARTGetStats(uint32_t ui32Port){
+    return &g_psUART[ui32Port].sStats;
+}
+
+const SimIrqStats *SimIrqGetStats(uint32_t ui32Vector){
+    return &g_psIrqStats[ui32Vector];
+}
+
+#endif // HOST_SIM
@@ -0,0 +1,167 @@
+/*
+ * sim_tm4c.h
+ *
+ *  Host-side register level simulator for the TM4C123 UARTs, micro-DMA
+ *  and NVIC.
+ *  With HOST_SIM defined, HWREG() and the tm4c123gh6pm.h register macros
+ *  reach the models in sim_tm4c.cpp instead of hardware, so the drivers
+ *  in this tree (uart.c, interrupt.c, UART0.cpp, BufferedUART, ...) run
+ *  unmodified on Linux.
+ *
+ *  Modelled: UART0-7 data/flag/baud/line control/FIFO level/interrupt
+ *  registers with 16 entry FIFOs, line-rate transmit and receive timing,
+ *  receive timeout, overrun, EOT mode and loopback, RTS/CTS handshaking
+ *  (manual RTS, RTSEN, CTSEN and the CTS modem interrupt, on every
+ *  port); uDMA basic, ping-pong
+ *  and scatter-gather transfers on the UART request lines, with completion
+ *  signalled on the UART's vector; NVIC enable/pending registers with
+ *  dispatch through interrupt.c's g_pfnRAMVectors; PRIMASK, BASEPRI and
+ *  WFI; SysTick; the DWT cycle counter. Handlers do not preempt each
+ *  other, and pending interrupts are taken lowest vector first. Other
+ *  registers are plain storage. DMA buffers must be static data, see
+ *  SimBusAddr() in sim_regs.h.
+ *
+ *  Time is counted in system clock cycles. Each HWREG() access costs
+ *  SIM_ACCESS_CYCLES; code that models work between accesses calls
+ *  SimAdvance(). Interrupts are taken at register access boundaries and
+ *  cost SIM_IRQ_ENTRY_CYCLES/SIM_IRQ_EXIT_CYCLES. Plain C code between
+ *  accesses is free, so cycle counts are for comparing runs, not silicon.
+ *
+ *  Host build, from the repository root (every file compiled as C++ so
+ *  the driverlib sources see the HWREG() proxy):
+ *    g++ -std=c++14 -DHOST_SIM -I. -x c++ sim_regs.c sim_tm4c.cpp \
+ *        interrupt.c uart.c <drivers and host main> -o sim
+ */
+
+#ifndef SIM_TM4C_H_
+#define SIM_TM4C_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SIM_UARTS           8
+#define SIM_ACCESS_CYCLES   2           // cycles charged per register access
+#define SIM_IRQ_ENTRY_CYCLES 12         // exception stacking
+#define SIM_IRQ_EXIT_CYCLES  10         // exception return
+
+struct SimUARTStats {
+    uint32_t ui32TxBytes;               // frames fully shifted out
+    uint32_t ui32RxBytes;               // frames placed in the RX FIFO
+    uint32_t ui32Overruns;              // frames lost to a full RX FIFO
+    uint32_t ui32FramingErrors;         // frames received at the wrong baud
+    uint32_t ui32Filtered;              // frames dropped by 9-bit matching
+    uint64_t ui64LastTx;                // cycle the last frame finished TX
+    uint64_t ui64LastRx;                // cycle the last frame entered the FIFO
+};
+
+struct SimIrqStats {
+    uint32_t ui32Count;                 // handler entries with a known start
+    uint32_t ui32MaxLatency;            // cycles, line asserted to handler
+    uint64_t ui64TotalLatency;
+    uint64_t ui64HandlerCycles;         // entry to return, including both
+};
+
+//------------SimInit------------
+// Reset every model, the register file, the RAM vector table and time
+// Input: ui32ClockHz is the system clock the simulated core runs at
+// Output: none
+void SimInit(uint32_t ui32ClockHz);
+
+//------------SimNow------------
+// Input: none
+// Output: system clock cycles since SimInit
+uint64_t SimNow(void);
+
+//------------SimAdvance------------
+// Let time pass (modelled CPU work), taking any interrupts that come due
+// Input: ui32Cycles to advance
+// Output: none
+void SimAdvance(uint32_t ui32Cycles);
+
+//------------SimSleepCycles------------
+// Input: none
+// Output: cycles spent inside CPUwfi() since SimInit
+uint64_t SimSleepCycles(void);
+
+//------------SimUARTConnect------------
+// Cross connect two ports' TX and RX lines (null modem)
+// Input: ui32PortA, ui32PortB are UART numbers 0-7
+// Output: none
+void SimUARTConnect(uint32_t ui32PortA, uint32_t ui32PortB);
+
+//------------SimUARTBusJoin------------
+// Put a port on the shared multidrop bus: every frame a bus port sends
+// reaches all the other bus ports, 9th bit included. Collisions are not
+// modelled; the protocol must keep to one talker at a time.
+// Input: ui32Port is the UART number 0-7
+// Output: none
+void SimUARTBusJoin(uint32_t ui32Port);
+
+//------------SimUARTLineLimit------------
+// Model a cable that only carries rates up to a limit: while a port
+// sends to its connected peer faster than that, every fourth frame
+// arrives with a flipped bit and a framing error
+// Input: ui32Port is the UART number 0-7, ui32Baud the limit, 0 for none
+// Output: none
+void SimUARTLineLimit(uint32_t ui32Port, uint32_t ui32Baud);
+
+//------------SimUARTHostWrite------------
+// Queue bytes to arrive on a port's RX line back to back at line rate
+// Input: ui32Port is the UART number, pui8Data/ui32Len the bytes
+// Output: number of bytes queued
+uint32_t SimUARTHostWrite(uint32_t ui32Port, const uint8_t *pui8Data,
+                          uint32_t ui32Len);
+
+//------------SimUARTHostRead------------
+// Collect bytes an unconnected port has transmitted
+// Input: ui32Port is the UART number, pui8Data receives up to ui32Len
+// Output: number of bytes copied
+uint32_t SimUARTHostRead(uint32_t ui32Port, uint8_t *pui8Data,
+                         uint32_t ui32Len);
+
+//------------SimUARTHostBaud------------
+// Baud rate the host side of a port transmits at. Frames arriving more
+// than 5% off the port's own rate are received with a framing error.
+// Input: ui32Port is the UART number, ui32Baud the rate (0 = match port)
+// Output: none
+void SimUARTHostBaud(uint32_t ui32Port, uint32_t ui32Baud);
+
+//------------SimUARTHostFlow------------
+// Make the host side of a port honour the port's RTS output: a frame
+// already on the line completes, but the next one waits for RTS. Ports
+// start with RTS deasserted, so the driver must assert it.
+// Input: ui32Port is the UART number, bEnable
+// Output: none
+void SimUARTHostFlow(uint32_t ui32Port, bool bEnable);
+
+//------------SimUARTHostXonXoff------------
+// Make the host side of a port obey XON/XOFF the port transmits: those
+// two bytes are taken off the line instead of being handed to
+// SimUARTHostRead, and after XOFF the host finishes the frame on the
+// line and sends nothing more until XON
+// Input: ui32Port is the UART number, bEnable
+// Output: none
+void SimUARTHostXonXoff(uint32_t ui32Port, bool bEnable);
+
+//------------SimUARTHostCts------------
+// Drive the CTS input of a port that is not connected to a peer (a
+// connected port sees its peer's RTS). Asserted after SimInit.
+// Input: ui32Port is the UART number, bAssert
+// Output: none
+void SimUARTHostCts(uint32_t ui32Port, bool bAssert);
+
+//------------SimUARTGetStats------------
+// Input: ui32Port is the UART number
+// Output: line level counters for the port
+const SimUARTStats *SimUARTGetStats(uint32_t ui32Port);
+
+//------------SimIrqGetStats------------
+// Latency is measured from the line asserting (or the vector being
+// pended) to the first instruction of the handler, including the
+// entry cycles. A line still asserted when its handler returns starts
+// a new measurement there.
+// Input: ui32Vector is the vector number, e.g. INT_UART0_TM4C123
+// Output: counters since SimInit
+const SimIrqStats *SimIrqGetStats(uint32_t ui32Vector);
+
+#endif /* SIM_TM4C_H_ */
@@ -0,0 +1,1374 @@
+/*
+ * sim_tm4c123gh6pm.h
+ *
+ *  HOST_SIM remapping of the tm4c123gh6pm.h register macros onto HWREG()
+ *  so code written against the UARTn_*_R style names reaches the
+ *  simulated peripherals instead of dereferencing raw addresses. Covers
+ *  the UART, GPIO (APB ports A-F), SYSCTL and NVIC registers.
+ *
+ *  Generated from tm4c123gh6pm.h: every
+ *    #define NAME_R (*((volatile unsigned long *)ADDR))
+ *  in those blocks becomes
+ *    #undef NAME_R
+ *    #define NAME_R HWREG(ADDR)
+ */
+
+#ifndef SIM_TM4C123GH6PM_H_
+#define SIM_TM4C123GH6PM_H_
+
+#include "hw_types.h"
+
+#undef GPIO_PORTA_DATA_R
+#define GPIO_PORTA_DATA_R           HWREG(0x400043FC)
+#undef GPIO_PORTA_DIR_R
+#define GPIO_PORTA_DIR_R            HWREG(0x40004400)
+#undef GPIO_PORTA_IS_R
+#define GPIO_PORTA_IS_R             HWREG(0x40004404)
+#undef GPIO_PORTA_IBE_R
+#define GPIO_PORTA_IBE_R            HWREG(0x40004408)
+#undef GPIO_PORTA_IEV_R
+#define GPIO_PORTA_IEV_R            HWREG(0x4000440C)
+#undef GPIO_PORTA_IM_R
+#define GPIO_PORTA_IM_R             HWREG(0x40004410)
+#undef GPIO_PORTA_RIS_R
+#define GPIO_PORTA_RIS_R            HWREG(0x40004414)
+#undef GPIO_PORTA_MIS_R
+#define GPIO_PORTA_MIS_R            HWREG(0x40004418)
+#undef GPIO_PORTA_ICR_R
+#define GPIO_PORTA_ICR_R            HWREG(0x4000441C)
+#undef GPIO_PORTA_AFSEL_R
+#define GPIO_PORTA_AFSEL_R          HWREG(0x40004420)
+#undef GPIO_PORTA_DR2R_R
+#define GPIO_PORTA_DR2R_R           HWREG(0x40004500)
+#undef GPIO_PORTA_DR4R_R
+#define GPIO_PORTA_DR4R_R           HWREG(0x40004504)
+#undef GPIO_PORTA_DR8R_R
+#define GPIO_PORTA_DR8R_R           HWREG(0x40004508)
+#undef GPIO_PORTA_ODR_R
+#define GPIO_PORTA_ODR_R            HWREG(0x4000450C)
+#undef GPIO_PORTA_PUR_R
+#define GPIO_PORTA_PUR_R            HWREG(0x40004510)
+#undef GPIO_PORTA_PDR_R
+#define GPIO_PORTA_PDR_R            HWREG(0x40004514)
+#undef GPIO_PORTA_SLR_R
+#define GPIO_PORTA_SLR_R            HWREG(0x40004518)
+#undef GPIO_PORTA_DEN_R
+#define GPIO_PORTA_DEN_R            HWREG(0x4000451C)
+#undef GPIO_PORTA_LOCK_R
+#define GPIO_PORTA_LOCK_R           HWREG(0x40004520)
+#undef GPIO_PORTA_CR_R
+#define GPIO_PORTA_CR_R             HWREG(0x40004524)
+#undef GPIO_PORTA_AMSEL_R
+#define GPIO_PORTA_AMSEL_R          HWREG(0x40004528)
+#undef GPIO_PORTA_PCTL_R
+#define GPIO_PORTA_PCTL_R           HWREG(0x4000452C)
+#undef GPIO_PORTA_ADCCTL_R
+#define GPIO_PORTA_ADCCTL_R         HWREG(0x40004530)
+#undef GPIO_PORTA_DMACTL_R
+#define GPIO_PORTA_DMACTL_R         HWREG(0x40004534)
+#undef GPIO_PORTB_DATA_R
+#define GPIO_PORTB_DATA_R           HWREG(0x400053FC)
+#undef GPIO_PORTB_DIR_R
+#define GPIO_PORTB_DIR_R            HWREG(0x40005400)
+#undef GPIO_PORTB_IS_R
+#define GPIO_PORTB_IS_R             HWREG(0x40005404)
+#undef GPIO_PORTB_IBE_R
+#define GPIO_PORTB_IBE_R            HWREG(0x40005408)
+#undef GPIO_PORTB_IEV_R
+#define GPIO_PORTB_IEV_R            HWREG(0x4000540C)
+#undef GPIO_PORTB_IM_R
+#define GPIO_PORTB_IM_R             HWREG(0x40005410)
+#undef GPIO_PORTB_RIS_R
+#define GPIO_PORTB_RIS_R            HWREG(0x40005414)
+#undef GPIO_PORTB_MIS_R
+#define GPIO_PORTB_MIS_R            HWREG(0x40005418)
+#undef GPIO_PORTB_ICR_R
+#define GPIO_PORTB_ICR_R            HWREG(0x4000541C)
+#undef GPIO_PORTB_AFSEL_R
+#define GPIO_PORTB_AFSEL_R          HWREG(0x40005420)
+#undef GPIO_PORTB_DR2R_R
+#define GPIO_PORTB_DR2R_R           HWREG(0x40005500)
+#undef GPIO_PORTB_DR4R_R
+#define GPIO_PORTB_DR4R_R           HWREG(0x40005504)
+#undef GPIO_PORTB_DR8R_R
+#define GPIO_PORTB_DR8R_R           HWREG(0x40005508)
+#undef GPIO_PORTB_ODR_R
+#define GPIO_PORTB_ODR_R            HWREG(0x4000550C)
+#undef GPIO_PORTB_PUR_R
+#define GPIO_PORTB_PUR_R            HWREG(0x40005510)
+#undef GPIO_PORTB_PDR_R
+#define GPIO_PORTB_PDR_R            HWREG(0x40005514)
+#undef GPIO_PORTB_SLR_R
+#define GPIO_PORTB_SLR_R            HWREG(0x40005518)
+#undef GPIO_PORTB_DEN_R
+#define GPIO_PORTB_DEN_R            HWREG(0x4000551C)
+#undef GPIO_PORTB_LOCK_R
+#define GPIO_PORTB_LOCK_R           HWREG(0x40005520)
+#undef GPIO_PORTB_CR_R
+#define GPIO_PORTB_CR_R             HWREG(0x40005524)
+#undef GPIO_PORTB_AMSEL_R
+#define GPIO_PORTB_AMSEL_R          HWREG(0x40005528)
+#undef GPIO_PORTB_PCTL_R
+#define GPIO_PORTB_PCTL_R           HWREG(0x4000552C)
+#undef GPIO_PORTB_ADCCTL_R
+#define GPIO_PORTB_ADCCTL_R         HWREG(0x40005530)
+#undef GPIO_PORTB_DMACTL_R
+#define GPIO_PORTB_DMACTL_R         HWREG(0x40005534)
+#undef GPIO_PORTC_DATA_R
+#define GPIO_PORTC_DATA_R           HWREG(0x400063FC)
+#undef GPIO_PORTC_DIR_R
+#define GPIO_PORTC_DIR_R            HWREG(0x40006400)
+#undef GPIO_PORTC_IS_R
+#define GPIO_PORTC_IS_R             HWREG(0x40006404)
+#undef GPIO_PORTC_IBE_R
+#define GPIO_PORTC_IBE_R            HWREG(0x40006408)
+#undef GPIO_PORTC_IEV_R
+#define GPIO_PORTC_IEV_R            HWREG(0x4000640C)
+#undef GPIO_PORTC_IM_R
+#define GPIO_PORTC_IM_R             HWREG(0x40006410)
+#undef GPIO_PORTC_RIS_R
+#define GPIO_PORTC_RIS_R            HWREG(0x40006414)
+#undef GPIO_PORTC_MIS_R
+#define GPIO_PORTC_MIS_R            HWREG(0x40006418)
+#undef GPIO_PORTC_ICR_R
+#define GPIO_PORTC_ICR_R            HWREG(0x4000641C)
+#undef GPIO_PORTC_AFSEL_R
+#define GPIO_PORTC_AFSEL_R          HWREG(0x40006420)
+#undef GPIO_PORTC_DR2R_R
+#define GPIO_PORTC_DR2R_R           HWREG(0x40006500)
+#undef GPIO_PORTC_DR4R_R
+#define GPIO_PORTC_DR4R_R           HWREG(0x40006504)
+#undef GPIO_PORTC_DR8R_R
+#define GPIO_PORTC_DR8R_R           HWREG(0x40006508)
+#undef GPIO_PORTC_ODR_R
+#define GPIO_PORTC_ODR_R            HWREG(0x4000650C)
+#undef GPIO_PORTC_PUR_R
+#define GPIO_PORTC_PUR_R            HWREG(0x40006510)
+#undef GPIO_PORTC_PDR_R
+#define GPIO_PORTC_PDR_R            HWREG(0x40006514)
+#undef GPIO_PORTC_SLR_R
+#define GPIO_PORTC_SLR_R            HWREG(0x40006518)
+#undef GPIO_PORTC_DEN_R
+#define GPIO_PORTC_DEN_R            HWREG(0x4000651C)
+#undef GPIO_PORTC_LOCK_R
+#define GPIO_PORTC_LOCK_R           HWREG(0x40006520)
+#undef GPIO_PORTC_CR_R
+#define GPIO_PORTC_CR_R             HWREG(0x40006524)
+#undef GPIO_PORTC_AMSEL_R
+#define GPIO_PORTC_AMSEL_R          HWREG(0x40006528)
+#undef GPIO_PORTC_PCTL_R
+#define GPIO_PORTC_PCTL_R           HWREG(0x4000652C)
+#undef GPIO_PORTC_ADCCTL_R
+#define GPIO_PORTC_ADCCTL_R         HWREG(0x40006530)
+#undef GPIO_PORTC_DMACTL_R
+#define GPIO_PORTC_DMACTL_R         HWREG(0x40006534)
+#undef GPIO_PORTD_DATA_R
+#define GPIO_PORTD_DATA_R           HWREG(0x400073FC)
+#undef GPIO_PORTD_DIR_R
+#define GPIO_PORTD_DIR_R            HWREG(0x40007400)
+#undef GPIO_PORTD_IS_R
+#define GPIO_PORTD_IS_R             HWREG(0x40007404)
+#undef GPIO_PORTD_IBE_R
+#define GPIO_PORTD_IBE_R            HWREG(0x40007408)
+#undef GPIO_PORTD_IEV_R
+#define GPIO_PORTD_IEV_R            HWREG(0x4000740C)
+#undef GPIO_PORTD_IM_R
+#define GPIO_PORTD_IM_R             HWREG(0x40007410)
+#undef GPIO_PORTD_RIS_R
+#define GPIO_PORTD_RIS_R            HWREG(0x40007414)
+#undef GPIO_PORTD_MIS_R
+#define GPIO_PORTD_MIS_R            HWREG(0x40007418)
+#undef GPIO_PORTD_ICR_R
+#define GPIO_PORTD_ICR_R            HWREG(0x4000741C)
+#undef GPIO_PORTD_AFSEL_R
+#define GPIO_PORTD_AFSEL_R          HWREG(0x40007420)
+#undef GPIO_PORTD_DR2R_R
+#define GPIO_PORTD_DR2R_R           HWREG(0x40007500)
+#undef GPIO_PORTD_DR4R_R
+#define GPIO_PORTD_DR4R_R           HWREG(0x40007504)
+#undef GPIO_PORTD_DR8R_R
+#define GPIO_PORTD_DR8R_R           HWREG(0x40007508)
+#undef GPIO_PORTD_ODR_R
+#define GPIO_PORTD_ODR_R            HWREG(0x4000750C)
+#undef GPIO_PORTD_PUR_R
+#define GPIO_PORTD_PUR_R            HWREG(0x40007510)
+#undef GPIO_PORTD_PDR_R
+#define GPIO_PORTD_PDR_R            HWREG(0x40007514)
+#undef GPIO_PORTD_SLR_R
+#define GPIO_PORTD_SLR_R            HWREG(0x40007518)
+#undef GPIO_PORTD_DEN_R
+#define GPIO_PORTD_DEN_R            HWREG(0x4000751C)
+#undef GPIO_PORTD_LOCK_R
+#define GPIO_PORTD_LOCK_R           HWREG(0x40007520)
+#undef GPIO_PORTD_CR_R
+#define GPIO_PORTD_CR_R             HWREG(0x40007524)
+#undef GPIO_PORTD_AMSEL_R
+#define GPIO_PORTD_AMSEL_R          HWREG(0x40007528)
+#undef GPIO_PORTD_PCTL_R
+#define GPIO_PORTD_PCTL_R           HWREG(0x4000752C)
+#undef GPIO_PORTD_ADCCTL_R
+#define GPIO_PORTD_ADCCTL_R         HWREG(0x40007530)
+#undef GPIO_PORTD_DMACTL_R
+#define GPIO_PORTD_DMACTL_R         HWREG(0x40007534)
+#undef UART0_DR_R
+#define UART0_DR_R                  HWREG(0x4000C000)
+#undef UART0_RSR_R
+#define UART0_RSR_R                 HWREG(0x4000C004)
+#undef UART0_ECR_R
+#define UART0_ECR_R                 HWREG(0x4000C004)
+#undef UART0_FR_R
+#define UART0_FR_R                  HWREG(0x4000C018)
+#undef UART0_ILPR_R
+#define UART0_ILPR_R                HWREG(0x4000C020)
+#undef UART0_IBRD_R
+#define UART0_IBRD_R                HWREG(0x4000C024)
+#undef UART0_FBRD_R
+#define UART0_FBRD_R                HWREG(0x4000C028)
+#undef UART0_LCRH_R
+#define UART0_LCRH_R                HWREG(0x4000C02C)
+#undef UART0_CTL_R
+#define UART0_CTL_R                 HWREG(0x4000C030)
+#undef UART0_IFLS_R
+#define UART0_IFLS_R                HWREG(0x4000C034)
+#undef UART0_IM_R
+#define UART0_IM_R                  HWREG(0x4000C038)
+#undef UART0_RIS_R
+#define UART0_RIS_R                 HWREG(0x4000C03C)
+#undef UART0_MIS_R
+#define UART0_MIS_R                 HWREG(0x4000C040)
+#undef UART0_ICR_R
+#define UART0_ICR_R                 HWREG(0x4000C044)
+#undef UART0_DMACTL_R
+#define UART0_DMACTL_R              HWREG(0x4000C048)
+#undef UART0_9BITADDR_R
+#define UART0_9BITADDR_R            HWREG(0x4000C0A4)
+#undef UART0_9BITAMASK_R
+#define UART0_9BITAMASK_R           HWREG(0x4000C0A8)
+#undef UART0_PP_R
+#define UART0_PP_R                  HWREG(0x4000CFC0)
+#undef UART0_CC_R
+#define UART0_CC_R                  HWREG(0x4000CFC8)
+#undef UART1_DR_R
+#define UART1_DR_R                  HWREG(0x4000D000)
+#undef UART1_RSR_R
+#define UART1_RSR_R                 HWREG(0x4000D004)
+#undef UART1_ECR_R
+#define UART1_ECR_R                 HWREG(0x4000D004)
+#undef UART1_FR_R
+#define UART1_FR_R                  HWREG(0x4000D018)
+#undef UART1_ILPR_R
+#define UART1_ILPR_R                HWREG(0x4000D020)
+#undef UART1_IBRD_R
+#define UART1_IBRD_R                HWREG(0x4000D024)
+#undef UART1_FBRD_R
+#define UART1_FBRD_R                HWREG(0x4000D028)
+#undef UART1_LCRH_R
+#define UART1_LCRH_R                HWREG(0x4000D02C)
+#undef UART1_CTL_R
+#define UART1_CTL_R                 HWREG(0x4000D030)
+#undef UART1_IFLS_R
+#define UART1_IFLS_R                HWREG(0x4000D034)
+#undef UART1_IM_R
+#define UART1_IM_R                  HWREG(0x4000D038)
+#undef UART1_RIS_R
+#define UART1_RIS_R                 HWREG(0x4000D03C)
+#undef UART1_MIS_R
+#define UART1_MIS_R                 HWREG(0x4000D040)
+#undef UART1_ICR_R
+#define UART1_ICR_R                 HWREG(0x4000D044)
+#undef UART1_DMACTL_R
+#define UART1_DMACTL_R              HWREG(0x4000D048)
+#undef UART1_9BITADDR_R
+#define UART1_9BITADDR_R            HWREG(0x4000D0A4)
+#undef UART1_9BITAMASK_R
+#define UART1_9BITAMASK_R           HWREG(0x4000D0A8)
+#undef UART1_PP_R
+#define UART1_PP_R                  HWREG(0x4000DFC0)
+#undef UART1_CC_R
+#define UART1_CC_R                  HWREG(0x4000DFC8)
+#undef UART2_DR_R
+#define UART2_DR_R                  HWREG(0x4000E000)
+#undef UART2_RSR_R
+#define UART2_RSR_R                 HWREG(0x4000E004)
+#undef UART2_ECR_R
+#define UART2_ECR_R                 HWREG(0x4000E004)
+#undef UART2_FR_R
+#define UART2_FR_R                  HWREG(0x4000E018)
+#undef UART2_ILPR_R
+#define UART2_ILPR_R                HWREG(0x4000E020)
+#undef UART2_IBRD_R
+#define UART2_IBRD_R                HWREG(0x4000E024)
+#undef UART2_FBRD_R
+#define UART2_FBRD_R                HWREG(0x4000E028)
+#undef UART2_LCRH_R
+#define UART2_LCRH_R                HWREG(0x4000E02C)
+#undef UART2_CTL_R
+#define UART2_CTL_R                 HWREG(0x4000E030)
+#undef UART2_IFLS_R
+#define UART2_IFLS_R                HWREG(0x4000E034)
+#undef UART2_IM_R
+#define UART2_IM_R                  HWREG(0x4000E038)
+#undef UART2_RIS_R
+#define UART2_RIS_R                 HWREG(0x4000E03C)
+#undef UART2_MIS_R
+#define UART2_MIS_R                 HWREG(0x4000E040)
+#undef UART2_ICR_R
+#define UART2_ICR_R                 HWREG(0x4000E044)
+#undef UART2_DMACTL_R
+#define UART2_DMACTL_R              HWREG(0x4000E048)
+#undef UART2_9BITADDR_R
+#define UART2_9BITADDR_R            HWREG(0x4000E0A4)
+#undef UART2_9BITAMASK_R
+#define UART2_9BITAMASK_R           HWREG(0x4000E0A8)
+#undef UART2_PP_R
+#define UART2_PP_R                  HWREG(0x4000EFC0)
+#undef UART2_CC_R
+#define UART2_CC_R                  HWREG(0x4000EFC8)
+#undef UART3_DR_R
+#define UART3_DR_R                  HWREG(0x4000F000)
+#undef UART3_RSR_R
+#define UART3_RSR_R                 HWREG(0x4000F004)
+#undef UART3_ECR_R
+#define UART3_ECR_R                 HWREG(0x4000F004)
+#undef UART3_FR_R
+#define UART3_FR_R                  HWREG(0x4000F018)
+#undef UART3_ILPR_R
+#define UART3_ILPR_R                HWREG(0x4000F020)
+#undef UART3_IBRD_R
+#define UART3_IBRD_R                HWREG(0x4000F024)
+#undef UART3_FBRD_R
+#define UART3_FBRD_R                HWREG(0x4000F028)
+#undef UART3_LCRH_R
+#define UART3_LCRH_R                HWREG(0x4000F02C)
+#undef UART3_CTL_R
+#define UART3_CTL_R                 HWREG(0x4000F030)
+#undef UART3_IFLS_R
+#define UART3_IFLS_R                HWREG(0x4000F034)
+#undef UART3_IM_R
+#define UART3_IM_R                  HWREG(0x4000F038)
+#undef UART3_RIS_R
+#define UART3_RIS_R                 HWREG(0x4000F03C)
+#undef UART3_MIS_R
+#define UART3_MIS_R                 HWREG(0x4000F040)
+#undef UART3_ICR_R
+#define UART3_ICR_R                 HWREG(0x4000F044)
+#undef UART3_DMACTL_R
+#define UART3_DMACTL_R              HWREG(0x4000F048)
+#undef UART3_9BITADDR_R
+#define UART3_9BITADDR_R            HWREG(0x4000F0A4)
+#undef UART3_9BITAMASK_R
+#define UART3_9BITAMASK_R           HWREG(0x4000F0A8)
+#undef UART3_PP_R
+#define UART3_PP_R                  HWREG(0x4000FFC0)
+#undef UART3_CC_R
+#define UART3_CC_R                  HWREG(0x4000FFC8)
+#undef UART4_DR_R
+#define UART4_DR_R                  HWREG(0x40010000)
+#undef UART4_RSR_R
+#define UART4_RSR_R                 HWREG(0x40010004)
+#undef UART4_ECR_R
+#define UART4_ECR_R                 HWREG(0x40010004)
+#undef UART4_FR_R
+#define UART4_FR_R                  HWREG(0x40010018)
+#undef UART4_ILPR_R
+#define UART4_ILPR_R                HWREG(0x40010020)
+#undef UART4_IBRD_R
+#define UART4_IBRD_R                HWREG(0x40010024)
+#undef UART4_FBRD_R
+#define UART4_FBRD_R                HWREG(0x40010028)
+#undef UART4_LCRH_R
+#define UART4_LCRH_R                HWREG(0x4001002C)
+#undef UART4_CTL_R
+#define UART4_CTL_R                 HWREG(0x40010030)
+#undef UART4_IFLS_R
+#define UART4_IFLS_R                HWREG(0x40010034)
+#undef UART4_IM_R
+#define UART4_IM_R                  HWREG(0x40010038)
+#undef UART4_RIS_R
+#define UART4_RIS_R                 HWREG(0x4001003C)
+#undef UART4_MIS_R
+#define UART4_MIS_R                 HWREG(0x40010040)
+#undef UART4_ICR_R
+#define UART4_ICR_R                 HWREG(0x40010044)
+#undef UART4_DMACTL_R
+#define UART4_DMACTL_R              HWREG(0x40010048)
+#undef UART4_9BITADDR_R
+#define UART4_9BITADDR_R            HWREG(0x400100A4)
+#undef UART4_9BITAMASK_R
+#define UART4_9BITAMASK_R           HWREG(0x400100A8)
+#undef UART4_PP_R
+#define UART4_PP_R                  HWREG(0x40010FC0)
+#undef UART4_CC_R
+#define UART4_CC_R                  HWREG(0x40010FC8)
+#undef UART5_DR_R
+#define UART5_DR_R                  HWREG(0x40011000)
+#undef UART5_RSR_R
+#define UART5_RSR_R                 HWREG(0x40011004)
+#undef UART5_ECR_R
+#define UART5_ECR_R                 HWREG(0x40011004)
+#undef UART5_FR_R
+#define UART5_FR_R                  HWREG(0x40011018)
+#undef UART5_ILPR_R
+#define UART5_ILPR_R                HWREG(0x40011020)
+#undef UART5_IBRD_R
+#define UART5_IBRD_R                HWREG(0x40011024)
+#undef UART5_FBRD_R
+#define UART5_FBRD_R                HWREG(0x40011028)
+#undef UART5_LCRH_R
+#define UART5_LCRH_R                HWREG(0x4001102C)
+#undef UART5_CTL_R
+#define UART5_CTL_R                 HWREG(0x40011030)
+#undef UART5_IFLS_R
+#define UART5_IFLS_R                HWREG(0x40011034)
+#undef UART5_IM_R
+#define UART5_IM_R                  HWREG(0x40011038)
+#undef UART5_RIS_R
+#define UART5_RIS_R                 HWREG(0x4001103C)
+#undef UART5_MIS_R
+#define UART5_MIS_R                 HWREG(0x40011040)
+#undef UART5_ICR_R
+#define UART5_ICR_R                 HWREG(0x40011044)
+#undef UART5_DMACTL_R
+#define UART5_DMACTL_R              HWREG(0x40011048)
+#undef UART5_9BITADDR_R
+#define UART5_9BITADDR_R            HWREG(0x400110A4)
+#undef UART5_9BITAMASK_R
+#define UART5_9BITAMASK_R           HWREG(0x400110A8)
+#undef UART5_PP_R
+#define UART5_PP_R                  HWREG(0x40011FC0)
+#undef UART5_CC_R
+#define UART5_CC_R                  HWREG(0x40011FC8)
+#undef UART6_DR_R
+#define UART6_DR_R                  HWREG(0x40012000)
+#undef UART6_RSR_R
+#define UART6_RSR_R                 HWREG(0x40012004)
+#undef UART6_ECR_R
+#define UART6_ECR_R                 HWREG(0x40012004)
+#undef UART6_FR_R
+#define UART6_FR_R                  HWREG(0x40012018)
+#undef UART6_ILPR_R
+#define UART6_ILPR_R                HWREG(0x40012020)
+#undef UART6_IBRD_R
+#define UART6_IBRD_R                HWREG(0x40012024)
+#undef UART6_FBRD_R
+#define UART6_FBRD_R                HWREG(0x40012028)
+#undef UART6_LCRH_R
+#define UART6_LCRH_R                HWREG(0x4001202C)
+#undef UART6_CTL_R
+#define UART6_CTL_R                 HWREG(0x40012030)
+#undef UART6_IFLS_R
+#define UART6_IFLS_R                HWREG(0x40012034)
+#undef UART6_IM_R
+#define UART6_IM_R                  HWREG(0x40012038)
+#undef UART6_RIS_R
+#define UART6_RIS_R                 HWREG(0x4001203C)
+#undef UART6_MIS_R
+#define UART6_MIS_R                 HWREG(0x40012040)
+#undef UART6_ICR_R
+#define UART6_ICR_R                 HWREG(0x40012044)
+#undef UART6_DMACTL_R
+#define UART6_DMACTL_R              HWREG(0x40012048)
+#undef UART6_9BITADDR_R
+#define UART6_9BITADDR_R            HWREG(0x400120A4)
+#undef UART6_9BITAMASK_R
+#define UART6_9BITAMASK_R           HWREG(0x400120A8)
+#undef UART6_PP_R
+#define UART6_PP_R                  HWREG(0x40012FC0)
+#undef UART6_CC_R
+#define UART6_CC_R                  HWREG(0x40012FC8)
+#undef UART7_DR_R
+#define UART7_DR_R                  HWREG(0x40013000)
+#undef UART7_RSR_R
+#define UART7_RSR_R                 HWREG(0x40013004)
+#undef UART7_ECR_R
+#define UART7_ECR_R                 HWREG(0x40013004)
+#undef UART7_FR_R
+#define UART7_FR_R                  HWREG(0x40013018)
+#undef UART7_ILPR_R
+#define UART7_ILPR_R                HWREG(0x40013020)
+#undef UART7_IBRD_R
+#define UART7_IBRD_R                HWREG(0x40013024)
+#undef UART7_FBRD_R
+#define UART7_FBRD_R                HWREG(0x40013028)
+#undef UART7_LCRH_R
+#define UART7_LCRH_R                HWREG(0x4001302C)
+#undef UART7_CTL_R
+#define UART7_CTL_R                 HWREG(0x40013030)
+#undef UART7_IFLS_R
+#define UART7_IFLS_R                HWREG(0x40013034)
+#undef UART7_IM_R
+#define UART7_IM_R                  HWREG(0x40013038)
+#undef UART7_RIS_R
+#define UART7_RIS_R                 HWREG(0x4001303C)
+#undef UART7_MIS_R
+#define UART7_MIS_R                 HWREG(0x40013040)
+#undef UART7_ICR_R
+#define UART7_ICR_R                 HWREG(0x40013044)
+#undef UART7_DMACTL_R
+#define UART7_DMACTL_R              HWREG(0x40013048)
+#undef UART7_9BITADDR_R
+#define UART7_9BITADDR_R            HWREG(0x400130A4)
+#undef UART7_9BITAMASK_R
+#define UART7_9BITAMASK_R           HWREG(0x400130A8)
+#undef UART7_PP_R
+#define UART7_PP_R                  HWREG(0x40013FC0)
+#undef UART7_CC_R
+#define UART7_CC_R                  HWREG(0x40013FC8)
+#undef GPIO_PORTE_DATA_R
+#define GPIO_PORTE_DATA_R           HWREG(0x400243FC)
+#undef GPIO_PORTE_DIR_R
+#define GPIO_PORTE_DIR_R            HWREG(0x40024400)
+#undef GPIO_PORTE_IS_R
+#define GPIO_PORTE_IS_R             HWREG(0x40024404)
+#undef GPIO_PORTE_IBE_R
+#define GPIO_PORTE_IBE_R            HWREG(0x40024408)
+#undef GPIO_PORTE_IEV_R
+#define GPIO_PORTE_IEV_R            HWREG(0x4002440C)
+#undef GPIO_PORTE_IM_R
+#define GPIO_PORTE_IM_R             HWREG(0x40024410)
+#undef GPIO_PORTE_RIS_R
+#define GPIO_PORTE_RIS_R            HWREG(0x40024414)
+#undef GPIO_PORTE_MIS_R
+#define GPIO_PORTE_MIS_R            HWREG(0x40024418)
+#undef GPIO_PORTE_ICR_R
+#define GPIO_PORTE_ICR_R            HWREG(0x4002441C)
+#undef GPIO_PORTE_AFSEL_R
+#define GPIO_PORTE_AFSEL_R          HWREG(0x40024420)
+#undef GPIO_PORTE_DR2R_R
+#define GPIO_PORTE_DR2R_R           HWREG(0x40024500)
+#undef GPIO_PORTE_DR4R_R
+#define GPIO_PORTE_DR4R_R           HWREG(0x40024504)
+#undef GPIO_PORTE_DR8R_R
+#define GPIO_PORTE_DR8R_R           HWREG(0x40024508)
+#undef GPIO_PORTE_ODR_R
+#define GPIO_PORTE_ODR_R            HWREG(0x4002450C)
+#undef GPIO_PORTE_PUR_R
+#define GPIO_PORTE_PUR_R            HWREG(0x40024510)
+#undef GPIO_PORTE_PDR_R
+#define GPIO_PORTE_PDR_R            HWREG(0x40024514)
+#undef GPIO_PORTE_SLR_R
+#define GPIO_PORTE_SLR_R            HWREG(0x40024518)
+#undef GPIO_PORTE_DEN_R
+#define GPIO_PORTE_DEN_R            HWREG(0x4002451C)
+#undef GPIO_PORTE_LOCK_R
+#define GPIO_PORTE_LOCK_R           HWREG(0x40024520)
+#undef GPIO_PORTE_CR_R
+#define GPIO_PORTE_CR_R             HWREG(0x40024524)
+#undef GPIO_PORTE_AMSEL_R
+#define GPIO_PORTE_AMSEL_R          HWREG(0x40024528)
+#undef GPIO_PORTE_PCTL_R
+#define GPIO_PORTE_PCTL_R           HWREG(0x4002452C)
+#undef GPIO_PORTE_ADCCTL_R
+#define GPIO_PORTE_ADCCTL_R         HWREG(0x40024530)
+#undef GPIO_PORTE_DMACTL_R
+#define GPIO_PORTE_DMACTL_R         HWREG(0x40024534)
+#undef GPIO_PORTF_DATA_R
+#define GPIO_PORTF_DATA_R           HWREG(0x400253FC)
+#undef GPIO_PORTF_DIR_R
+#define GPIO_PORTF_DIR_R            HWREG(0x40025400)
+#undef GPIO_PORTF_IS_R
+#define GPIO_PORTF_IS_R             HWREG(0x40025404)
+#undef GPIO_PORTF_IBE_R
+#define GPIO_PORTF_IBE_R            HWREG(0x40025408)
+#undef GPIO_PORTF_IEV_R
+#define GPIO_PORTF_IEV_R            HWREG(0x4002540C)
+#undef GPIO_PORTF_IM_R
+#define GPIO_PORTF_IM_R             HWREG(0x40025410)
+#undef GPIO_PORTF_RIS_R
+#define GPIO_PORTF_RIS_R            HWREG(0x40025414)
+#undef GPIO_PORTF_MIS_R
+#define GPIO_PORTF_MIS_R            HWREG(0x40025418)
+#undef GPIO_PORTF_ICR_R
+#define GPIO_PORTF_ICR_R            HWREG(0x4002541C)
+#undef GPIO_PORTF_AFSEL_R
+#define GPIO_PORTF_AFSEL_R          HWREG(0x40025420)
+#undef GPIO_PORTF_DR2R_R
+#define GPIO_PORTF_DR2R_R           HWREG(0x40025500)
+#undef GPIO_PORTF_DR4R_R
+#define GPIO_PORTF_DR4R_R           HWREG(0x40025504)
+#undef GPIO_PORTF_DR8R_R
+#define GPIO_PORTF_DR8R_R           HWREG(0x40025508)
+#undef GPIO_PORTF_ODR_R
+#define GPIO_PORTF_ODR_R            HWREG(0x4002550C)
+#undef GPIO_PORTF_PUR_R
+#define GPIO_PORTF_PUR_R            HWREG(0x40025510)
+#undef GPIO_PORTF_PDR_R
+#define GPIO_PORTF_PDR_R            HWREG(0x40025514)
+#undef GPIO_PORTF_SLR_R
+#define GPIO_PORTF_SLR_R            HWREG(0x40025518)
+#undef GPIO_PORTF_DEN_R
+#define GPIO_PORTF_DEN_R            HWREG(0x4002551C)
+#undef GPIO_PORTF_LOCK_R
+#define GPIO_PORTF_LOCK_R           HWREG(0x40025520)
+#undef GPIO_PORTF_CR_R
+#define GPIO_PORTF_CR_R             HWREG(0x40025524)
+#undef GPIO_PORTF_AMSEL_R
+#define GPIO_PORTF_AMSEL_R          HWREG(0x40025528)
+#undef GPIO_PORTF_PCTL_R
+#define GPIO_PORTF_PCTL_R           HWREG(0x4002552C)
+#undef GPIO_PORTF_ADCCTL_R
+#define GPIO_PORTF_ADCCTL_R         HWREG(0x40025530)
+#undef GPIO_PORTF_DMACTL_R
+#define GPIO_PORTF_DMACTL_R         HWREG(0x40025534)
+#undef GPIO_PORTA_AHB_DATA_R
+#define GPIO_PORTA_AHB_DATA_R       HWREG(0x400583FC)
+#undef GPIO_PORTA_AHB_DIR_R
+#define GPIO_PORTA_AHB_DIR_R        HWREG(0x40058400)
+#undef GPIO_PORTA_AHB_IS_R
+#define GPIO_PORTA_AHB_IS_R         HWREG(0x40058404)
+#undef GPIO_PORTA_AHB_IBE_R
+#define GPIO_PORTA_AHB_IBE_R        HWREG(0x40058408)
+#undef GPIO_PORTA_AHB_IEV_R
+#define GPIO_PORTA_AHB_IEV_R        HWREG(0x4005840C)
+#undef GPIO_PORTA_AHB_IM_R
+#define GPIO_PORTA_AHB_IM_R         HWREG(0x40058410)
+#undef GPIO_PORTA_AHB_RIS_R
+#define GPIO_PORTA_AHB_RIS_R        HWREG(0x40058414)
+#undef GPIO_PORTA_AHB_MIS_R
+#define GPIO_PORTA_AHB_MIS_R        HWREG(0x40058418)
+#undef GPIO_PORTA_AHB_ICR_R
+#define GPIO_PORTA_AHB_ICR_R        HWREG(0x4005841C)
+#undef GPIO_PORTA_AHB_AFSEL_R
+#define GPIO_PORTA_AHB_AFSEL_R      HWREG(0x40058420)
+#undef GPIO_PORTA_AHB_DR2R_R
+#define GPIO_PORTA_AHB_DR2R_R       HWREG(0x40058500)
+#undef GPIO_PORTA_AHB_DR4R_R
+#define GPIO_PORTA_AHB_DR4R_R       HWREG(0x40058504)
+#undef GPIO_PORTA_AHB_DR8R_R
+#define GPIO_PORTA_AHB_DR8R_R       HWREG(0x40058508)
+#undef GPIO_PORTA_AHB_ODR_R
+#define GPIO_PORTA_AHB_ODR_R        HWREG(0x4005850C)
+#undef GPIO_PORTA_AHB_PUR_R
+#define GPIO_PORTA_AHB_PUR_R        HWREG(0x40058510)
+#undef GPIO_PORTA_AHB_PDR_R
+#define GPIO_PORTA_AHB_PDR_R        HWREG(0x40058514)
+#undef GPIO_PORTA_AHB_SLR_R
+#define GPIO_PORTA_AHB_SLR_R        HWREG(0x40058518)
+#undef GPIO_PORTA_AHB_DEN_R
+#define GPIO_PORTA_AHB_DEN_R        HWREG(0x4005851C)
+#undef GPIO_PORTA_AHB_LOCK_R
+#define GPIO_PORTA_AHB_LOCK_R       HWREG(0x40058520)
+#undef GPIO_PORTA_AHB_CR_R
+#define GPIO_PORTA_AHB_CR_R         HWREG(0x40058524)
+#undef GPIO_PORTA_AHB_AMSEL_R
+#define GPIO_PORTA_AHB_AMSEL_R      HWREG(0x40058528)
+#undef GPIO_PORTA_AHB_PCTL_R
+#define GPIO_PORTA_AHB_PCTL_R       HWREG(0x4005852C)
+#undef GPIO_PORTA_AHB_ADCCTL_R
+#define GPIO_PORTA_AHB_ADCCTL_R     HWREG(0x40058530)
+#undef GPIO_PORTA_AHB_DMACTL_R
+#define GPIO_PORTA_AHB_DMACTL_R     HWREG(0x40058534)
+#undef GPIO_PORTB_AHB_DATA_R
+#define GPIO_PORTB_AHB_DATA_R       HWREG(0x400593FC)
+#undef GPIO_PORTB_AHB_DIR_R
+#define GPIO_PORTB_AHB_DIR_R        HWREG(0x40059400)
+#undef GPIO_PORTB_AHB_IS_R
+#define GPIO_PORTB_AHB_IS_R         HWREG(0x40059404)
+#undef GPIO_PORTB_AHB_IBE_R
+#define GPIO_PORTB_AHB_IBE_R        HWREG(0x40059408)
+#undef GPIO_PORTB_AHB_IEV_R
+#define GPIO_PORTB_AHB_IEV_R        HWREG(0x4005940C)
+#undef GPIO_PORTB_AHB_IM_R
+#define GPIO_PORTB_AHB_IM_R         HWREG(0x40059410)
+#undef GPIO_PORTB_AHB_RIS_R
+#define GPIO_PORTB_AHB_RIS_R        HWREG(0x40059414)
+#undef GPIO_PORTB_AHB_MIS_R
+#define GPIO_PORTB_AHB_MIS_R        HWREG(0x40059418)
+#undef GPIO_PORTB_AHB_ICR_R
+#define GPIO_PORTB_AHB_ICR_R        HWREG(0x4005941C)
+#undef GPIO_PORTB_AHB_AFSEL_R
+#define GPIO_PORTB_AHB_AFSEL_R      HWREG(0x40059420)
+#undef GPIO_PORTB_AHB_DR2R_R
+#define GPIO_PORTB_AHB_DR2R_R       HWREG(0x40059500)
+#undef GPIO_PORTB_AHB_DR4R_R
+#define GPIO_PORTB_AHB_DR4R_R       HWREG(0x40059504)
+#undef GPIO_PORTB_AHB_DR8R_R
+#define GPIO_PORTB_AHB_DR8R_R       HWREG(0x40059508)
+#undef GPIO_PORTB_AHB_ODR_R
+#define GPIO_PORTB_AHB_ODR_R        HWREG(0x4005950C)
+#undef GPIO_PORTB_AHB_PUR_R
+#define GPIO_PORTB_AHB_PUR_R        HWREG(0x40059510)
+#undef GPIO_PORTB_AHB_PDR_R
+#define GPIO_PORTB_AHB_PDR_R        HWREG(0x40059514)
+#undef GPIO_PORTB_AHB_SLR_R
+#define GPIO_PORTB_AHB_SLR_R        HWREG(0x40059518)
+#undef GPIO_PORTB_AHB_DEN_R
+#define GPIO_PORTB_AHB_DEN_R        HWREG(0x4005951C)
+#undef GPIO_PORTB_AHB_LOCK_R
+#define GPIO_PORTB_AHB_LOCK_R       HWREG(0x40059520)
+#undef GPIO_PORTB_AHB_CR_R
+#define GPIO_PORTB_AHB_CR_R         HWREG(0x40059524)
+#undef GPIO_PORTB_AHB_AMSEL_R
+#define GPIO_PORTB_AHB_AMSEL_R      HWREG(0x40059528)
+#undef GPIO_PORTB_AHB_PCTL_R
+#define GPIO_PORTB_AHB_PCTL_R       HWREG(0x4005952C)
+#undef GPIO_PORTB_AHB_ADCCTL_R
+#define GPIO_PORTB_AHB_ADCCTL_R     HWREG(0x40059530)
+#undef GPIO_PORTB_AHB_DMACTL_R
+#define GPIO_PORTB_AHB_DMACTL_R     HWREG(0x40059534)
+#undef GPIO_PORTC_AHB_DATA_R
+#define GPIO_PORTC_AHB_DATA_R       HWREG(0x4005A3FC)
+#undef GPIO_PORTC_AHB_DIR_R
+#define GPIO_PORTC_AHB_DIR_R        HWREG(0x4005A400)
+#undef GPIO_PORTC_AHB_IS_R
+#define GPIO_PORTC_AHB_IS_R         HWREG(0x4005A404)
+#undef GPIO_PORTC_AHB_IBE_R
+#define GPIO_PORTC_AHB_IBE_R        HWREG(0x4005A408)
+#undef GPIO_PORTC_AHB_IEV_R
+#define GPIO_PORTC_AHB_IEV_R        HWREG(0x4005A40C)
+#undef GPIO_PORTC_AHB_IM_R
+#define GPIO_PORTC_AHB_IM_R         HWREG(0x4005A410)
+#undef GPIO_PORTC_AHB_RIS_R
+#define GPIO_PORTC_AHB_RIS_R        HWREG(0x4005A414)
+#undef GPIO_PORTC_AHB_MIS_R
+#define GPIO_PORTC_AHB_MIS_R        HWREG(0x4005A418)
+#undef GPIO_PORTC_AHB_ICR_R
+#define GPIO_PORTC_AHB_ICR_R        HWREG(0x4005A41C)
+#undef GPIO_PORTC_AHB_AFSEL_R
+#define GPIO_PORTC_AHB_AFSEL_R      HWREG(0x4005A420)
+#undef GPIO_PORTC_AHB_DR2R_R
+#define GPIO_PORTC_AHB_DR2R_R       HWREG(0x4005A500)
+#undef GPIO_PORTC_AHB_DR4R_R
+#define GPIO_PORTC_AHB_DR4R_R       HWREG(0x4005A504)
+#undef GPIO_PORTC_AHB_DR8R_R
+#define GPIO_PORTC_AHB_DR8R_R       HWREG(0x4005A508)
+#undef GPIO_PORTC_AHB_ODR_R
+#define GPIO_PORTC_AHB_ODR_R        HWREG(0x4005A50C)
+#undef GPIO_PORTC_AHB_PUR_R
+#define GPIO_PORTC_AHB_PUR_R        HWREG(0x4005A510)
+#undef GPIO_PORTC_AHB_PDR_R
+#define GPIO_PORTC_AHB_PDR_R        HWREG(0x4005A514)
+#undef GPIO_PORTC_AHB_SLR_R
+#define GPIO_PORTC_AHB_SLR_R        HWREG(0x4005A518)
+#undef GPIO_PORTC_AHB_DEN_R
+#define GPIO_PORTC_AHB_DEN_R        HWREG(0x4005A51C)
+#undef GPIO_PORTC_AHB_LOCK_R
+#define GPIO_PORTC_AHB_LOCK_R       HWREG(0x4005A520)
+#undef GPIO_PORTC_AHB_CR_R
+#define GPIO_PORTC_AHB_CR_R         HWREG(0x4005A524)
+#undef GPIO_PORTC_AHB_AMSEL_R
+#define GPIO_PORTC_AHB_AMSEL_R      HWREG(0x4005A528)
+#undef GPIO_PORTC_AHB_PCTL_R
+#define GPIO_PORTC_AHB_PCTL_R       HWREG(0x4005A52C)
+#undef GPIO_PORTC_AHB_ADCCTL_R
+#define GPIO_PORTC_AHB_ADCCTL_R     HWREG(0x4005A530)
+#undef GPIO_PORTC_AHB_DMACTL_R
+#define GPIO_PORTC_AHB_DMACTL_R     HWREG(0x4005A534)
+#undef GPIO_PORTD_AHB_DATA_R
+#define GPIO_PORTD_AHB_DATA_R       HWREG(0x4005B3FC)
+#undef GPIO_PORTD_AHB_DIR_R
+#define GPIO_PORTD_AHB_DIR_R        HWREG(0x4005B400)
+#undef GPIO_PORTD_AHB_IS_R
+#define GPIO_PORTD_AHB_IS_R         HWREG(0x4005B404)
+#undef GPIO_PORTD_AHB_IBE_R
+#define GPIO_PORTD_AHB_IBE_R        HWREG(0x4005B408)
+#undef GPIO_PORTD_AHB_IEV_R
+#define GPIO_PORTD_AHB_IEV_R        HWREG(0x4005B40C)
+#undef GPIO_PORTD_AHB_IM_R
+#define GPIO_PORTD_AHB_IM_R         HWREG(0x4005B410)
+#undef GPIO_PORTD_AHB_RIS_R
+#define GPIO_PORTD_AHB_RIS_R        HWREG(0x4005B414)
+#undef GPIO_PORTD_AHB_MIS_R
+#define GPIO_PORTD_AHB_MIS_R        HWREG(0x4005B418)
+#undef GPIO_PORTD_AHB_ICR_R
+#define GPIO_PORTD_AHB_ICR_R        HWREG(0x4005B41C)
+#undef GPIO_PORTD_AHB_AFSEL_R
+#define GPIO_PORTD_AHB_AFSEL_R      HWREG(0x4005B420)
+#undef GPIO_PORTD_AHB_DR2R_R
+#define GPIO_PORTD_AHB_DR2R_R       HWREG(0x4005B500)
+#undef GPIO_PORTD_AHB_DR4R_R
+#define GPIO_PORTD_AHB_DR4R_R       HWREG(0x4005B504)
+#undef GPIO_PORTD_AHB_DR8R_R
+#define GPIO_PORTD_AHB_DR8R_R       HWREG(0x4005B508)
+#undef GPIO_PORTD_AHB_ODR_R
+#define GPIO_PORTD_AHB_ODR_R        HWREG(0x4005B50C)
+#undef GPIO_PORTD_AHB_PUR_R
+#define GPIO_PORTD_AHB_PUR_R        HWREG(0x4005B510)
+#undef GPIO_PORTD_AHB_PDR_R
+#define GPIO_PORTD_AHB_PDR_R        HWREG(0x4005B514)
+#undef GPIO_PORTD_AHB_SLR_R
+#define GPIO_PORTD_AHB_SLR_R        HWREG(0x4005B518)
+#undef GPIO_PORTD_AHB_DEN_R
+#define GPIO_PORTD_AHB_DEN_R        HWREG(0x4005B51C)
+#undef GPIO_PORTD_AHB_LOCK_R
+#define GPIO_PORTD_AHB_LOCK_R       HWREG(0x4005B520)
+#undef GPIO_PORTD_AHB_CR_R
+#define GPIO_PORTD_AHB_CR_R         HWREG(0x4005B524)
+#undef GPIO_PORTD_AHB_AMSEL_R
+#define GPIO_PORTD_AHB_AMSEL_R      HWREG(0x4005B528)
+#undef GPIO_PORTD_AHB_PCTL_R
+#define GPIO_PORTD_AHB_PCTL_R       HWREG(0x4005B52C)
+#undef GPIO_PORTD_AHB_ADCCTL_R
+#define GPIO_PORTD_AHB_ADCCTL_R     HWREG(0x4005B530)
+#undef GPIO_PORTD_AHB_DMACTL_R
+#define GPIO_PORTD_AHB_DMACTL_R     HWREG(0x4005B534)
+#undef GPIO_PORTE_AHB_DATA_R
+#define GPIO_PORTE_AHB_DATA_R       HWREG(0x4005C3FC)
+#undef GPIO_PORTE_AHB_DIR_R
+#define GPIO_PORTE_AHB_DIR_R        HWREG(0x4005C400)
+#undef GPIO_PORTE_AHB_IS_R
+#define GPIO_PORTE_AHB_IS_R         HWREG(0x4005C404)
+#undef GPIO_PORTE_AHB_IBE_R
+#define GPIO_PORTE_AHB_IBE_R        HWREG(0x4005C408)
+#undef GPIO_PORTE_AHB_IEV_R
+#define GPIO_PORTE_AHB_IEV_R        HWREG(0x4005C40C)
+#undef GPIO_PORTE_AHB_IM_R
+#define GPIO_PORTE_AHB_IM_R         HWREG(0x4005C410)
+#undef GPIO_PORTE_AHB_RIS_R
+#define GPIO_PORTE_AHB_RIS_R        HWREG(0x4005C414)
+#undef GPIO_PORTE_AHB_MIS_R
+#define GPIO_PORTE_AHB_MIS_R        HWREG(0x4005C418)
+#undef GPIO_PORTE_AHB_ICR_R
+#define GPIO_PORTE_AHB_ICR_R        HWREG(0x4005C41C)
+#undef GPIO_PORTE_AHB_AFSEL_R
+#define GPIO_PORTE_AHB_AFSEL_R      HWREG(0x4005C420)
+#undef GPIO_PORTE_AHB_DR2R_R
+#define GPIO_PORTE_AHB_DR2R_R       HWREG(0x4005C500)
+#undef GPIO_PORTE_AHB_DR4R_R
+#define GPIO_PORTE_AHB_DR4R_R       HWREG(0x4005C504)
+#undef GPIO_PORTE_AHB_DR8R_R
+#define GPIO_PORTE_AHB_DR8R_R       HWREG(0x4005C508)
+#undef GPIO_PORTE_AHB_ODR_R
+#define GPIO_PORTE_AHB_ODR_R        HWREG(0x4005C50C)
+#undef GPIO_PORTE_AHB_PUR_R
+#define GPIO_PORTE_AHB_PUR_R        HWREG(0x4005C510)
+#undef GPIO_PORTE_AHB_PDR_R
+#define GPIO_PORTE_AHB_PDR_R        HWREG(0x4005C514)
+#undef GPIO_PORTE_AHB_SLR_R
+#define GPIO_PORTE_AHB_SLR_R        HWREG(0x4005C518)
+#undef GPIO_PORTE_AHB_DEN_R
+#define GPIO_PORTE_AHB_DEN_R        HWREG(0x4005C51C)
+#undef GPIO_PORTE_AHB_LOCK_R
+#define GPIO_PORTE_AHB_LOCK_R       HWREG(0x4005C520)
+#undef GPIO_PORTE_AHB_CR_R
+#define GPIO_PORTE_AHB_CR_R         HWREG(0x4005C524)
+#undef GPIO_PORTE_AHB_AMSEL_R
+#define GPIO_PORTE_AHB_AMSEL_R      HWREG(0x4005C528)
+#undef GPIO_PORTE_AHB_PCTL_R
+#define GPIO_PORTE_AHB_PCTL_R       HWREG(0x4005C52C)
+#undef GPIO_PORTE_AHB_ADCCTL_R
+#define GPIO_PORTE_AHB_ADCCTL_R     HWREG(0x4005C530)
+#undef GPIO_PORTE_AHB_DMACTL_R
+#define GPIO_PORTE_AHB_DMACTL_R     HWREG(0x4005C534)
+#undef GPIO_PORTF_AHB_DATA_R
+#define GPIO_PORTF_AHB_DATA_R       HWREG(0x4005D3FC)
+#undef GPIO_PORTF_AHB_DIR_R
+#define GPIO_PORTF_AHB_DIR_R        HWREG(0x4005D400)
+#undef GPIO_PORTF_AHB_IS_R
+#define GPIO_PORTF_AHB_IS_R         HWREG(0x4005D404)
+#undef GPIO_PORTF_AHB_IBE_R
+#define GPIO_PORTF_AHB_IBE_R        HWREG(0x4005D408)
+#undef GPIO_PORTF_AHB_IEV_R
+#define GPIO_PORTF_AHB_IEV_R        HWREG(0x4005D40C)
+#undef GPIO_PORTF_AHB_IM_R
+#define GPIO_PORTF_AHB_IM_R         HWREG(0x4005D410)
+#undef GPIO_PORTF_AHB_RIS_R
+#define GPIO_PORTF_AHB_RIS_R        HWREG(0x4005D414)
+#undef GPIO_PORTF_AHB_MIS_R
+#define GPIO_PORTF_AHB_MIS_R        HWREG(0x4005D418)
+#undef GPIO_PORTF_AHB_ICR_R
+#define GPIO_PORTF_AHB_ICR_R        HWREG(0x4005D41C)
+#undef GPIO_PORTF_AHB_AFSEL_R
+#define GPIO_PORTF_AHB_AFSEL_R      HWREG(0x4005D420)
+#undef GPIO_PORTF_AHB_DR2R_R
+#define GPIO_PORTF_AHB_DR2R_R       HWREG(0x4005D500)
+#undef GPIO_PORTF_AHB_DR4R_R
+#define GPIO_PORTF_AHB_DR4R_R       HWREG(0x4005D504)
+#undef GPIO_PORTF_AHB_DR8R_R
+#define GPIO_PORTF_AHB_DR8R_R       HWREG(0x4005D508)
+#undef GPIO_PORTF_AHB_ODR_R
+#define GPIO_PORTF_AHB_ODR_R        HWREG(0x4005D50C)
+#undef GPIO_PORTF_AHB_PUR_R
+#define GPIO_PORTF_AHB_PUR_R        HWREG(0x4005D510)
+#undef GPIO_PORTF_AHB_PDR_R
+#define GPIO_PORTF_AHB_PDR_R        HWREG(0x4005D514)
+#undef GPIO_PORTF_AHB_SLR_R
+#define GPIO_PORTF_AHB_SLR_R        HWREG(0x4005D518)
+#undef GPIO_PORTF_AHB_DEN_R
+#define GPIO_PORTF_AHB_DEN_R        HWREG(0x4005D51C)
+#undef GPIO_PORTF_AHB_LOCK_R
+#define GPIO_PORTF_AHB_LOCK_R       HWREG(0x4005D520)
+#undef GPIO_PORTF_AHB_CR_R
+#define GPIO_PORTF_AHB_CR_R         HWREG(0x4005D524)
+#undef GPIO_PORTF_AHB_AMSEL_R
+#define GPIO_PORTF_AHB_AMSEL_R      HWREG(0x4005D528)
+#undef GPIO_PORTF_AHB_PCTL_R
+#define GPIO_PORTF_AHB_PCTL_R       HWREG(0x4005D52C)
+#undef GPIO_PORTF_AHB_ADCCTL_R
+#define GPIO_PORTF_AHB_ADCCTL_R     HWREG(0x4005D530)
+#undef GPIO_PORTF_AHB_DMACTL_R
+#define GPIO_PORTF_AHB_DMACTL_R     HWREG(0x4005D534)
+#undef SYSCTL_DID0_R
+#define SYSCTL_DID0_R               HWREG(0x400FE000)
+#undef SYSCTL_DID1_R
+#define SYSCTL_DID1_R               HWREG(0x400FE004)
+#undef SYSCTL_DC0_R
+#define SYSCTL_DC0_R                HWREG(0x400FE008)
+#undef SYSCTL_DC1_R
+#define SYSCTL_DC1_R                HWREG(0x400FE010)
+#undef SYSCTL_DC2_R
+#define SYSCTL_DC2_R                HWREG(0x400FE014)
+#undef SYSCTL_DC3_R
+#define SYSCTL_DC3_R                HWREG(0x400FE018)
+#undef SYSCTL_DC4_R
+#define SYSCTL_DC4_R                HWREG(0x400FE01C)
+#undef SYSCTL_DC5_R
+#define SYSCTL_DC5_R                HWREG(0x400FE020)
+#undef SYSCTL_DC6_R
+#define SYSCTL_DC6_R                HWREG(0x400FE024)
+#undef SYSCTL_DC7_R
+#define SYSCTL_DC7_R                HWREG(0x400FE028)
+#undef SYSCTL_DC8_R
+#define SYSCTL_DC8_R                HWREG(0x400FE02C)
+#undef SYSCTL_PBORCTL_R
+#define SYSCTL_PBORCTL_R            HWREG(0x400FE030)
+#undef SYSCTL_SRCR0_R
+#define SYSCTL_SRCR0_R              HWREG(0x400FE040)
+#undef SYSCTL_SRCR1_R
+#define SYSCTL_SRCR1_R              HWREG(0x400FE044)
+#undef SYSCTL_SRCR2_R
+#define SYSCTL_SRCR2_R              HWREG(0x400FE048)
+#undef SYSCTL_RIS_R
+#define SYSCTL_RIS_R                HWREG(0x400FE050)
+#undef SYSCTL_IMC_R
+#define SYSCTL_IMC_R                HWREG(0x400FE054)
+#undef SYSCTL_MISC_R
+#define SYSCTL_MISC_R               HWREG(0x400FE058)
+#undef SYSCTL_RESC_R
+#define SYSCTL_RESC_R               HWREG(0x400FE05C)
+#undef SYSCTL_RCC_R
+#define SYSCTL_RCC_R                HWREG(0x400FE060)
+#undef SYSCTL_GPIOHBCTL_R
+#define SYSCTL_GPIOHBCTL_R          HWREG(0x400FE06C)
+#undef SYSCTL_RCC2_R
+#define SYSCTL_RCC2_R               HWREG(0x400FE070)
+#undef SYSCTL_MOSCCTL_R
+#define SYSCTL_MOSCCTL_R            HWREG(0x400FE07C)
+#undef SYSCTL_RCGC0_R
+#define SYSCTL_RCGC0_R              HWREG(0x400FE100)
+#undef SYSCTL_RCGC1_R
+#define SYSCTL_RCGC1_R              HWREG(0x400FE104)
+#undef SYSCTL_RCGC2_R
+#define SYSCTL_RCGC2_R              HWREG(0x400FE108)
+#undef SYSCTL_SCGC0_R
+#define SYSCTL_SCGC0_R              HWREG(0x400FE110)
+#undef SYSCTL_SCGC1_R
+#define SYSCTL_SCGC1_R              HWREG(0x400FE114)
+#undef SYSCTL_SCGC2_R
+#define SYSCTL_SCGC2_R              HWREG(0x400FE118)
+#undef SYSCTL_DCGC0_R
+#define SYSCTL_DCGC0_R              HWREG(0x400FE120)
+#undef SYSCTL_DCGC1_R
+#define SYSCTL_DCGC1_R              HWREG(0x400FE124)
+#undef SYSCTL_DCGC2_R
+#define SYSCTL_DCGC2_R              HWREG(0x400FE128)
+#undef SYSCTL_DSLPCLKCFG_R
+#define SYSCTL_DSLPCLKCFG_R         HWREG(0x400FE144)
+#undef SYSCTL_SYSPROP_R
+#define SYSCTL_SYSPROP_R            HWREG(0x400FE14C)
+#undef SYSCTL_PIOSCCAL_R
+#define SYSCTL_PIOSCCAL_R           HWREG(0x400FE150)
+#undef SYSCTL_PIOSCSTAT_R
+#define SYSCTL_PIOSCSTAT_R          HWREG(0x400FE154)
+#undef SYSCTL_PLLFREQ0_R
+#define SYSCTL_PLLFREQ0_R           HWREG(0x400FE160)
+#undef SYSCTL_PLLFREQ1_R
+#define SYSCTL_PLLFREQ1_R           HWREG(0x400FE164)
+#undef SYSCTL_PLLSTAT_R
+#define SYSCTL_PLLSTAT_R            HWREG(0x400FE168)
+#undef SYSCTL_DC9_R
+#define SYSCTL_DC9_R                HWREG(0x400FE190)
+#undef SYSCTL_NVMSTAT_R
+#define SYSCTL_NVMSTAT_R            HWREG(0x400FE1A0)
+#undef SYSCTL_PPWD_R
+#define SYSCTL_PPWD_R               HWREG(0x400FE300)
+#undef SYSCTL_PPTIMER_R
+#define SYSCTL_PPTIMER_R            HWREG(0x400FE304)
+#undef SYSCTL_PPGPIO_R
+#define SYSCTL_PPGPIO_R             HWREG(0x400FE308)
+#undef SYSCTL_PPDMA_R
+#define SYSCTL_PPDMA_R              HWREG(0x400FE30C)
+#undef SYSCTL_PPHIB_R
+#define SYSCTL_PPHIB_R              HWREG(0x400FE314)
+#undef SYSCTL_PPUART_R
+#define SYSCTL_PPUART_R             HWREG(0x400FE318)
+#undef SYSCTL_PPSSI_R
+#define SYSCTL_PPSSI_R              HWREG(0x400FE31C)
+#undef SYSCTL_PPI2C_R
+#define SYSCTL_PPI2C_R              HWREG(0x400FE320)
+#undef SYSCTL_PPUSB_R
+#define SYSCTL_PPUSB_R              HWREG(0x400FE328)
+#undef SYSCTL_PPCAN_R
+#define SYSCTL_PPCAN_R              HWREG(0x400FE334)
+#undef SYSCTL_PPADC_R
+#define SYSCTL_PPADC_R              HWREG(0x400FE338)
+#undef SYSCTL_PPACMP_R
+#define SYSCTL_PPACMP_R             HWREG(0x400FE33C)
+#undef SYSCTL_PPPWM_R
+#define SYSCTL_PPPWM_R              HWREG(0x400FE340)
+#undef SYSCTL_PPQEI_R
+#define SYSCTL_PPQEI_R              HWREG(0x400FE344)
+#undef SYSCTL_PPEEPROM_R
+#define SYSCTL_PPEEPROM_R           HWREG(0x400FE358)
+#undef SYSCTL_PPWTIMER_R
+#define SYSCTL_PPWTIMER_R           HWREG(0x400FE35C)
+#undef SYSCTL_SRWD_R
+#define SYSCTL_SRWD_R               HWREG(0x400FE500)
+#undef SYSCTL_SRTIMER_R
+#define SYSCTL_SRTIMER_R            HWREG(0x400FE504)
+#undef SYSCTL_SRGPIO_R
+#define SYSCTL_SRGPIO_R             HWREG(0x400FE508)
+#undef SYSCTL_SRDMA_R
+#define SYSCTL_SRDMA_R              HWREG(0x400FE50C)
+#undef SYSCTL_SRHIB_R
+#define SYSCTL_SRHIB_R              HWREG(0x400FE514)
+#undef SYSCTL_SRUART_R
+#define SYSCTL_SRUART_R             HWREG(0x400FE518)
+#undef SYSCTL_SRSSI_R
+#define SYSCTL_SRSSI_R              HWREG(0x400FE51C)
+#undef SYSCTL_SRI2C_R
+#define SYSCTL_SRI2C_R              HWREG(0x400FE520)
+#undef SYSCTL_SRUSB_R
+#define SYSCTL_SRUSB_R              HWREG(0x400FE528)
+#undef SYSCTL_SRCAN_R
+#define SYSCTL_SRCAN_R              HWREG(0x400FE534)
+#undef SYSCTL_SRADC_R
+#define SYSCTL_SRADC_R              HWREG(0x400FE538)
+#undef SYSCTL_SRACMP_R
+#define SYSCTL_SRACMP_R             HWREG(0x400FE53C)
+#undef SYSCTL_SRPWM_R
+#define SYSCTL_SRPWM_R              HWREG(0x400FE540)
+#undef SYSCTL_SRQEI_R
+#define SYSCTL_SRQEI_R              HWREG(0x400FE544)
+#undef SYSCTL_SREEPROM_R
+#define SYSCTL_SREEPROM_R           HWREG(0x400FE558)
+#undef SYSCTL_SRWTIMER_R
+#define SYSCTL_SRWTIMER_R           HWREG(0x400FE55C)
+#undef SYSCTL_RCGCWD_R
+#define SYSCTL_RCGCWD_R             HWREG(0x400FE600)
+#undef SYSCTL_RCGCTIMER_R
+#define SYSCTL_RCGCTIMER_R          HWREG(0x400FE604)
+#undef SYSCTL_RCGCGPIO_R
+#define SYSCTL_RCGCGPIO_R           HWREG(0x400FE608)
+#undef SYSCTL_RCGCDMA_R
+#define SYSCTL_RCGCDMA_R            HWREG(0x400FE60C)
+#undef SYSCTL_RCGCHIB_R
+#define SYSCTL_RCGCHIB_R            HWREG(0x400FE614)
+#undef SYSCTL_RCGCUART_R
+#define SYSCTL_RCGCUART_R           HWREG(0x400FE618)
+#undef SYSCTL_RCGCSSI_R
+#define SYSCTL_RCGCSSI_R            HWREG(0x400FE61C)
+#undef SYSCTL_RCGCI2C_R
+#define SYSCTL_RCGCI2C_R            HWREG(0x400FE620)
+#undef SYSCTL_RCGCUSB_R
+#define SYSCTL_RCGCUSB_R            HWREG(0x400FE628)
+#undef SYSCTL_RCGCCAN_R
+#define SYSCTL_RCGCCAN_R            HWREG(0x400FE634)
+#undef SYSCTL_RCGCADC_R
+#define SYSCTL_RCGCADC_R            HWREG(0x400FE638)
+#undef SYSCTL_RCGCACMP_R
+#define SYSCTL_RCGCACMP_R           HWREG(0x400FE63C)
+#undef SYSCTL_RCGCPWM_R
+#define SYSCTL_RCGCPWM_R            HWREG(0x400FE640)
+#undef SYSCTL_RCGCQEI_R
+#define SYSCTL_RCGCQEI_R            HWREG(0x400FE644)
+#undef SYSCTL_RCGCEEPROM_R
+#define SYSCTL_RCGCEEPROM_R         HWREG(0x400FE658)
+#undef SYSCTL_RCGCWTIMER_R
+#define SYSCTL_RCGCWTIMER_R         HWREG(0x400FE65C)
+#undef SYSCTL_SCGCWD_R
+#define SYSCTL_SCGCWD_R             HWREG(0x400FE700)
+#undef SYSCTL_SCGCTIMER_R
+#define SYSCTL_SCGCTIMER_R          HWREG(0x400FE704)
+#undef SYSCTL_SCGCGPIO_R
+#define SYSCTL_SCGCGPIO_R           HWREG(0x400FE708)
+#undef SYSCTL_SCGCDMA_R
+#define SYSCTL_SCGCDMA_R            HWREG(0x400FE70C)
+#undef SYSCTL_SCGCHIB_R
+#define SYSCTL_SCGCHIB_R            HWREG(0x400FE714)
+#undef SYSCTL_SCGCUART_R
+#define SYSCTL_SCGCUART_R           HWREG(0x400FE718)
+#undef SYSCTL_SCGCSSI_R
+#define SYSCTL_SCGCSSI_R            HWREG(0x400FE71C)
+#undef SYSCTL_SCGCI2C_R
+#define SYSCTL_SCGCI2C_R            HWREG(0x400FE720)
+#undef SYSCTL_SCGCUSB_R
+#define SYSCTL_SCGCUSB_R            HWREG(0x400FE728)
+#undef SYSCTL_SCGCCAN_R
+#define SYSCTL_SCGCCAN_R            HWREG(0x400FE734)
+#undef SYSCTL_SCGCADC_R
+#define SYSCTL_SCGCADC_R            HWREG(0x400FE738)
+#undef SYSCTL_SCGCACMP_R
+#define SYSCTL_SCGCACMP_R           HWREG(0x400FE73C)
+#undef SYSCTL_SCGCPWM_R
+#define SYSCTL_SCGCPWM_R            HWREG(0x400FE740)
+#undef SYSCTL_SCGCQEI_R
+#define SYSCTL_SCGCQEI_R            HWREG(0x400FE744)
+#undef SYSCTL_SCGCEEPROM_R
+#define SYSCTL_SCGCEEPROM_R         HWREG(0x400FE758)
+#undef SYSCTL_SCGCWTIMER_R
+#define SYSCTL_SCGCWTIMER_R         HWREG(0x400FE75C)
+#undef SYSCTL_DCGCWD_R
+#define SYSCTL_DCGCWD_R             HWREG(0x400FE800)
+#undef SYSCTL_DCGCTIMER_R
+#define SYSCTL_DCGCTIMER_R          HWREG(0x400FE804)
+#undef SYSCTL_DCGCGPIO_R
+#define SYSCTL_DCGCGPIO_R           HWREG(0x400FE808)
+#undef SYSCTL_DCGCDMA_R
+#define SYSCTL_DCGCDMA_R            HWREG(0x400FE80C)
+#undef SYSCTL_DCGCHIB_R
+#define SYSCTL_DCGCHIB_R            HWREG(0x400FE814)
+#undef SYSCTL_DCGCUART_R
+#define SYSCTL_DCGCUART_R           HWREG(0x400FE818)
+#undef SYSCTL_DCGCSSI_R
+#define SYSCTL_DCGCSSI_R            HWREG(0x400FE81C)
+#undef SYSCTL_DCGCI2C_R
+#define SYSCTL_DCGCI2C_R            HWREG(0x400FE820)
+#undef SYSCTL_DCGCUSB_R
+#define SYSCTL_DCGCUSB_R            HWREG(0x400FE828)
+#undef SYSCTL_DCGCCAN_R
+#define SYSCTL_DCGCCAN_R            HWREG(0x400FE834)
+#undef SYSCTL_DCGCADC_R
+#define SYSCTL_DCGCADC_R            HWREG(0x400FE838)
+#undef SYSCTL_DCGCACMP_R
+#define SYSCTL_DCGCACMP_R           HWREG(0x400FE83C)
+#undef SYSCTL_DCGCPWM_R
+#define SYSCTL_DCGCPWM_R            HWREG(0x400FE840)
+#undef SYSCTL_DCGCQEI_R
+#define SYSCTL_DCGCQEI_R            HWREG(0x400FE844)
+#undef SYSCTL_DCGCEEPROM_R
+#define SYSCTL_DCGCEEPROM_R         HWREG(0x400FE858)
+#undef SYSCTL_DCGCWTIMER_R
+#define SYSCTL_DCGCWTIMER_R         HWREG(0x400FE85C)
+#undef SYSCTL_PRWD_R
+#define SYSCTL_PRWD_R               HWREG(0x400FEA00)
+#undef SYSCTL_PRTIMER_R
+#define SYSCTL_PRTIMER_R            HWREG(0x400FEA04)
+#undef SYSCTL_PRGPIO_R
+#define SYSCTL_PRGPIO_R             HWREG(0x400FEA08)
+#undef SYSCTL_PRDMA_R
+#define SYSCTL_PRDMA_R              HWREG(0x400FEA0C)
+#undef SYSCTL_PRHIB_R
+#define SYSCTL_PRHIB_R              HWREG(0x400FEA14)
+#undef SYSCTL_PRUART_R
+#define SYSCTL_PRUART_R             HWREG(0x400FEA18)
+#undef SYSCTL_PRSSI_R
+#define SYSCTL_PRSSI_R              HWREG(0x400FEA1C)
+#undef SYSCTL_PRI2C_R
+#define SYSCTL_PRI2C_R              HWREG(0x400FEA20)
+#undef SYSCTL_PRUSB_R
+#define SYSCTL_PRUSB_R              HWREG(0x400FEA28)
+#undef SYSCTL_PRCAN_R
+#define SYSCTL_PRCAN_R              HWREG(0x400FEA34)
+#undef SYSCTL_PRADC_R
+#define SYSCTL_PRADC_R              HWREG(0x400FEA38)
+#undef SYSCTL_PRACMP_R
+#define SYSCTL_PRACMP_R             HWREG(0x400FEA3C)
+#undef SYSCTL_PRPWM_R
+#define SYSCTL_PRPWM_R              HWREG(0x400FEA40)
+#undef SYSCTL_PRQEI_R
+#define SYSCTL_PRQEI_R              HWREG(0x400FEA44)
+#undef SYSCTL_PREEPROM_R
+#define SYSCTL_PREEPROM_R           HWREG(0x400FEA58)
+#undef SYSCTL_PRWTIMER_R
+#define SYSCTL_PRWTIMER_R           HWREG(0x400FEA5C)
+#undef NVIC_ACTLR_R
+#define NVIC_ACTLR_R                HWREG(0xE000E008)
+#undef NVIC_ST_CTRL_R
+#define NVIC_ST_CTRL_R              HWREG(0xE000E010)
+#undef NVIC_ST_RELOAD_R
+#define NVIC_ST_RELOAD_R            HWREG(0xE000E014)
+#undef NVIC_ST_CURRENT_R
+#define NVIC_ST_CURRENT_R           HWREG(0xE000E018)
+#undef NVIC_EN0_R
+#define NVIC_EN0_R                  HWREG(0xE000E100)
+#undef NVIC_EN1_R
+#define NVIC_EN1_R                  HWREG(0xE000E104)
+#undef NVIC_EN2_R
+#define NVIC_EN2_R                  HWREG(0xE000E108)
+#undef NVIC_EN3_R
+#define NVIC_EN3_R                  HWREG(0xE000E10C)
+#undef NVIC_EN4_R
+#define NVIC_EN4_R                  HWREG(0xE000E110)
+#undef NVIC_DIS0_R
+#define NVIC_DIS0_R                 HWREG(0xE000E180)
+#undef NVIC_DIS1_R
+#define NVIC_DIS1_R                 HWREG(0xE000E184)
+#undef NVIC_DIS2_R
+#define NVIC_DIS2_R                 HWREG(0xE000E188)
+#undef NVIC_DIS3_R
+#define NVIC_DIS3_R                 HWREG(0xE000E18C)
+#undef NVIC_DIS4_R
+#define NVIC_DIS4_R                 HWREG(0xE000E190)
+#undef NVIC_PEND0_R
+#define NVIC_PEND0_R                HWREG(0xE000E200)
+#undef NVIC_PEND1_R
+#define NVIC_PEND1_R                HWREG(0xE000E204)
+#undef NVIC_PEND2_R
+#define NVIC_PEND2_R                HWREG(0xE000E208)
+#undef NVIC_PEND3_R
+#define NVIC_PEND3_R                HWREG(0xE000E20C)
+#undef NVIC_PEND4_R
+#define NVIC_PEND4_R                HWREG(0xE000E210)
+#undef NVIC_UNPEND0_R
+#define NVIC_UNPEND0_R              HWREG(0xE000E280)
+#undef NVIC_UNPEND1_R
+#define NVIC_UNPEND1_R              HWREG(0xE000E284)
+#undef NVIC_UNPEND2_R
+#define NVIC_UNPEND2_R              HWREG(0xE000E288)
+#undef NVIC_UNPEND3_R
+#define NVIC_UNPEND3_R              HWREG(0xE000E28C)
+#undef NVIC_UNPEND4_R
+#define NVIC_UNPEND4_R              HWREG(0xE000E290)
+#undef NVIC_ACTIVE0_R
+#define NVIC_ACTIVE0_R              HWREG(0xE000E300)
+#undef NVIC_ACTIVE1_R
+#define NVIC_ACTIVE1_R              HWREG(0xE000E304)
+#undef NVIC_ACTIVE2_R
+#define NVIC_ACTIVE2_R              HWREG(0xE000E308)
+#undef NVIC_ACTIVE3_R
+#define NVIC_ACTIVE3_R              HWREG(0xE000E30C)
+#undef NVIC_ACTIVE4_R
+#define NVIC_ACTIVE4_R              HWREG(0xE000E310)
+#undef NVIC_PRI0_R
+#define NVIC_PRI0_R                 HWREG(0xE000E400)
+#undef NVIC_PRI1_R
+#define NVIC_PRI1_R                 HWREG(0xE000E404)
+#undef NVIC_PRI2_R
+#define NVIC_PRI2_R                 HWREG(0xE000E408)
+#undef NVIC_PRI3_R
+#define NVIC_PRI3_R                 HWREG(0xE000E40C)
+#undef NVIC_PRI4_R
+#define NVIC_PRI4_R                 HWREG(0xE000E410)
+#undef NVIC_PRI5_R
+#define NVIC_PRI5_R                 HWREG(0xE000E414)
+#undef NVIC_PRI6_R
+#define NVIC_PRI6_R                 HWREG(0xE000E418)
+#undef NVIC_PRI7_R
+#define NVIC_PRI7_R                 HWREG(0xE000E41C)
+#undef NVIC_PRI8_R
+#define NVIC_PRI8_R                 HWREG(0xE000E420)
+#undef NVIC_PRI9_R
+#define NVIC_PRI9_R                 HWREG(0xE000E424)
+#undef NVIC_PRI10_R
+#define NVIC_PRI10_R                HWREG(0xE000E428)
+#undef NVIC_PRI11_R
+#define NVIC_PRI11_R                HWREG(0xE000E42C)
+#undef NVIC_PRI12_R
+#define NVIC_PRI12_R                HWREG(0xE000E430)
+#undef NVIC_PRI13_R
+#define NVIC_PRI13_R                HWREG(0xE000E434)
+#undef NVIC_PRI14_R
+#define NVIC_PRI14_R                HWREG(0xE000E438)
+#undef NVIC_PRI15_R
+#define NVIC_PRI15_R                HWREG(0xE000E43C)
+#undef NVIC_PRI16_R
+#define NVIC_PRI16_R                HWREG(0xE000E440)
+#undef NVIC_PRI17_R
+#define NVIC_PRI17_R                HWREG(0xE000E444)
+#undef NVIC_PRI18_R
+#define NVIC_PRI18_R                HWREG(0xE000E448)
+#undef NVIC_PRI19_R
+#define NVIC_PRI19_R                HWREG(0xE000E44C)
+#undef NVIC_PRI20_R
+#define NVIC_PRI20_R                HWREG(0xE000E450)
+#undef NVIC_PRI21_R
+#define NVIC_PRI21_R                HWREG(0xE000E454)
+#undef NVIC_PRI22_R
+#define NVIC_PRI22_R                HWREG(0xE000E458)
+#undef NVIC_PRI23_R
+#define NVIC_PRI23_R                HWREG(0xE000E45C)
+#undef NVIC_PRI24_R
+#define NVIC_PRI24_R                HWREG(0xE000E460)
+#undef NVIC_PRI25_R
+#define NVIC_PRI25_R                HWREG(0xE000E464)
+#undef NVIC_PRI26_R
+#define NVIC_PRI26_R                HWREG(0xE000E468)
+#undef NVIC_PRI27_R
+#define NVIC_PRI27_R                HWREG(0xE000E46C)
+#undef NVIC_PRI28_R
+#define NVIC_PRI28_R                HWREG(0xE000E470)
+#undef NVIC_PRI29_R
+#define NVIC_PRI29_R                HWREG(0xE000E474)
+#undef NVIC_PRI30_R
+#define NVIC_PRI30_R                HWREG(0xE000E478)
+#undef NVIC_PRI31_R
+#define NVIC_PRI31_R                HWREG(0xE000E47C)
+#undef NVIC_PRI32_R
+#define NVIC_PRI32_R                HWREG(0xE000E480)
+#undef NVIC_PRI33_R
+#define NVIC_PRI33_R                HWREG(0xE000E484)
+#undef NVIC_PRI34_R
+#define NVIC_PRI34_R                HWREG(0xE000E488)
+#undef NVIC_CPUID_R
+#define NVIC_CPUID_R                HWREG(0xE000ED00)
+#undef NVIC_INT_CTRL_R
+#define NVIC_INT_CTRL_R             HWREG(0xE000ED04)
+#undef NVIC_VTABLE_R
+#define NVIC_VTABLE_R               HWREG(0xE000ED08)
+#undef NVIC_APINT_R
+#define NVIC_APINT_R                HWREG(0xE000ED0C)
+#undef NVIC_SYS_CTRL_R
+#define NVIC_SYS_CTRL_R             HWREG(0xE000ED10)
+#undef NVIC_CFG_CTRL_R
+#define NVIC_CFG_CTRL_R             HWREG(0xE000ED14)
+#undef NVIC_SYS_PRI1_R
+#define NVIC_SYS_PRI1_R             HWREG(0xE000ED18)
+#undef NVIC_SYS_PRI2_R
+#define NVIC_SYS_PRI2_R             HWREG(0xE000ED1C)
+#undef NVIC_SYS_PRI3_R
+#define NVIC_SYS_PRI3_R             HWREG(0xE000ED20)
+#undef NVIC_SYS_HND_CTRL_R
+#define NVIC_SYS_HND_CTRL_R         HWREG(0xE000ED24)
+#undef NVIC_FAULT_STAT_R
+#define NVIC_FAULT_STAT_R           HWREG(0xE000ED28)
+#undef NVIC_HFAULT_STAT_R
+#define NVIC_HFAULT_STAT_R          HWREG(0xE000ED2C)
+#undef NVIC_DEBUG_STAT_R
+#define NVIC_DEBUG_STAT_R           HWREG(0xE000ED30)
+#undef NVIC_MM_ADDR_R
+#define NVIC_MM_ADDR_R              HWREG(0xE000ED34)
+#undef NVIC_FAULT_ADDR_R
+#define NVIC_FAULT_ADDR_R           HWREG(0xE000ED38)
+#undef NVIC_CPAC_R
+#define NVIC_CPAC_R                 HWREG(0xE000ED88)
+#undef NVIC_MPU_TYPE_R
+#define NVIC_MPU_TYPE_R             HWREG(0xE000ED90)
+#undef NVIC_MPU_CTRL_R
+#define NVIC_MPU_CTRL_R             HWREG(0xE000ED94)
+#undef NVIC_MPU_NUMBER_R
+#define NVIC_MPU_NUMBER_R           HWREG(0xE000ED98)
+#undef NVIC_MPU_BASE_R
+#define NVIC_MPU_BASE_R             HWREG(0xE000ED9C)
+#undef NVIC_MPU_ATTR_R
+#define NVIC_MPU_ATTR_R             HWREG(0xE000EDA0)
+#undef NVIC_MPU_BASE1_R
+#define NVIC_MPU_BASE1_R            HWREG(0xE000EDA4)
+#undef NVIC_MPU_ATTR1_R
+#define NVIC_MPU_ATTR1_R            HWREG(0xE000EDA8)
+#undef NVIC_MPU_BASE2_R
+#define NVIC_MPU_BASE2_R            HWREG(0xE000EDAC)
+#undef NVIC_MPU_ATTR2_R
+#define NVIC_MPU_ATTR2_R            HWREG(0xE000EDB0)
+#undef NVIC_MPU_BASE3_R
+#define NVIC_MPU_BASE3_R            HWREG(0xE000EDB4)
+#undef NVIC_MPU_ATTR3_R
+#define NVIC_MPU_ATTR3_R            HWREG(0xE000EDB8)
+#undef NVIC_DBG_CTRL_R
+#define NVIC_DBG_CTRL_R             HWREG(0xE000EDF0)
+#undef NVIC_DBG_XFER_R
+#define NVIC_DBG_XFER_R             HWREG(0xE000EDF4)
+#undef NVIC_DBG_DATA_R
+#define NVIC_DBG_DATA_R             HWREG(0xE000EDF8)
+#undef NVIC_DBG_INT_R
+#define NVIC_DBG_INT_R              HWREG(0xE000EDFC)
+#undef NVIC_SW_TRIG_R
+#define NVIC_SW_TRIG_R              HWREG(0xE000EF00)
+#undef NVIC_FPCC_R
+#define NVIC_FPCC_R                 HWREG(0xE000EF34)
+#undef NVIC_FPCA_R
+#define NVIC_FPCA_R                 HWREG(0xE000EF38)
+#undef NVIC_FPDSC_R
+#define NVIC_FPDSC_R                HWREG(0xE000EF3C)
+
+#endif /* SIM_TM4C123GH6PM_H_ */
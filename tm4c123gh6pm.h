@@ -12710,4 +12710,13 @@
                                             // (RM) mode
 #define NVIC_FPDSC_RMODE_RZ     0x00C00000  // Round towards Zero (RZ) mode
 
+//*****************************************************************************
+//
+// Host simulation: route the register macros above through HWREG().
+//
+//*****************************************************************************
+#ifdef HOST_SIM
+#include "sim_tm4c123gh6pm.h"
+#endif
+
 #endif // __TM4C123GH6PM_H__
@@ -0,0 +1,85 @@
+/*
+ * uDMA.cpp
+ *
+ *  Minimal driver for the TM4C123 micro-DMA controller.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hw_memmap.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "uDMA.h"
+
+// 32 primary structures followed by 32 alternate structures. The
+// controller requires the table to sit on a 1024-byte boundary.
+#if defined(ccs)
+#pragma DATA_ALIGN(uDMAControlTable, 1024)
+static uDMAControl uDMAControlTable[2*UDMA_NUM_CHANNELS];
+#else
+static uDMAControl uDMAControlTable[2*UDMA_NUM_CHANNELS]
+    __attribute__((aligned(1024)));
+#endif
+
+void uDMA_Init(void){
+  if(HWREG(UDMA_BASE + UDMA_O_CFG) & UDMA_CFG_MASTEN){
+    return;                             // already running
+  }
+  HWREG(SYSCTL_RCGCDMA) |= SYSCTL_RCGCDMA_R0;
+  while((HWREG(SYSCTL_PRDMA) & SYSCTL_PRDMA_R0) == 0);
+  HWREG(UDMA_BASE + UDMA_O_CFG) = UDMA_CFG_MASTEN;
+  HWREG(UDMA_BASE + UDMA_O_CTLBASE) = uDMA_Addr(uDMAControlTable);
+}
+
+uDMAControl *uDMA_Primary(uint32_t channel){
+  return &uDMAControlTable[channel];
+}
+
+uDMAControl *uDMA_Alternate(uint32_t channel){
+  return &uDMAControlTable[UDMA_NUM_CHANNELS + channel];
+}
+
+void uDMA_ChannelAssign(uint32_t channel, uint32_t encoding){
+  uint32_t reg = UDMA_BASE + UDMA_O_CHMAP0 + ((channel / 8) * 4);
+  uint32_t shift = (channel % 8) * 4;
+  HWREG(reg) = (HWREG(reg) & ~(0xF << shift)) | (encoding << shift);
+}
+
+void uDMA_ChannelReset(uint32_t channel){
+  uint32_t bit = 1 << channel;
+  HWREG(UDMA_BASE + UDMA_O_ENACLR) = bit;
+  HWREG(UDMA_BASE + UDMA_O_ALTCLR) = bit;
+  HWREG(UDMA_BASE + UDMA_O_PRIOCLR) = bit;
+  HWREG(UDMA_BASE + UDMA_O_REQMASKCLR) = bit;
+  HWREG(UDMA_BASE + UDMA_O_USEBURSTCLR) = bit;
+}
+
+void uDMA_ChannelEnable(uint32_t channel){
+  HWREG(UDMA_BASE + UDMA_O_ENASET) = 1 << channel;
+}
+
+void uDMA_ChannelDisable(uint32_t channel){
+  HWREG(UDMA_BASE + UDMA_O_ENACLR) = 1 << channel;
+}
+
+bool uDMA_ChannelIsEnabled(uint32_t channel){
+  return (HWREG(UDMA_BASE + UDMA_O_ENASET) & (1 << channel)) != 0;
+}
+
+void uDMA_UseBurst(uint32_t channel, bool burstOnly){
+  HWREG(UDMA_BASE + (burstOnly ? UDMA_O_USEBURSTSET : UDMA_O_USEBURSTCLR)) =
+      1 << channel;
+}
+
+void uDMA_RequestMask(uint32_t channel, bool masked){
+  HWREG(UDMA_BASE + (masked ? UDMA_O_REQMASKSET : UDMA_O_REQMASKCLR)) =
+      1 << channel;
+}
+
+void uDMA_SelectAlt(uint32_t channel, bool alt){
+  HWREG(UDMA_BASE + (alt ? UDMA_O_ALTSET : UDMA_O_ALTCLR)) = 1 << channel;
+}
+
+bool uDMA_AltActive(uint32_t channel){
+  return (HWREG(UDMA_BASE + UDMA_O_ALTSET) & (1 << channel)) != 0;
+}
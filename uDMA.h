@@ -0,0 +1,153 @@
+/*
+ * uDMA.h
+ *
+ *  Minimal driver for the TM4C123 micro-DMA controller: the channel
+ *  control table plus the handful of channel attribute registers the
+ *  UART transports need.
+ */
+
+#ifndef UDMA_H_
+#define UDMA_H_
+
+#include <stdint.h>
+#ifdef HOST_SIM
+#include "sim_regs.h"
+#endif
+
+// uDMA register offsets from UDMA_BASE
+#define UDMA_O_STAT             0x00000000  // DMA Status
+#define UDMA_O_CFG              0x00000004  // DMA Configuration
+#define UDMA_O_CTLBASE          0x00000008  // DMA Channel Control Base Pointer
+#define UDMA_O_ALTBASE          0x0000000C  // DMA Alternate Control Base Pointer
+#define UDMA_O_USEBURSTSET      0x00000018  // DMA Channel Useburst Set
+#define UDMA_O_USEBURSTCLR      0x0000001C  // DMA Channel Useburst Clear
+#define UDMA_O_REQMASKSET       0x00000020  // DMA Channel Request Mask Set
+#define UDMA_O_REQMASKCLR       0x00000024  // DMA Channel Request Mask Clear
+#define UDMA_O_ENASET           0x00000028  // DMA Channel Enable Set
+#define UDMA_O_ENACLR           0x0000002C  // DMA Channel Enable Clear
+#define UDMA_O_ALTSET           0x00000030  // DMA Channel Primary Alternate Set
+#define UDMA_O_ALTCLR           0x00000034  // DMA Channel Primary Alternate Clear
+#define UDMA_O_PRIOSET          0x00000038  // DMA Channel Priority Set
+#define UDMA_O_PRIOCLR          0x0000003C  // DMA Channel Priority Clear
+#define UDMA_O_ERRCLR           0x0000004C  // DMA Bus Error Clear
+#define UDMA_O_CHASGN           0x00000500  // DMA Channel Assignment
+#define UDMA_O_CHIS             0x00000504  // DMA Channel Interrupt Status
+#define UDMA_O_CHMAP0           0x00000510  // DMA Channel Map Select 0
+
+#define UDMA_CFG_MASTEN         0x00000001  // Controller Master Enable
+
+// Channel control word fields
+#define UDMA_CTL_DSTINC_8       0x00000000
+#define UDMA_CTL_DSTINC_16      0x40000000
+#define UDMA_CTL_DSTINC_32      0x80000000
+#define UDMA_CTL_DSTINC_NONE    0xC0000000
+#define UDMA_CTL_DSTSIZE_8      0x00000000
+#define UDMA_CTL_DSTSIZE_16     0x10000000
+#define UDMA_CTL_DSTSIZE_32     0x20000000
+#define UDMA_CTL_SRCINC_8       0x00000000
+#define UDMA_CTL_SRCINC_16      0x04000000
+#define UDMA_CTL_SRCINC_32      0x08000000
+#define UDMA_CTL_SRCINC_NONE    0x0C000000
+#define UDMA_CTL_SRCSIZE_8      0x00000000
+#define UDMA_CTL_SRCSIZE_16     0x01000000
+#define UDMA_CTL_SRCSIZE_32     0x02000000
+#define UDMA_CTL_ARBSIZE_1      0x00000000
+#define UDMA_CTL_ARBSIZE_4      0x00008000
+#define UDMA_CTL_ARBSIZE_8      0x0000C000
+#define UDMA_CTL_XFERSIZE_M     0x00003FF0  // Transfer size minus one
+#define UDMA_CTL_XFERSIZE_S     4
+#define UDMA_CTL_MODE_M         0x00000007
+
+#define UDMA_MODE_STOP          0x00000000
+#define UDMA_MODE_BASIC         0x00000001
+#define UDMA_MODE_AUTO          0x00000002
+#define UDMA_MODE_PINGPONG      0x00000003
+#define UDMA_MODE_MEM_SG        0x00000004
+#define UDMA_MODE_MEM_SG_ALT    0x00000005
+#define UDMA_MODE_PER_SG        0x00000006
+#define UDMA_MODE_PER_SG_ALT    0x00000007
+
+#define UDMA_MAX_XFER           1024        // items per control structure
+#define UDMA_NUM_CHANNELS       32
+
+// One channel control structure. The same layout is used for the task
+// list entries of a scatter-gather transfer.
+struct uDMAControl {
+  volatile uint32_t srcEnd;             // address of the last source item
+  volatile uint32_t dstEnd;             // address of the last destination item
+  volatile uint32_t control;            // UDMA_CTL_* | size | UDMA_MODE_*
+  volatile uint32_t spare;
+};
+
+//------------uDMA_Init------------
+// Clock the controller, point it at the control table and enable it.
+// Safe to call more than once.
+// Input: none
+// Output: none
+void uDMA_Init(void);
+
+//------------uDMA_Primary/uDMA_Alternate------------
+// Input: channel number 0-31
+// Output: the channel's primary or alternate control structure
+uDMAControl *uDMA_Primary(uint32_t channel);
+uDMAControl *uDMA_Alternate(uint32_t channel);
+
+//------------uDMA_ChannelAssign------------
+// Select which peripheral drives a channel (CHMAPn encoding)
+// Input: channel number 0-31, encoding 0-15 from the datasheet table
+// Output: none
+void uDMA_ChannelAssign(uint32_t channel, uint32_t encoding);
+
+//------------uDMA_ChannelReset------------
+// Disable a channel and return its attributes to the defaults: primary
+// structure, normal priority, requests unmasked, single requests allowed
+// Input: channel number 0-31
+// Output: none
+void uDMA_ChannelReset(uint32_t channel);
+
+void uDMA_ChannelEnable(uint32_t channel);
+void uDMA_ChannelDisable(uint32_t channel);
+bool uDMA_ChannelIsEnabled(uint32_t channel);
+void uDMA_UseBurst(uint32_t channel, bool burstOnly);
+void uDMA_RequestMask(uint32_t channel, bool masked);
+
+//------------uDMA_SelectAlt------------
+// Choose which structure the channel starts from when next enabled
+// Input: channel number 0-31, alt true for the alternate structure
+// Output: none
+void uDMA_SelectAlt(uint32_t channel, bool alt);
+
+//------------uDMA_AltActive------------
+// Input: channel number 0-31
+// Output: true if the alternate structure is the one in use
+bool uDMA_AltActive(uint32_t channel);
+
+// Transfer mode currently held in a control structure
+static inline uint32_t uDMA_Mode(const uDMAControl *ctl){
+  return ctl->control & UDMA_CTL_MODE_M;
+}
+
+// Items still to transfer in a running control structure
+static inline uint32_t uDMA_Remaining(const uDMAControl *ctl){
+  uint32_t control = ctl->control;
+  if((control & UDMA_CTL_MODE_M) == UDMA_MODE_STOP){
+    return 0;
+  }
+  return ((control & UDMA_CTL_XFERSIZE_M) >> UDMA_CTL_XFERSIZE_S) + 1;
+}
+
+// Build a control word for an n item transfer (1 <= n <= UDMA_MAX_XFER)
+static inline uint32_t uDMA_Control(uint32_t flags, uint32_t n, uint32_t mode){
+  return flags | ((n - 1) << UDMA_CTL_XFERSIZE_S) | mode;
+}
+
+// Control structures hold 32-bit bus addresses
+static inline uint32_t uDMA_Addr(const volatile void *p){
+#ifdef HOST_SIM
+  return SimBusAddr(p);                 // host pointers are 64-bit
+#else
+  return (uint32_t)(uintptr_t)p;
+#endif
+}
+
+#endif /* UDMA_H_ */